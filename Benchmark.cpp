@@ -0,0 +1,827 @@
+// 无界面基准测试：不创建窗口，不依赖 EasyX、Windows.h 与 DrawingTool，只跑 int 与 Counter 版本的排序。
+// 编译（Linux）：g++ -std=c++20 -O2 -finput-charset=GBK -pthread Benchmark.cpp -o VisualSortBench
+#define VISUALSORT_HEADLESS
+#include "Sort.h"
+#include "SortTimer.h"
+#include "Complexity.h"
+#include "Counter.h"
+#include "Tracer.h"
+#include "TraceRenderer.h"
+#include "SortRace.h"
+#include "FrameExporter.h"
+#include "FrameScheduler.h"
+#include "WideError.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 宽字符串转 UTF-8（排序名称与错误信息都是宽字符串）
+	inline std::string ToUtf8(std::wstring_view text_) {
+		std::string result;
+		for (size_t i = 0; i < text_.size(); ++i) {
+			unsigned long code = static_cast<unsigned long>(text_[i]);
+			if constexpr (sizeof(wchar_t) == 2) {
+				if (code >= 0xD800 && code < 0xDC00 && i + 1 < text_.size()) {
+					code = 0x10000 + ((code - 0xD800) << 10) + (static_cast<unsigned long>(text_[++i]) - 0xDC00);
+				}
+			}
+			if (code < 0x80) {
+				result += static_cast<char>(code);
+			}
+			else if (code < 0x800) {
+				result += static_cast<char>(0xC0 | (code >> 6));
+				result += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else if (code < 0x10000) {
+				result += static_cast<char>(0xE0 | (code >> 12));
+				result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				result += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else {
+				result += static_cast<char>(0xF0 | (code >> 18));
+				result += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+				result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				result += static_cast<char>(0x80 | (code & 0x3F));
+			}
+		}
+		return result;
+	}
+
+	// 基准测试参数
+	struct BenchmarkOption {
+		std::string sortName = "all";       // 排序序号或名称，all 表示全部
+		size_t dataSize = 1024;             // 数据量
+		std::string distribution = "shuffled"; // 数据分布
+		unsigned int seed = 1;              // 打乱用的随机种子
+		size_t warmupNum = 1;               // 预热次数
+		size_t repeatNum = 100;             // 每个排序计时次数（满 100 次才有 P99，慢的排序由 timeBudget 提前结束）
+		long long timeBudget = 2000;        // 每个排序计时总时长上限（毫秒）
+		bool runInt = true;                 // 是否测 int 版本
+		bool runCounter = true;             // 是否测 Counter 版本
+		bool isSweep = false;               // 是否按数据量扫描并拟合复杂度
+		size_t minSize = 16;                // 扫描的起始数据量
+		size_t maxSize = 1 << 22;           // 扫描的最大数据量
+		double sizeFactor = 2.0;            // 扫描时数据量的倍增系数
+		long long usableLimit = 100;        // int 中位耗时超过它（毫秒）就认为不可用，停止扫描
+		std::string traceFile;              // 操作记录文件，为空表示不记录
+		size_t keyframeMemoryLimit = TraceTimeline::DefaultMemoryLimit; // 回放时间轴关键帧的内存上限（字节）
+		int renderWidth = 0;                // 无界面渲染的画布宽度，为 0 表示不渲染
+		int renderHeight = 0;               // 无界面渲染的画布高度
+		size_t frameOperationNum = 1000;    // 无界面渲染时每帧执行的记录条数
+		std::string exportFile;             // 导出动画的文件（.ppm 图片序列或 .y4m 视频），为空表示不导出
+		unsigned int exportFps = FrameScheduler::DefaultFps; // 导出动画的帧率
+		double exportSpeed = 0;             // 导出动画的演示速度（每毫秒的记录条数），为 0 表示整段动画压缩到 DefaultExportDuration
+		long long timeLimit = 0;            // 每个排序（扫描时每个数据量）的总时限（毫秒），超过后中止，为 0 表示不限
+		bool runSteps = false;              // 是否测逐步执行的协程版本（只有部分排序有）
+		std::string raceSorts;              // 赛跑的排序（逗号分隔的序号或名称，default 表示默认的六个），为空表示不赛跑
+	};
+
+	// 排序的时限：到时后由看门狗线程请求停止，排序在下一个检查点返回，不在工作线程中抛出异常
+	class SortDeadline {
+
+	private:
+
+		std::stop_source m_stopSource;
+		std::jthread m_watchdog; // 析构时先请求看门狗停止并等待它退出
+
+	public:
+
+		explicit SortDeadline(long long time_limit_) {
+			if (time_limit_ <= 0) {
+				return;
+			}
+			this->m_watchdog = std::jthread([this, time_limit_](std::stop_token watchdog_token_) {
+				std::mutex mutex;
+				std::condition_variable_any condition;
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait_for(lock, watchdog_token_, std::chrono::milliseconds(time_limit_), []() {
+					return false;
+				});
+				if (!watchdog_token_.stop_requested()) {
+					this->m_stopSource.request_stop();
+				}
+			});
+		}
+		SortDeadline(const SortDeadline&) = delete;
+		SortDeadline& operator=(const SortDeadline&) = delete;
+
+		std::stop_token GetStopToken() const noexcept {
+			return this->m_stopSource.get_token();
+		}
+
+		bool GetIsExpired() const noexcept {
+			return this->m_stopSource.stop_requested();
+		}
+
+	};
+
+	constexpr double DefaultExportDuration = 10000; // 默认导出动画的时长（毫秒）
+
+	// 生成 1..n 的数据并按分布排列（shuffled 与 VisualSort::Shuffle 的打乱方式相同）
+	inline bool GenerateData(const BenchmarkOption& option_, std::vector<int>& data_) {
+		data_.resize(option_.dataSize);
+		for (size_t dataIndex = 0; dataIndex < data_.size(); ++dataIndex) {
+			data_[dataIndex] = static_cast<int>(dataIndex + 1);
+		}
+		if (option_.distribution == "shuffled") {
+			std::mt19937 rnd(option_.seed);
+			for (size_t i = 0; i < data_.size(); ++i) {
+				size_t randNum = rnd() % (i + 1);
+				std::swap(data_[i], data_[randNum]);
+			}
+		}
+		else if (option_.distribution == "reversed") {
+			std::reverse(data_.begin(), data_.end());
+		}
+		else if (option_.distribution == "few-unique") {
+			std::mt19937 rnd(option_.seed);
+			for (size_t i = 0; i < data_.size(); ++i) {
+				data_[i] = static_cast<int>(rnd() % 8) + 1;
+			}
+		}
+		else if (option_.distribution == "organ-pipe") {
+			for (size_t i = 0; i < data_.size(); ++i) {
+				data_[i] = static_cast<int>(i < data_.size() / 2 ? i + 1 : data_.size() - i);
+			}
+		}
+		else if (option_.distribution != "sorted") {
+			return false;
+		}
+		return true;
+	}
+
+	// 运行一个排序；返回 false 表示数据量不满足约束或排序出错
+	inline bool RunBenchmark(Sort& sort_, const BenchmarkOption& option_, const std::vector<int>& source_data_) {
+		std::cout << "[" << ToUtf8(sort_.GetSortName()) << "] 数据量：" << option_.dataSize
+			<< " 分布：" << option_.distribution << " 种子：" << option_.seed << "\n";
+		for (const NumRequire& numRequire : sort_.GetNumRequires()) {
+			if (!numRequire.Check(option_.dataSize)) {
+				std::cout << "  跳过：" << ToUtf8(numRequire.GetRequireInform()) << "\n";
+				return false;
+			}
+		}
+		if (option_.dataSize > static_cast<size_t>(sort_.GetMaxSize())) {
+			std::cout << "  注意：超过界面允许的最大数据量 " << sort_.GetMaxSize() << "\n";
+		}
+		std::vector<int> sortedData = source_data_;
+		std::sort(sortedData.begin(), sortedData.end());
+		SortDeadline deadline(option_.timeLimit);
+		auto printExpired = [&option_]() {
+			std::cout << "  中止：超过时限 " << option_.timeLimit << "ms\n";
+			return false;
+		};
+		std::chrono::nanoseconds intMedian{};
+		try {
+			if (option_.runInt) {
+				std::vector<int> intSortData;
+				SortTimer sortTimer(option_.warmupNum, option_.repeatNum, std::chrono::milliseconds(option_.timeBudget));
+				SortTiming timing = sortTimer.Measure(sort_, source_data_, intSortData, deadline.GetStopToken());
+				if (deadline.GetIsExpired()) {
+					return printExpired();
+				}
+				if (intSortData != sortedData) {
+					std::cout << "  int 排序结果错误\n";
+					return false;
+				}
+				intMedian = timing.GetMedian();
+				auto toMicroseconds = [](std::chrono::nanoseconds duration_) {
+					return static_cast<double>(duration_.count()) / 1000;
+				};
+				std::cout << std::fixed << std::setprecision(1)
+					<< "  int 计时" << timing.GetRunNum() << "次 最短：" << toMicroseconds(timing.GetMin())
+					<< "us 中位数：" << toMicroseconds(timing.GetMedian()) << "us";
+				// 计时次数不够时 P95、P99 就是最大值，输出 n/a 与实际次数
+				auto printPercentile = [&timing, &toMicroseconds](const char* name_, double percent_, std::chrono::nanoseconds duration_) {
+					std::cout << " " << name_ << "：";
+					if (timing.GetHasPercentile(percent_)) {
+						std::cout << toMicroseconds(duration_) << "us";
+					}
+					else {
+						std::cout << "n/a（" << timing.GetRunNum() << "次）";
+					}
+				};
+				printPercentile("P95", 95, timing.GetP95());
+				printPercentile("P99", 99, timing.GetP99());
+				std::cout << " 最长：" << toMicroseconds(timing.GetMax()) << "us\n"
+					<< "  int 吞吐量：" << timing.GetElementsPerSecond() / 1e6 << "M元素/s "
+					<< std::setprecision(2) << timing.GetNsPerElement() << "ns/元素\n"
+					<< std::defaultfloat;
+			}
+			size_t counterStepNum = 0; // Counter 的实际步数与操作记录条数相近，用来预先分配记录的空间
+			if (option_.runCounter) {
+				std::vector<Counter> counterSortData;
+				Counter::SetCounters(source_data_, counterSortData);
+				Counter::ResetStepNums();
+				sort_.RunSort(counterSortData, deadline.GetStopToken());
+				if (deadline.GetIsExpired()) {
+					return printExpired();
+				}
+				CounterStepNums stepNums = Counter::GetStepNums();
+				counterStepNum = stepNums.actual;
+				double compareLowerBound = Log2Factorial(option_.dataSize);
+				std::cout << "  Counter 实际步数：" << stepNums.actual
+					<< " 比较：" << stepNums.compare << " 读取：" << stepNums.read
+					<< " 写入：" << stepNums.write << " 交换：" << stepNums.swap << "\n"
+					<< "  比较下界 log2(n!)：" << std::fixed << std::setprecision(0) << compareLowerBound
+					<< " 比较/下界：" << std::setprecision(2) << stepNums.compare / compareLowerBound << "\n"
+					<< std::defaultfloat;
+			}
+			if (option_.runSteps && sort_.GetHasStepSort()) {
+				// 协程版本：先用执行到底的实例化计时（不构造记录、不挂起），再按帧逐步驱动（每帧 frameOperationNum 步），不需要先记录
+				std::vector<int> stepSortData = source_data_;
+				auto startTime = std::chrono::steady_clock::now();
+				size_t stepNum = sort_.RunStepSortToEnd(stepSortData, deadline.GetStopToken());
+				auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+				if (deadline.GetIsExpired()) {
+					return printExpired();
+				}
+				if (stepSortData != sortedData) {
+					std::cout << "  协程版本排序结果错误\n";
+					return false;
+				}
+				std::cout << "  协程版本执行到底：" << stepNum << "步 耗时" << std::fixed << std::setprecision(1)
+					<< static_cast<double>(duration.count()) / 1000 << "us " << std::setprecision(2)
+					<< (stepNum == 0 ? 0.0 : static_cast<double>(duration.count()) / stepNum) << "ns/步";
+				if (intMedian.count() > 0) {
+					std::cout << " 是 int 版本中位数的" << static_cast<double>(duration.count()) / intMedian.count() << "倍";
+				}
+				std::cout << "\n" << std::defaultfloat;
+				if (option_.renderWidth > 0) {
+					stepSortData = source_data_;
+					SortSteps steps = sort_.CreateSortSteps(stepSortData);
+					TraceRenderer renderer(option_.renderWidth, option_.renderHeight, source_data_);
+					size_t frameNum = 0;
+					std::chrono::nanoseconds renderDuration{};
+					auto driveStartTime = std::chrono::steady_clock::now();
+					while (!steps.GetIsDone()) {
+						for (size_t stepIndex = 0; stepIndex < option_.frameOperationNum && steps.Next(); ++stepIndex) {
+							renderer.ApplyRecord(steps.GetRecord());
+						}
+						if (steps.GetIsDone()) {
+							renderer.ClearHighlights();
+						}
+						auto renderStartTime = std::chrono::steady_clock::now();
+						renderer.RenderFrame();
+						renderDuration += std::chrono::steady_clock::now() - renderStartTime;
+						++frameNum;
+					}
+					auto driveDuration = std::chrono::steady_clock::now() - driveStartTime;
+					if (renderer.GetData() != sortedData) {
+						std::cout << "  协程版本渲染结果错误\n";
+						return false;
+					}
+					if (steps.GetStepNum() != stepNum) {
+						std::cout << "  协程逐步执行的步数与执行到底不同\n";
+						return false;
+					}
+					std::cout << "  协程逐帧：" << option_.renderWidth << "x" << option_.renderHeight << " 每帧" << option_.frameOperationNum
+						<< "步 共" << frameNum << "帧" << std::fixed << std::setprecision(1)
+						<< " 每帧渲染：" << static_cast<double>(renderDuration.count()) / frameNum / 1000
+						<< "us 每帧执行：" << static_cast<double>((driveDuration - renderDuration).count()) / frameNum / 1000 << "us\n" << std::defaultfloat;
+				}
+			}
+			if (!option_.traceFile.empty()) {
+				TraceRecorder recorder;
+				recorder.Reserve(counterStepNum);
+				std::vector<Tracer> tracerSortData;
+				Tracer::StartTracing(source_data_, tracerSortData, recorder, sort_.GetIsCallingThreadOnly());
+				auto startTime = std::chrono::steady_clock::now();
+				try {
+					sort_.RunSort(tracerSortData, deadline.GetStopToken());
+				}
+				catch (...) {
+					Tracer::StopTracing();
+					throw;
+				}
+				auto duration = std::chrono::steady_clock::now() - startTime;
+				Tracer::StopTracing();
+				if (deadline.GetIsExpired()) {
+					return printExpired();
+				}
+				if (!std::equal(tracerSortData.begin(), tracerSortData.end(), sortedData.begin(),
+					[](const Tracer& tracer_, int value_) { return tracer_.GetValue() == value_; })) {
+					std::cout << "  Tracer 排序结果错误\n";
+					return false;
+				}
+				size_t recordNum = recorder.GetRecordNum();
+				TraceReplayer replayer(recorder);
+				std::vector<int> middleData = replayer.GetData();
+				while (!replayer.IsEnd()) {
+					replayer.Step();
+					if (replayer.GetPosition() == recordNum / 2) {
+						middleData = replayer.GetData();
+					}
+				}
+				if (replayer.GetData() != sortedData) {
+					std::cout << "  操作记录回放结果错误\n";
+					return false;
+				}
+				// 关键帧跳转：先验证跳到中间的结果，再随机跳转计时
+				TraceTimeline timeline(recorder, option_.keyframeMemoryLimit);
+				timeline.Seek(replayer, recordNum / 2);
+				if (replayer.GetData() != middleData) {
+					std::cout << "  操作记录跳转结果错误\n";
+					return false;
+				}
+				constexpr size_t seekNum = 64;
+				std::mt19937 rnd(option_.seed);
+				auto seekStartTime = std::chrono::steady_clock::now();
+				for (size_t i = 0; i < seekNum; ++i) {
+					timeline.Seek(replayer, recordNum == 0 ? 0 : rnd() % recordNum);
+				}
+				auto seekDuration = std::chrono::steady_clock::now() - seekStartTime;
+				recorder.SaveToFile(option_.traceFile);
+				std::cout << "  操作记录：" << recordNum << "条 " << recordNum * sizeof(TraceRecord) << "字节 -> " << option_.traceFile << "\n"
+					<< std::fixed << std::setprecision(2) << "  记录耗时："
+					<< (recordNum == 0 ? 0.0 : static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / recordNum)
+					<< "ns/条\n" << std::defaultfloat
+					<< "  关键帧：每" << timeline.GetInterval() << "条一帧 共" << timeline.GetKeyframeNum() << "帧 "
+					<< timeline.GetMemoryUsage() << "字节 随机跳转平均：" << std::fixed << std::setprecision(1)
+					<< static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(seekDuration).count()) / seekNum / 1000
+					<< "us\n" << std::defaultfloat;
+				if (option_.renderWidth > 0) {
+					// 无界面渲染：回放计时与渲染计时分开，渲染耗时只含重绘改动过的条形
+					TraceRenderer renderer(option_.renderWidth, option_.renderHeight, recorder.GetInitialData());
+					size_t frameNum = 0;
+					size_t drawnStripNum = 0;
+					std::chrono::nanoseconds applyDuration{};
+					std::chrono::nanoseconds renderDuration{};
+					for (size_t position = 0; position < recordNum || frameNum == 0;) {
+						auto applyStartTime = std::chrono::steady_clock::now();
+						size_t frameEnd = (std::min)(recordNum, position + option_.frameOperationNum);
+						for (; position < frameEnd; ++position) {
+							renderer.ApplyRecord(recorder.GetRecord(position));
+						}
+						if (position == recordNum) {
+							renderer.ClearHighlights();
+						}
+						auto renderStartTime = std::chrono::steady_clock::now();
+						drawnStripNum += renderer.RenderFrame();
+						auto renderEndTime = std::chrono::steady_clock::now();
+						applyDuration += renderStartTime - applyStartTime;
+						renderDuration += renderEndTime - renderStartTime;
+						++frameNum;
+					}
+					if (renderer.GetData() != sortedData) {
+						std::cout << "  渲染回放结果错误\n";
+						return false;
+					}
+					std::cout << "  渲染：" << option_.renderWidth << "x" << option_.renderHeight << " 每帧" << option_.frameOperationNum
+						<< "条 共" << frameNum << "帧 重绘条形" << drawnStripNum << "次" << std::fixed << std::setprecision(1)
+						<< " 每帧渲染：" << static_cast<double>(renderDuration.count()) / frameNum / 1000
+						<< "us 每帧回放：" << static_cast<double>(applyDuration.count()) / frameNum / 1000 << "us\n" << std::defaultfloat;
+				}
+				if (!option_.exportFile.empty()) {
+					// 按固定帧率与演示速度切帧，但不等待，渲染与编码线程并行，导出比实时快得多
+					double speed = option_.exportSpeed > 0 ? option_.exportSpeed
+						: static_cast<double>((std::max)(recordNum, static_cast<size_t>(1))) / DefaultExportDuration;
+					FrameScheduler scheduler(option_.exportFps);
+					TraceRenderer renderer(option_.renderWidth, option_.renderHeight, recorder.GetInitialData());
+					auto exportStartTime = std::chrono::steady_clock::now();
+					FrameExporter exporter(option_.exportFile, option_.renderWidth, option_.renderHeight, option_.exportFps);
+					exporter.PushFrame(renderer.GetFrameBuffer());
+					for (size_t position = 0; position < recordNum;) {
+						size_t frameEnd = (std::min)(recordNum, position + scheduler.GetFrameOperationNum(speed));
+						for (; position < frameEnd; ++position) {
+							renderer.ApplyRecord(recorder.GetRecord(position));
+						}
+						if (position == recordNum) {
+							renderer.ClearHighlights();
+						}
+						renderer.RenderFrame();
+						exporter.PushFrame(renderer.GetFrameBuffer());
+					}
+					exporter.Finish();
+					auto exportDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - exportStartTime);
+					double videoDuration = static_cast<double>(exporter.GetFrameNum()) / option_.exportFps;
+					std::cout << "  导出：" << exporter.GetFrameNum() << "帧 " << option_.exportFps << "fps 时长" << std::fixed << std::setprecision(1)
+						<< videoDuration << "s 用时" << exportDuration.count() / 1000.0 << "s（"
+						<< videoDuration * 1000 / (std::max)(exportDuration.count(), static_cast<decltype(exportDuration.count())>(1)) << "倍实时）-> " << option_.exportFile << "\n" << std::defaultfloat;
+				}
+			}
+		}
+		catch (const WideError& errorMessage) {
+			std::cout << "  出错：" << ToUtf8(errorMessage.What()) << "\n";
+			return false;
+		}
+		return true;
+	}
+
+	// 按几何级数增大数据量，记录 int 耗时与 Counter 步数（按 --mode 选择），直到超过可用时长（只测 Counter 时按 Counter 版本的耗时判断），然后拟合复杂度
+	inline bool RunSweep(Sort& sort_, const BenchmarkOption& option_) {
+		std::cout << "[" << ToUtf8(sort_.GetSortName()) << "] 分布：" << option_.distribution
+			<< " 界面最大数据量：" << sort_.GetMaxSize() << "\n"
+			<< "  数据量";
+		if (option_.runInt) {
+			std::cout << "\t中位耗时(us)\tns/元素";
+		}
+		if (option_.runCounter) {
+			std::cout << "\tCounter 步数\t步数/元素";
+		}
+		std::cout << "\n";
+		ComplexityFit timeFit;
+		ComplexityFit stepFit;
+		size_t usableSize = 0;
+		bool isOK = true;
+		std::vector<int> sourceData;
+		std::vector<int> intSortData;
+		SortTimer sortTimer(option_.warmupNum, option_.repeatNum, std::chrono::milliseconds(option_.timeBudget));
+		for (size_t dataSize = (std::max)(option_.minSize, static_cast<size_t>(2)); dataSize <= option_.maxSize;
+			dataSize = (std::max)(dataSize + 1, static_cast<size_t>(dataSize * option_.sizeFactor))) {
+			bool isSizeAllowed = true;
+			for (const NumRequire& numRequire : sort_.GetNumRequires()) {
+				isSizeAllowed = isSizeAllowed && numRequire.Check(dataSize);
+			}
+			if (!isSizeAllowed) {
+				continue;
+			}
+			BenchmarkOption sizeOption = option_;
+			sizeOption.dataSize = dataSize;
+			GenerateData(sizeOption, sourceData);
+			std::vector<int> sortedData = sourceData;
+			std::sort(sortedData.begin(), sortedData.end());
+			try {
+				SortDeadline deadline(option_.timeLimit);
+				double medianUs = 0;
+				if (option_.runInt) {
+					SortTiming timing = sortTimer.Measure(sort_, sourceData, intSortData, deadline.GetStopToken());
+					if (deadline.GetIsExpired()) {
+						std::cout << "  " << dataSize << "\t中止：超过时限 " << option_.timeLimit << "ms\n";
+						break;
+					}
+					if (intSortData != sortedData) {
+						std::cout << "  " << dataSize << "\t排序结果错误\n";
+						isOK = false;
+						break;
+					}
+					medianUs = static_cast<double>(timing.GetMedian().count()) / 1000;
+					std::cout << "  " << dataSize << std::fixed << std::setprecision(1) << "\t" << medianUs
+						<< "\t" << std::setprecision(2) << timing.GetNsPerElement() << std::defaultfloat;
+					// 太短的耗时主要是计时噪声，不参与拟合
+					if (medianUs >= 10) {
+						timeFit.AddSample(dataSize, medianUs);
+					}
+				}
+				else {
+					std::cout << "  " << dataSize;
+				}
+				if (option_.runCounter) {
+					std::vector<Counter> counterSortData;
+					Counter::SetCounters(sourceData, counterSortData);
+					Counter::ResetStepNums();
+					auto counterBeginTime = std::chrono::steady_clock::now();
+					sort_.RunSort(counterSortData, deadline.GetStopToken());
+					if (deadline.GetIsExpired()) {
+						std::cout << "\t中止：超过时限 " << option_.timeLimit << "ms\n";
+						break;
+					}
+					if (!option_.runInt) {
+						medianUs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - counterBeginTime).count()) / 1000;
+					}
+					if (!std::equal(counterSortData.begin(), counterSortData.end(), sortedData.begin(), [](const Counter& counter_, int value_) {
+						return counter_.GetValue() == value_;
+					})) {
+						std::cout << "\t排序结果错误\n";
+						isOK = false;
+						break;
+					}
+					size_t stepNum = ActualStepNum.load();
+					stepFit.AddSample(dataSize, static_cast<double>(stepNum));
+					std::cout << "\t" << stepNum << "\t" << std::fixed << std::setprecision(2)
+						<< static_cast<double>(stepNum) / dataSize << std::defaultfloat;
+				}
+				std::cout << "\n";
+				if (medianUs > option_.usableLimit * 1000.0) {
+					break;
+				}
+				usableSize = dataSize;
+			}
+			catch (const WideError& errorMessage) {
+				std::cout << "  " << dataSize << "\t出错：" << ToUtf8(errorMessage.What()) << "\n";
+				break;
+			}
+		}
+		auto printFit = [](const char* title_, const ComplexityFit& fit_) {
+			if (fit_.GetSampleNum() < 2) {
+				std::cout << "  " << title_ << "：样本不足，无法拟合\n";
+				return;
+			}
+			auto [exponent, constant] = fit_.FitPowerLaw();
+			ComplexityModelFit best = fit_.FitBestModel();
+			std::cout << "  " << title_ << "：≈ " << std::setprecision(3) << constant << " * n^" << std::fixed << std::setprecision(2)
+				<< exponent << std::defaultfloat << "，最接近 " << best.model->GetName() << "（常数 " << std::setprecision(3)
+				<< best.constant << "，误差 " << std::fixed << std::setprecision(3) << best.error << std::defaultfloat << "）\n";
+			for (const ComplexityModel& model : GetComplexityModels()) {
+				ComplexityModelFit fit = fit_.FitModel(model);
+				std::cout << "    " << model.GetName() << "：常数 " << std::setprecision(3) << fit.constant
+					<< " 误差 " << std::fixed << std::setprecision(3) << fit.error << std::defaultfloat << "\n";
+			}
+		};
+		if (option_.runInt) {
+			printFit("耗时(us)", timeFit);
+		}
+		if (option_.runCounter) {
+			printFit("Counter 步数", stepFit);
+		}
+		if (option_.runInt) {
+			std::cout << "  " << option_.usableLimit << "ms 内可用的最大数据量：" << usableSize << "\n";
+		}
+		return isOK;
+	}
+
+	// 赛跑：各排序用同一份数据各占一条跑道，先记录再按帧同时回放，每帧各跑道执行 frameOperationNum 条记录
+	inline bool RunRace(std::vector<Sort>& sorts_, const BenchmarkOption& option_, const std::vector<int>& source_data_) {
+		try {
+			std::vector<size_t> sortIndices;
+			if (option_.raceSorts == "default") {
+				sortIndices = SortRace::FindSortIndices(sorts_, SortRace::GetDefaultSortNames());
+			}
+			else {
+				std::string_view raceSorts = option_.raceSorts;
+				while (!raceSorts.empty()) {
+					size_t separator = (std::min)(raceSorts.find(','), raceSorts.size());
+					std::string_view sortName = raceSorts.substr(0, separator);
+					raceSorts.remove_prefix((std::min)(separator + 1, raceSorts.size()));
+					auto it = std::find_if(sorts_.begin(), sorts_.end(), [&sorts_, sortName](const Sort& sort_) {
+						return sortName == std::to_string(&sort_ - sorts_.data()) || sortName == ToUtf8(sort_.GetSortName());
+					});
+					if (it == sorts_.end()) {
+						std::cout << "找不到排序：" << sortName << "（用 --list 查看全部排序）\n";
+						return false;
+					}
+					sortIndices.push_back(static_cast<size_t>(it - sorts_.begin()));
+				}
+			}
+			int width = option_.renderWidth > 0 ? option_.renderWidth : 1280;
+			int height = option_.renderWidth > 0 ? option_.renderHeight : 720;
+			SortRace race(sorts_, sortIndices, source_data_, width, height);
+			std::cout << "[赛跑] " << race.GetLaneNum() << "条跑道 数据量：" << source_data_.size() << " 分布：" << option_.distribution
+				<< " 画布：" << width << "x" << height << " 每帧" << option_.frameOperationNum << "条\n";
+			SortDeadline deadline(option_.timeLimit);
+			auto recordStartTime = std::chrono::steady_clock::now();
+			if (!race.Record(sorts_, deadline.GetStopToken())) {
+				std::cout << "  中止：超过时限 " << option_.timeLimit << "ms\n";
+				return false;
+			}
+			auto recordDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - recordStartTime);
+			std::cout << "  记录用时：" << recordDuration.count() << "ms\n";
+
+			FrameBuffer canvas(width, height);
+			std::optional<FrameExporter> exporter;
+			if (!option_.exportFile.empty()) {
+				exporter.emplace(option_.exportFile, width, height, option_.exportFps);
+			}
+			std::chrono::nanoseconds stepDuration{};
+			std::chrono::nanoseconds compositeDuration{};
+			while (!race.GetIsFinished()) {
+				auto stepStartTime = std::chrono::steady_clock::now();
+				race.StepFrame(option_.frameOperationNum);
+				auto compositeStartTime = std::chrono::steady_clock::now();
+				race.Composite(canvas);
+				auto compositeEndTime = std::chrono::steady_clock::now();
+				stepDuration += compositeStartTime - stepStartTime;
+				compositeDuration += compositeEndTime - compositeStartTime;
+				if (exporter.has_value()) {
+					exporter->PushFrame(canvas);
+				}
+			}
+			if (exporter.has_value()) {
+				exporter->Finish();
+			}
+
+			std::vector<int> sortedData = source_data_;
+			std::sort(sortedData.begin(), sortedData.end());
+			std::vector<size_t> laneOrder(race.GetLaneNum());
+			for (size_t laneIndex = 0; laneIndex < laneOrder.size(); ++laneIndex) {
+				laneOrder[laneIndex] = laneIndex;
+			}
+			std::stable_sort(laneOrder.begin(), laneOrder.end(), [&race](size_t a_, size_t b_) {
+				return race.GetLane(a_).place < race.GetLane(b_).place;
+			});
+			bool isOK = true;
+			std::cout << "  名次\t完成帧\t记录数\t比较\t写入与交换\t排序\n";
+			for (size_t laneIndex : laneOrder) {
+				const SortRace::Lane& lane = race.GetLane(laneIndex);
+				std::cout << "  " << lane.place << "\t" << lane.finishFrame << "\t" << lane.recorder.GetRecordNum() << "\t" << lane.compareNum
+					<< "\t" << lane.changeNum << "\t" << ToUtf8(lane.sortName);
+				if (lane.renderer->GetData() != sortedData) {
+					std::cout << "\t回放结果错误";
+					isOK = false;
+				}
+				std::cout << "\n";
+			}
+			size_t frameNum = (std::max)(race.GetFrameNum(), static_cast<size_t>(1));
+			std::cout << "  共" << race.GetFrameNum() << "帧 线程池工作线程：" << GetThreadPool().GetWorkerNum() << std::fixed << std::setprecision(1)
+				<< " 每帧回放与重绘：" << static_cast<double>(stepDuration.count()) / frameNum / 1000
+				<< "us 每帧合成：" << static_cast<double>(compositeDuration.count()) / frameNum / 1000 << "us\n" << std::defaultfloat;
+			if (exporter.has_value()) {
+				std::cout << "  导出：" << exporter->GetFrameNum() << "帧 " << option_.exportFps << "fps -> " << option_.exportFile << "\n";
+			}
+			return isOK;
+		}
+		catch (const WideError& errorMessage) {
+			std::cout << "  出错：" << ToUtf8(errorMessage.What()) << "\n";
+			return false;
+		}
+	}
+
+	inline void PrintUsage() {
+		std::cout <<
+			"用法：VisualSortBench [选项]\n"
+			"  --list                 列出全部排序的序号、名称与最大数据量\n"
+			"  --sort <序号|名称|all> 要测试的排序（默认 all，all 会跳过超过最大数据量的排序）\n"
+			"  --size <n>             数据量（默认 1024）\n"
+			"  --dist <分布>          shuffled | sorted | reversed | few-unique | organ-pipe（默认 shuffled）\n"
+			"  --seed <s>             随机种子（默认 1）\n"
+			"  --warmup <w>           int 版本预热次数（默认 1）\n"
+			"  --repeat <r>           int 版本计时次数（默认 100，总时长超过 --budget 时提前结束）\n"
+			"  --budget <ms>          int 版本计时总时长上限，超过后提前结束（默认 2000）\n"
+			"  --mode <int|counter|both> 测试的版本（默认 both）\n"
+			"  --steps                再测逐步执行的协程版本（只有部分排序有）：执行到底的耗时（不构造记录、不挂起），加上 --render 时按帧逐步驱动并渲染\n"
+			"  --time-limit <ms>      每个排序（--sweep 时每个数据量）的总时限，超过后在下一个检查点中止（默认不限）\n"
+			"  --threads <n>          多线程排序使用的线程池工作线程数（默认硬件线程数）\n"
+			"  --sweep                按几何级数增大数据量，拟合耗时与步数的复杂度（n、n log n、n^2、n^2.7）\n"
+			"  --min-size <n>         扫描的起始数据量（默认 16）\n"
+			"  --max-size <n>         扫描的最大数据量（默认 4194304）\n"
+			"  --factor <f>           扫描时数据量的倍增系数（默认 2）\n"
+			"  --limit <ms>           int 中位耗时超过它就停止扫描，并据此给出可用的最大数据量（默认 100）\n"
+			"  --trace <文件>         用 Tracer 版本再跑一遍，把每一步操作记录到文件（需要用 --sort 指定单个排序）\n"
+			"  --keyframe-memory <MiB> --trace 时回放时间轴关键帧的内存上限（默认 64）\n"
+			"  --render <宽>x<高>     --trace 或 --steps 时再把记录回放（或协程逐步执行）渲染到内存画布，分别统计每帧的渲染与回放耗时\n"
+			"  --frame-ops <n>        --render 时每帧执行的记录条数（默认 1000）\n"
+			"  --race <排序列表|default> 赛跑：逗号分隔的序号或名称（default 为归并、堆、快速、模式消除快速、std::sort、std::stable_sort），\n"
+			"                         各排序用同一份数据各占一条跑道同时回放，每帧各执行 --frame-ops 条记录（画布大小由 --render 指定，默认 1280x720）\n"
+			"  --export <文件>        --trace --render 或 --race 时再把动画导出为 .ppm 图片序列或 .y4m 视频\n"
+			"  --fps <n>              导出动画的帧率（默认 60）\n"
+			"  --export-speed <步/ms> 导出动画每毫秒执行的记录条数（默认把整段动画压缩到 10 秒）\n";
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	using namespace NVisualSort;
+	BenchmarkOption option;
+	std::vector<Sort> sorts = CreateDefaultSorts();
+	for (int argIndex = 1; argIndex < argc; ++argIndex) {
+		std::string_view arg = argv[argIndex];
+		bool hasValue = argIndex + 1 < argc;
+		if (arg == "--list") {
+			for (size_t sortIndex = 0; sortIndex < sorts.size(); ++sortIndex) {
+				std::cout << sortIndex << "\t" << ToUtf8(sorts[sortIndex].GetSortName())
+					<< "\t" << sorts[sortIndex].GetMaxSize() << "\n";
+			}
+			return 0;
+		}
+		else if (arg == "--sort" && hasValue) {
+			option.sortName = argv[++argIndex];
+		}
+		else if (arg == "--size" && hasValue) {
+			option.dataSize = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--dist" && hasValue) {
+			option.distribution = argv[++argIndex];
+		}
+		else if (arg == "--seed" && hasValue) {
+			option.seed = static_cast<unsigned int>(std::strtoul(argv[++argIndex], nullptr, 10));
+		}
+		else if (arg == "--warmup" && hasValue) {
+			option.warmupNum = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--repeat" && hasValue) {
+			option.repeatNum = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--budget" && hasValue) {
+			option.timeBudget = std::strtoll(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--steps") {
+			option.runSteps = true;
+		}
+		else if (arg == "--time-limit" && hasValue) {
+			option.timeLimit = std::strtoll(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--sweep") {
+			option.isSweep = true;
+		}
+		else if (arg == "--min-size" && hasValue) {
+			option.minSize = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--max-size" && hasValue) {
+			option.maxSize = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--factor" && hasValue) {
+			option.sizeFactor = std::strtod(argv[++argIndex], nullptr);
+		}
+		else if (arg == "--limit" && hasValue) {
+			option.usableLimit = std::strtoll(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--threads" && hasValue) {
+			GetThreadPool().SetWorkerNum(std::strtoull(argv[++argIndex], nullptr, 10));
+		}
+		else if (arg == "--keyframe-memory" && hasValue) {
+			option.keyframeMemoryLimit = std::strtoull(argv[++argIndex], nullptr, 10) << 20;
+		}
+		else if (arg == "--render" && hasValue) {
+			std::string_view size = argv[++argIndex];
+			size_t separator = size.find('x');
+			if (separator == std::string_view::npos) {
+				PrintUsage();
+				return 1;
+			}
+			option.renderWidth = std::atoi(std::string(size.substr(0, separator)).c_str());
+			option.renderHeight = std::atoi(std::string(size.substr(separator + 1)).c_str());
+		}
+		else if (arg == "--export" && hasValue) {
+			option.exportFile = argv[++argIndex];
+		}
+		else if (arg == "--fps" && hasValue) {
+			option.exportFps = static_cast<unsigned int>(std::strtoul(argv[++argIndex], nullptr, 10));
+		}
+		else if (arg == "--export-speed" && hasValue) {
+			option.exportSpeed = std::strtod(argv[++argIndex], nullptr);
+		}
+		else if (arg == "--frame-ops" && hasValue) {
+			option.frameOperationNum = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else if (arg == "--race" && hasValue) {
+			option.raceSorts = argv[++argIndex];
+		}
+		else if (arg == "--trace" && hasValue) {
+			option.traceFile = argv[++argIndex];
+		}
+		else if (arg == "--mode" && hasValue) {
+			std::string_view mode = argv[++argIndex];
+			option.runInt = mode == "int" || mode == "both";
+			option.runCounter = mode == "counter" || mode == "both";
+		}
+		else {
+			PrintUsage();
+			return arg == "--help" ? 0 : 1;
+		}
+	}
+	if (option.dataSize < 2 || (!option.runInt && !option.runCounter) || option.sizeFactor <= 1.0
+		|| (!option.traceFile.empty() && (option.sortName == "all" || option.isSweep))
+		|| (option.renderWidth != 0 && ((option.traceFile.empty() && !option.runSteps && option.raceSorts.empty()) || option.renderWidth < 0 || option.renderHeight <= 0))
+		|| option.frameOperationNum == 0
+		|| (!option.raceSorts.empty() && (!option.traceFile.empty() || option.isSweep || option.runSteps))
+		|| (!option.exportFile.empty() && (option.exportFps == 0 || (option.raceSorts.empty() && (option.renderWidth == 0 || option.traceFile.empty()))))) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<int> sourceData;
+	if (!GenerateData(option, sourceData)) {
+		std::cout << "未知的数据分布：" << option.distribution << "\n";
+		return 1;
+	}
+
+	if (!option.raceSorts.empty()) {
+		return RunRace(sorts, option, sourceData) ? 0 : 2;
+	}
+
+	bool isAllOK = true;
+	if (option.isSweep && option.sortName == "all") {
+		for (Sort& sort : sorts) {
+			isAllOK = RunSweep(sort, option) && isAllOK;
+		}
+		return isAllOK ? 0 : 2;
+	}
+	else if (option.sortName == "all") {
+		for (Sort& sort : sorts) {
+			if (option.dataSize > static_cast<size_t>(sort.GetMaxSize())) {
+				std::cout << "[" << ToUtf8(sort.GetSortName()) << "] 跳过：超过最大数据量 " << sort.GetMaxSize() << "\n";
+				continue;
+			}
+			isAllOK = RunBenchmark(sort, option, sourceData) && isAllOK;
+		}
+		return isAllOK ? 0 : 2;
+	}
+
+	std::optional<size_t> sortIndex;
+	for (size_t i = 0; i < sorts.size(); ++i) {
+		if (option.sortName == std::to_string(i) || option.sortName == ToUtf8(sorts[i].GetSortName())) {
+			sortIndex = i;
+			break;
+		}
+	}
+	if (!sortIndex.has_value()) {
+		std::cout << "找不到排序：" << option.sortName << "（用 --list 查看全部排序）\n";
+		return 1;
+	}
+	if (option.isSweep) {
+		return RunSweep(sorts[sortIndex.value()], option) ? 0 : 2;
+	}
+	return RunBenchmark(sorts[sortIndex.value()], option, sourceData) ? 0 : 2;
+}
\ No newline at end of file
@@ -21,20 +21,20 @@
 
 namespace NVisualSort {
 
-	constexpr COLORREF HoverOffset = RGB(0x66, 0x66, 0x66); // ͣʱıɫƫ
-	constexpr COLORREF PressOffset = RGB(0x33, 0x33, 0x33); // 갴ʱıɫƫ
+	constexpr COLORREF HoverOffset = RGB(0x66, 0x66, 0x66); // 鼠标悬停时的背景颜色偏移
+	constexpr COLORREF PressOffset = RGB(0x33, 0x33, 0x33); // 鼠标按下时的背景颜色偏移
 
 	class Button {
 
-		friend class ButtonSequence; //  ButtonSequence  Button ˽гԱ
+		friend class ButtonSequence; // 允许 ButtonSequence 访问 Button 的私有成员
 
 	private:
 
-		Sketch m_sketch; // ťӾ Sketch 
+		Sketch m_sketch; // 按钮的视觉表现由 Sketch 负责
 
 		static void DefaultHoverDrawFunction(Button& button_, ExMessage) {
 			if (!button_.m_sketch.GetHasBackground()) {
-				return; // ûбͲҪıɫ
+				return; // 如果没有背景，就不需要改变颜色
 			}
 			COLORREF originalColor = button_.m_sketch.GetBackgroundColor();
 			ScopeGuard restoreColorGuard([&button_, originalColor]() {
@@ -46,7 +46,7 @@ namespace NVisualSort {
 
 		static void DefaultPressDrawFunction(Button& button_, ExMessage) {
 			if (!button_.m_sketch.GetHasBackground()) {
-				return; // ûбͲҪıɫ
+				return; // 如果没有背景，就不需要改变颜色
 			}
 			COLORREF originalColor = button_.m_sketch.GetBackgroundColor();
 			ScopeGuard restoreColorGuard([&button_, originalColor]() {
@@ -60,10 +60,10 @@ namespace NVisualSort {
 			button_.m_sketch.DrawSketch();
 		}
 
-		// 洢¼ӦĻص Button Ϣ
-		// ĬΪͣͰ¼ṩĬϻƺͷ¼ĬΪգҪûã뿪¼ĬΪػ水ťԻָԭ״
-		// Ӧϵ0 - Hover1 - Press2 - Release3 - Leave4 - Drag
-		// Ҫ Button  this ָ룬ƶָգصԶͨ Button 
+		// 存储鼠标事件对应的回调函数，参数是 Button 自身和鼠标消息
+		// 默认为悬停和按下事件提供默认绘制函数，释放事件默认为空（需要用户设置），离开事件默认为重绘按钮以恢复原状
+		// 索引对应关系：0 - Hover，1 - Press，2 - Release，3 - Leave，4 - Drag
+		// 不要捕获自身 Button 的 this 指针，避免移动后的悬空指针风险！回调函数会自动通过参数传入 Button 引用
 		std::vector<std::function<void(Button&, ExMessage)>> m_callbackFuncs = {
 			Button::DefaultHoverDrawFunction,
 			Button::DefaultPressDrawFunction,
@@ -72,29 +72,29 @@ namespace NVisualSort {
 			nullptr
 		};
 
-		// һϢһεϢж¼
+		// 根据上一次鼠标消息和这一次的鼠标消息，判断鼠标事件类型
 		std::optional<size_t> GetMouseEventType(const ExMessage& last_message_, const ExMessage& current_message_) const noexcept {
 			bool wasIn = this->IsMouseInButton(last_message_);
 			bool isIn = this->IsMouseInButton(current_message_);
 
-			// ֻڰťʱ¼
+			// 只在按钮内时处理按键相关事件
 			if (isIn) {
 				bool lastDown = last_message_.lbutton;
 				bool currDown = current_message_.lbutton;
 
-				// £̧£ڰťⰴº룩
+				// 按下：左键从抬起→按下（或在按钮外按下后移入）
 				if (currDown && (!lastDown || !wasIn)) {
 					return Button::Press;
 				}
-				// ͷţӰ¡̧
+				// 释放：左键从按下→抬起
 				if (lastDown && !currDown) {
 					return Button::Release;
 				}
-				// קƶ
+				// 拖拽：左键持续按下且移动
 				if (lastDown && currDown && (last_message_.x != current_message_.x || last_message_.y != current_message_.y)) {
 					return Button::Drag;
 				}
-				// ͣ밴ť
+				// 悬停：鼠标进入按钮区域
 				if ((!wasIn) || (lastDown &&!currDown)) {
 					return Button::Hover;
 				}
@@ -108,11 +108,11 @@ namespace NVisualSort {
 
 	public:
 
-		constexpr inline static size_t Hover = 0; // ͣ¼
-		constexpr inline static size_t Press = 1; // 갴¼
-		constexpr inline static size_t Release = 2; // ͷ¼
-		constexpr inline static size_t Leave = 3; // 뿪¼
-		constexpr inline static size_t Drag = 4; // ק¼
+		constexpr inline static size_t Hover = 0; // 鼠标悬停事件索引
+		constexpr inline static size_t Press = 1; // 鼠标按下事件索引
+		constexpr inline static size_t Release = 2; // 鼠标释放事件索引
+		constexpr inline static size_t Leave = 3; // 鼠标离开事件索引
+		constexpr inline static size_t Drag = 4; // 鼠标拖拽事件索引
 
 		Button() = default;
 		Button(const Button&) = default;
@@ -411,8 +411,8 @@ namespace NVisualSort {
 
 	private:
 
-		std::vector<Button> m_buttons; // ťб
-		std::shared_ptr<std::atomic<bool>> m_exitFlag; // ˳־ⲿ¼ѭ
+		std::vector<Button> m_buttons; // 按钮列表
+		std::shared_ptr<std::atomic<bool>> m_exitFlag; // 退出标志，供外部控制事件循环
 
 		std::optional<size_t> LinearFindButtonIndex(const ExMessage& mouse_message_) const noexcept {
 			for (size_t index = 0; index < this->m_buttons.size(); ++index) {
@@ -420,7 +420,7 @@ namespace NVisualSort {
 					return index;
 				}
 			}
-			return std::nullopt; // ûҵť
+			return std::nullopt; // 没有找到按钮
 		}
 
 		struct ButtonBlockItem {
@@ -476,12 +476,12 @@ namespace NVisualSort {
 
 		static void GetMessageLoop() {
 			std::lock_guard getMessageLoopLock(ButtonSequence::s_getMessageMutex);
-			ButtonSequence::s_exitGetMessage.store(false, std::memory_order_release); // ˳־׼¼ѭ
+			ButtonSequence::s_exitGetMessage.store(false, std::memory_order_release); // 重置退出标志，准备进入事件循环
 			ButtonSequence::s_isGettingMessage.store(true, std::memory_order_release);
 			std::list<ButtonBlockItem> localBlockTasks;
-			std::list<ButtonNonBlockItem> localNonBlockTasks; // бִʱȫ
+			std::list<ButtonNonBlockItem> localNonBlockTasks; // 本地任务列表，避免在执行任务时持有全局锁
 			ScopeGuard clearLocalTasksGuard([&localBlockTasks, &localNonBlockTasks]() {
-				ButtonSequence::s_exitGetMessage.store(true, std::memory_order_release); // ¼ѭ˳ʱ˳־
+				ButtonSequence::s_exitGetMessage.store(true, std::memory_order_release); // 在事件循环退出时设置退出标志
 				ButtonSequence::s_isGettingMessage.store(false, std::memory_order_release);
 				for (auto& item : localBlockTasks) {
 					item.m_exitLoopPtr->store(true, std::memory_order_release);
@@ -491,13 +491,13 @@ namespace NVisualSort {
 					}
 				}
 				for (auto& item : localNonBlockTasks) {
-					item.m_exitLoopPtr->store(true, std::memory_order_release); // ¼ѭ˳ʱ˳־֪ͨ˳
+					item.m_exitLoopPtr->store(true, std::memory_order_release); // 在事件循环退出时设置退出标志，通知任务退出
 				}
 			});
 
 			while (!ButtonSequence::s_exitGetMessage.load(std::memory_order_acquire)) {
 
-				::getmessage(&ButtonSequence::s_mouseMessage, EX_MOUSE); // ȡϢ
+				::getmessage(&ButtonSequence::s_mouseMessage, EX_MOUSE); // 获取鼠标消息
 				if (ButtonSequence::s_exitGetMessage.load(std::memory_order_acquire)) {
 					return;
 				}
@@ -522,11 +522,11 @@ namespace NVisualSort {
 				auto nonBlockTaskIter = localNonBlockTasks.begin();
 				while (nonBlockTaskIter != localNonBlockTasks.end()) {
 					if(nonBlockTaskIter->m_exitLoopPtr->load(std::memory_order_acquire)) {
-						nonBlockTaskIter = localNonBlockTasks.erase(nonBlockTaskIter); // ˳Ƴ
+						nonBlockTaskIter = localNonBlockTasks.erase(nonBlockTaskIter); // 任务退出，移除任务
 					}
 					else {
 						if (*nonBlockTaskIter->m_nonBlockFunc) {
-							nonBlockTaskIter->m_nonBlockFunc->operator()(); // ִ
+							nonBlockTaskIter->m_nonBlockFunc->operator()(); // 执行任务
 						}
 						++nonBlockTaskIter;
 					}
@@ -563,7 +563,7 @@ namespace NVisualSort {
 			}
 		}
 		~ButtonSequence() {
-			this->m_exitFlag->store(true, std::memory_order_release); // ʱ˳־֪ͨ¼ѭ˳
+			this->m_exitFlag->store(true, std::memory_order_release); // 在销毁时设置退出标志，通知事件循环退出
 		}
 
 		std::vector<Button>& GetButtons() noexcept {
@@ -615,7 +615,7 @@ namespace NVisualSort {
 		ButtonSequence& SetButton(size_t index_, int left_, int top_, int right_, int bottom_, const std::wstring& text_ = L"",
 			const std::function<void(Button&, ExMessage)>& release_func_ = nullptr) {
 			if (index_ >= this->m_buttons.size()) {
-				throw WideError(L"Button ±Խ磡");
+				throw WideError(L"Button 下标越界！");
 			}
 			this->m_buttons[index_].SetButton(left_, top_, right_, bottom_, text_, release_func_);
 			return *this;
@@ -626,28 +626,28 @@ namespace NVisualSort {
 		}
 		ButtonSequence& SetButtonAsCross(size_t index_, Coordinate center_, Fraction size_, const std::function<void(Button&)>& last_work_ = nullptr) {
 			if (index_ >= this->m_buttons.size()) {
-				throw WideError(L"Button ±Խ磡");
+				throw WideError(L"Button 下标越界！");
 			}
 			this->m_buttons[index_].SetCross(center_, size_, this->m_exitFlag, last_work_);
 			return *this;
 		}
 		ButtonSequence& SetButtonAsSwitch(size_t index_, RECT rect_, std::shared_ptr<bool> switch_ptr_, const std::function<void()> other_work_ = nullptr) {
 			if (index_ >= this->m_buttons.size()) {
-				throw WideError(L"Button ±Խ磡");
+				throw WideError(L"Button 下标越界！");
 			}
 			this->m_buttons[index_].SetSwitch(rect_, switch_ptr_, other_work_);
 			return *this;
 		}
 		ButtonSequence& SetButtonAsSwitch(size_t index_, RECT rect_, bool& switch_ptr_, std::function<void()> other_work_ = nullptr) {
 			if (index_ >= this->m_buttons.size()) {
-				throw WideError(L"Button ±Խ磡");
+				throw WideError(L"Button 下标越界！");
 			}
 			this->m_buttons[index_].SetSwitch(rect_, switch_ptr_, other_work_);
 			return *this;
 		}
 		ButtonSequence& SetButtonAsThumb(size_t index_, RECT rect_, Fraction default_value_, const std::function<std::wstring(Fraction)>& set_value_func_) {
 			if (index_ >= this->m_buttons.size()) {
-				throw WideError(L"Button ±Խ磡");
+				throw WideError(L"Button 下标越界！");
 			}
 			this->m_buttons[index_].SetThumb(rect_, default_value_, set_value_func_);
 			return *this;
@@ -682,17 +682,17 @@ namespace NVisualSort {
 			}
 		}
 
-		// ¼ѭ
+		// 阻塞事件循环
 		void RunBlockButtonLoop() {
 
-			this->m_exitFlag->store(false, std::memory_order_release); // ˳־׼¼ѭ
+			this->m_exitFlag->store(false, std::memory_order_release); // 重置退出标志，准备进入事件循环
 
-			this->DrawButtons(); // ưť
+			this->DrawButtons(); // 绘制按钮
 
-			std::optional<size_t> lastButtonIndex; // һڵİť
-			ExMessage lastMouseMessage = {}; // һεϢ
-			std::optional<size_t> currentButtonIndex; // ǰڵİť
-			auto currentMouseMessagePtr = std::make_shared<ExMessage>(); // ǰϢ
+			std::optional<size_t> lastButtonIndex; // 上一次鼠标所在的按钮索引
+			ExMessage lastMouseMessage = {}; // 上一次的鼠标消息
+			std::optional<size_t> currentButtonIndex; // 当前鼠标所在的按钮索引
+			auto currentMouseMessagePtr = std::make_shared<ExMessage>(); // 当前的鼠标消息
 			std::mutex waitMessageMutex;
 			auto notFalseWakeupPtr = std::make_shared<std::atomic<bool>>(false);
 			auto waitMessageCVPtr = std::make_shared<std::condition_variable>();
@@ -718,23 +718,23 @@ namespace NVisualSort {
 				if (ButtonSequence::s_exitGetMessage.load(std::memory_order_acquire)) {
 					return;
 				}
-				*currentMouseMessagePtr = ButtonSequence::s_mouseMessage; // ȡǰϢ
-				currentButtonIndex = this->LinearFindButtonIndex(*currentMouseMessagePtr); // ҵǰڵİť
+				*currentMouseMessagePtr = ButtonSequence::s_mouseMessage; // 获取当前鼠标消息
+				currentButtonIndex = this->LinearFindButtonIndex(*currentMouseMessagePtr); // 查找当前鼠标所在的按钮索引
 
 				if(currentButtonIndex.has_value()) {
-					std::optional<size_t> eventType = this->m_buttons[currentButtonIndex.value()].GetMouseEventType(lastMouseMessage, *currentMouseMessagePtr); // ȡ¼
+					std::optional<size_t> eventType = this->m_buttons[currentButtonIndex.value()].GetMouseEventType(lastMouseMessage, *currentMouseMessagePtr); // 获取鼠标事件类型
 					if (eventType.has_value()) {
-						std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[currentButtonIndex.value()].m_callbackFuncs[eventType.value()]; // ȡص
+						std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[currentButtonIndex.value()].m_callbackFuncs[eventType.value()]; // 获取回调函数
 						if (callbackFunc) {
-							callbackFunc(this->m_buttons[currentButtonIndex.value()], *currentMouseMessagePtr); // ִлص
+							callbackFunc(this->m_buttons[currentButtonIndex.value()], *currentMouseMessagePtr); // 执行回调函数
 						}
 					}
 				}
 
 				if(lastButtonIndex.has_value() && lastButtonIndex != currentButtonIndex) {
-					const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[lastButtonIndex.value()].m_callbackFuncs[Button::Leave]; // ȡص
+					const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[lastButtonIndex.value()].m_callbackFuncs[Button::Leave]; // 获取回调函数
 					if (callbackFunc) {
-						callbackFunc(this->m_buttons[lastButtonIndex.value()], *currentMouseMessagePtr); // ִлص
+						callbackFunc(this->m_buttons[lastButtonIndex.value()], *currentMouseMessagePtr); // 执行回调函数
 					}
 				}
 
@@ -743,33 +743,33 @@ namespace NVisualSort {
 			}
 		}
 
-		// ¼ѭֹʹôЧĻصܵ¼ѭ޷
+		// 非阻塞事件循环，禁止使用带有阻塞效果的回调函数，否则可能导致事件循环无法正常进行
 		void RunNonBlockButtonLoop() {
-			this->m_exitFlag->store(false, std::memory_order_release); // ˳־׼¼ѭ
+			this->m_exitFlag->store(false, std::memory_order_release); // 重置退出标志，准备进入事件循环
 
-			this->DrawButtons(); // ưť
+			this->DrawButtons(); // 绘制按钮
 
-			auto lastMouseMessagePtr = std::make_shared<ExMessage>(); // һεϢ
-			auto lastButtonIndexPtr = std::make_shared<std::optional<size_t>>(); // һڵİť
+			auto lastMouseMessagePtr = std::make_shared<ExMessage>(); // 上一次的鼠标消息
+			auto lastButtonIndexPtr = std::make_shared<std::optional<size_t>>(); // 上一次鼠标所在的按钮索引
 
 			ButtonSequence::AddNonBlockTask(this->m_exitFlag, std::make_shared<std::function<void()>>([this, lastMouseMessagePtr, lastButtonIndexPtr]() {
-				ExMessage currentMouseMessage = ButtonSequence::s_mouseMessage; // ȡǰϢ
-				std::optional<size_t> currentButtonIndex = this->LinearFindButtonIndex(currentMouseMessage); // ǰڵİť
+				ExMessage currentMouseMessage = ButtonSequence::s_mouseMessage; // 获取当前鼠标消息
+				std::optional<size_t> currentButtonIndex = this->LinearFindButtonIndex(currentMouseMessage); // 当前鼠标所在的按钮索引
 
 				if (currentButtonIndex.has_value()) {
-					std::optional<size_t> eventType = this->m_buttons[currentButtonIndex.value()].GetMouseEventType(*lastMouseMessagePtr, currentMouseMessage); // ȡ¼
+					std::optional<size_t> eventType = this->m_buttons[currentButtonIndex.value()].GetMouseEventType(*lastMouseMessagePtr, currentMouseMessage); // 获取鼠标事件类型
 					if (eventType.has_value()) {
-						const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[currentButtonIndex.value()].m_callbackFuncs[eventType.value()]; // ȡص
+						const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[currentButtonIndex.value()].m_callbackFuncs[eventType.value()]; // 获取回调函数
 						if (callbackFunc) {
-							callbackFunc(this->m_buttons[currentButtonIndex.value()], currentMouseMessage); // ִлص
+							callbackFunc(this->m_buttons[currentButtonIndex.value()], currentMouseMessage); // 执行回调函数
 						}
 					}
 				}
 
 				if (lastButtonIndexPtr->has_value() && *lastButtonIndexPtr != currentButtonIndex) {
-					const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[lastButtonIndexPtr->value()].m_callbackFuncs[Button::Leave]; // ȡص
+					const std::function<void(Button&, ExMessage)>& callbackFunc = this->m_buttons[lastButtonIndexPtr->value()].m_callbackFuncs[Button::Leave]; // 获取回调函数
 					if (callbackFunc) {
-						callbackFunc(this->m_buttons[lastButtonIndexPtr->value()], currentMouseMessage); // ִлص
+						callbackFunc(this->m_buttons[lastButtonIndexPtr->value()], currentMouseMessage); // 执行回调函数
 					}
 				}
 
@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 按像素列聚合：元素比像素列多时，每一列显示映射到它的那些元素的最小值、最大值与平均值
+	// 元素 i 映射到第 i * 列数 / 元素数 列；和随元素修改增量更新，被修改的元素原来恰好是极值时只把这一列的极值标记为过期，取用时再重新计算
+	class ColumnAggregate {
+
+	public:
+
+		struct Column {
+			int minValue = 0;
+			int maxValue = 0;
+			int meanValue = 0;
+		};
+
+	private:
+
+		size_t m_elementNum = 0;
+		size_t m_columnNum = 0;
+		std::vector<int64_t> m_sums;
+		std::vector<int> m_minValues;
+		std::vector<int> m_maxValues;
+		std::vector<uint8_t> m_isStale; // 极值过期的列
+
+		// value_of_(i) 返回第 i 个元素的值
+		template<typename ValueOf>
+		void ComputeMinMax(size_t column_, const ValueOf& value_of_) {
+			size_t end = this->GetBeginIndex(column_ + 1);
+			int minValue = value_of_(this->GetBeginIndex(column_));
+			int maxValue = minValue;
+			for (size_t i = this->GetBeginIndex(column_) + 1; i < end; ++i) {
+				int value = value_of_(i);
+				minValue = (std::min)(minValue, value);
+				maxValue = (std::max)(maxValue, value);
+			}
+			this->m_minValues[column_] = minValue;
+			this->m_maxValues[column_] = maxValue;
+			this->m_isStale[column_] = 0;
+		}
+
+	public:
+
+		size_t GetColumnNum() const noexcept {
+			return this->m_columnNum;
+		}
+
+		size_t GetColumnIndex(size_t element_index_) const noexcept {
+			return static_cast<size_t>(static_cast<uint64_t>(element_index_) * this->m_columnNum / this->m_elementNum);
+		}
+
+		// 第 column_ 列的第一个元素（column_ 为列数时返回元素数）
+		size_t GetBeginIndex(size_t column_) const noexcept {
+			return static_cast<size_t>((static_cast<uint64_t>(column_) * this->m_elementNum + this->m_columnNum - 1) / this->m_columnNum);
+		}
+
+		// 重新计算全部列，要求元素数不少于列数（每列至少一个元素）
+		template<typename ValueOf>
+		void Build(size_t element_num_, size_t column_num_, const ValueOf& value_of_) {
+			this->m_elementNum = element_num_;
+			this->m_columnNum = column_num_;
+			this->m_sums.assign(column_num_, 0);
+			this->m_minValues.assign(column_num_, 0);
+			this->m_maxValues.assign(column_num_, 0);
+			this->m_isStale.assign(column_num_, 0);
+			for (size_t column = 0; column < column_num_; ++column) {
+				size_t end = this->GetBeginIndex(column + 1);
+				for (size_t i = this->GetBeginIndex(column); i < end; ++i) {
+					this->m_sums[column] += value_of_(i);
+				}
+				this->ComputeMinMax(column, value_of_);
+			}
+		}
+
+		// 第 element_index_ 个元素从 old_value_ 改为 new_value_，返回它所在的列
+		size_t Update(size_t element_index_, int old_value_, int new_value_) noexcept {
+			size_t column = this->GetColumnIndex(element_index_);
+			this->m_sums[column] += static_cast<int64_t>(new_value_) - old_value_;
+			if (!this->m_isStale[column]) {
+				if ((old_value_ == this->m_minValues[column] && new_value_ > old_value_)
+					|| (old_value_ == this->m_maxValues[column] && new_value_ < old_value_)) {
+					this->m_isStale[column] = 1;
+				}
+				else {
+					this->m_minValues[column] = (std::min)(this->m_minValues[column], new_value_);
+					this->m_maxValues[column] = (std::max)(this->m_maxValues[column], new_value_);
+				}
+			}
+			return column;
+		}
+
+		template<typename ValueOf>
+		Column GetColumn(size_t column_, const ValueOf& value_of_) {
+			if (this->m_isStale[column_]) {
+				this->ComputeMinMax(column_, value_of_);
+			}
+			int64_t count = static_cast<int64_t>(this->GetBeginIndex(column_ + 1) - this->GetBeginIndex(column_));
+			int64_t sum = this->m_sums[column_];
+			int64_t mean = (sum >= 0 ? sum + count / 2 : sum - count / 2) / count;
+			return { this->m_minValues[column_], this->m_maxValues[column_], static_cast<int>(mean) };
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 复杂度模型，如 n log n
+	class ComplexityModel {
+
+	private:
+
+		std::string m_name; // 模型名称
+		double (*m_func)(double) = nullptr; // f(n)
+
+	public:
+
+		ComplexityModel(std::string name_, double (*func_)(double)) : m_name(std::move(name_)), m_func(func_) {}
+
+		const std::string& GetName() const noexcept {
+			return this->m_name;
+		}
+
+		double operator()(double n_) const {
+			return this->m_func(n_);
+		}
+
+	};
+
+	// 用于拟合的候选模型：n、n log n、n^2、n^2.7（臭皮匠排序为 n^(log 3 / log 1.5)）
+	inline const std::vector<ComplexityModel>& GetComplexityModels() {
+		static const std::vector<ComplexityModel> models = {
+			ComplexityModel("n", [](double n_) { return n_; }),
+			ComplexityModel("n log n", [](double n_) { return n_ * std::log2(n_); }),
+			ComplexityModel("n^2", [](double n_) { return n_ * n_; }),
+			ComplexityModel("n^2.7", [](double n_) { return std::pow(n_, 2.7095); })
+		};
+		return models;
+	}
+
+	// log2(n!)：基于比较的排序在最坏情况下至少需要的比较次数
+	inline double Log2Factorial(size_t n_) {
+		return std::lgamma(static_cast<double>(n_) + 1) / std::log(2.0);
+	}
+
+	// 一个模型的拟合结果：value ≈ constant * f(n)
+	struct ComplexityModelFit {
+		const ComplexityModel* model = nullptr;
+		double constant = 0.0; // 常数
+		double error = 0.0; // 对数坐标下的均方根误差（0.1 约等于 10% 的相对误差）
+	};
+
+	// 根据 (n, value) 样本做经验复杂度拟合
+	class ComplexityFit {
+
+	private:
+
+		std::vector<std::pair<double, double>> m_samples; // (n, value)，只保存 n > 1、value > 0 的样本
+
+	public:
+
+		void AddSample(size_t n_, double value_) {
+			if (n_ > 1 && value_ > 0) {
+				this->m_samples.emplace_back(static_cast<double>(n_), value_);
+			}
+		}
+
+		size_t GetSampleNum() const noexcept {
+			return this->m_samples.size();
+		}
+
+		// 对数坐标最小二乘：value ≈ constant * n^exponent，返回 (exponent, constant)；样本少于 2 个时返回 (0, 0)
+		std::pair<double, double> FitPowerLaw() const {
+			if (this->m_samples.size() < 2) {
+				return { 0.0, 0.0 };
+			}
+			double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+			for (const auto& [n, value] : this->m_samples) {
+				double x = std::log(n);
+				double y = std::log(value);
+				sumX += x;
+				sumY += y;
+				sumXX += x * x;
+				sumXY += x * y;
+			}
+			double sampleNum = static_cast<double>(this->m_samples.size());
+			double denominator = sampleNum * sumXX - sumX * sumX;
+			if (denominator == 0) {
+				return { 0.0, 0.0 };
+			}
+			double exponent = (sampleNum * sumXY - sumX * sumY) / denominator;
+			double constant = std::exp((sumY - exponent * sumX) / sampleNum);
+			return { exponent, constant };
+		}
+
+		// 固定模型 f 时，对数坐标下最优的常数是 value / f(n) 的几何平均
+		ComplexityModelFit FitModel(const ComplexityModel& model_) const {
+			ComplexityModelFit result;
+			result.model = &model_;
+			if (this->m_samples.empty()) {
+				return result;
+			}
+			double sumLogRatio = 0;
+			for (const auto& [n, value] : this->m_samples) {
+				sumLogRatio += std::log(value / model_(n));
+			}
+			double meanLogRatio = sumLogRatio / this->m_samples.size();
+			double sumSquare = 0;
+			for (const auto& [n, value] : this->m_samples) {
+				double residual = std::log(value / model_(n)) - meanLogRatio;
+				sumSquare += residual * residual;
+			}
+			result.constant = std::exp(meanLogRatio);
+			result.error = std::sqrt(sumSquare / this->m_samples.size());
+			return result;
+		}
+
+		// 误差最小的候选模型
+		ComplexityModelFit FitBestModel() const {
+			ComplexityModelFit best;
+			for (const ComplexityModel& model : GetComplexityModels()) {
+				ComplexityModelFit fit = this->FitModel(model);
+				if (best.model == nullptr || fit.error < best.error) {
+					best = fit;
+				}
+			}
+			return best;
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -14,10 +14,10 @@ namespace NVisualSort {
 
 	constexpr unsigned int DefaultWidth = 800;
 	constexpr unsigned int DefaultHeight = 600;
-	constexpr COLORREF DefaultCanvasColor = RGB(0x33, 0x33, 0x33); // ĬϻɫΪɫ
-	constexpr wchar_t DefaultTypeface[] = L""; // ĬΪ壬ÿ:
+	constexpr COLORREF DefaultCanvasColor = RGB(0x33, 0x33, 0x33); // 默认画布颜色为灰色
+	constexpr wchar_t DefaultTypeface[] = L"楷体"; // 默认字体为楷体，楷体好看捏:）
 
-	// ù࣬ʹõģʽ
+	// 配置管理器类，使用单例模式
 	class ConfigManager {
 
 	private:
@@ -30,7 +30,7 @@ namespace NVisualSort {
 		std::atomic<unsigned int> m_maxHeight = DefaultHeight;
 		std::atomic<COLORREF> m_canvasColor = DefaultCanvasColor;
 
-		// ģʽ£ֹƶ
+		// 单例模式下，禁止拷贝和移动
 		ConfigManager() noexcept {
 			this->SetMinMaxSizeAuto();
 		}
@@ -52,11 +52,11 @@ namespace NVisualSort {
 
 	public:
 
-		// ȡ
+		// 获取宽度
 		Fraction GetWidth() const noexcept {
 			return Fraction(this->m_width.load(std::memory_order_acquire));
 		}
-		// ÿ
+		// 设置宽度
 		void SetWidth(unsigned int width_) noexcept {
 			width_ = std::clamp(width_, this->m_minWidth.load(), this->m_maxWidth.load());
 			this->m_width.store(width_, std::memory_order_release);
@@ -70,11 +70,11 @@ namespace NVisualSort {
 			return Fraction(this->m_maxWidth.load(std::memory_order_acquire));
 		}
 
-		// ȡ߶
+		// 获取高度
 		Fraction GetHeight() const noexcept {
 			return Fraction(this->m_height.load(std::memory_order_acquire));
 		}
-		// ø߶
+		// 设置高度
 		void SetHeight(unsigned int height_) noexcept {
 			height_ = std::clamp(height_, this->m_minHeight.load(), this->m_maxHeight.load());
 			this->m_height.store(height_, std::memory_order_release);
@@ -91,16 +91,16 @@ namespace NVisualSort {
 		Fraction GetMaxClientHeight() const {
 			HWND hwnd = GetHWnd();
 			if (!hwnd) {
-				throw WideError(L"ڻδ");
+				throw WideError(L"窗口还未创建");
 			}
 
 			RECT workArea = {};
 			SystemParametersInfo(SPI_GETWORKAREA, 0, &workArea, 0);
 			int screenWorkHeight = workArea.bottom - workArea.top;
 
-			// ȡڷǿͻָ߶
+			// 获取窗口非客户区各部分高度
 			RECT rcClient = { 0, 0, 0, 0 };
-			DWORD style = WS_OVERLAPPEDWINDOW;  // ͨʽ
+			DWORD style = WS_OVERLAPPEDWINDOW;  // 普通窗口样式
 			DWORD exStyle = 0;
 			AdjustWindowRectEx(&rcClient, style, FALSE, exStyle);
 
@@ -108,12 +108,12 @@ namespace NVisualSort {
 			int bottomBorderHeight = rcClient.bottom;
 			int totalNonClientHeight = topBorderHeight + bottomBorderHeight;
 
-			// ֻȥϱ߿
+			// 只减去上边框的情况
 			int maxClientHeight_topOnly = screenWorkHeight - topBorderHeight;
 			return Fraction(maxClientHeight_topOnly);
 		}
 
-		// ÿȺ͸߶
+		// 设置宽度和高度
 		void SetDimensions(unsigned int width_, unsigned  int height_) noexcept {
 			width_ = std::clamp(width_, this->m_minWidth.load(), this->m_maxWidth.load());
 			height_ = std::clamp(height_, this->m_minHeight.load(), this->m_maxHeight.load());
@@ -135,16 +135,16 @@ namespace NVisualSort {
 			return this->GetHeight() / 2;
 		}
 
-		// ȡ
+		// 获取中心坐标
 		Coordinate GetCenterXY() const noexcept {
 			return Coordinate(this->GetCenterX(), this->GetCenterY());
 		}
 
-		// ȡɫ
+		// 获取画布颜色
 		COLORREF GetCanvasColor() const noexcept {
 			return this->m_canvasColor.load(std::memory_order_acquire);
 		}
-		// ûɫ
+		// 设置画布颜色
 		void SetCanvasColor(COLORREF color_) noexcept {
 			this->m_canvasColor.store(color_, std::memory_order_release);
 		}
@@ -153,13 +153,13 @@ namespace NVisualSort {
 			return { 0, 0, static_cast<LONG>(this->GetWidth()), static_cast<LONG>(this->GetHeight()) };
 		}
 
-		// ̰߳ȫ
+		// 生成随机数（线程安全）
 		unsigned int GenerateRandom() const {
 			static thread_local std::mt19937 engine(std::random_device{}());
 			return engine();
 		}
 
-		// ָΧ
+		// 生成指定范围的随机数
 		template<typename T = int>
 		T GenerateRandomRange(T min_value_, T max_value_) const {
 			static thread_local std::mt19937 engine(std::random_device{}());
@@ -173,7 +173,7 @@ namespace NVisualSort {
 			}
 		}
 
-		// ȡùʵģʽ
+		// 获取配置管理器实例（单例模式）
 		friend inline ConfigManager& GetConfigManager() noexcept;
 
 	};
@@ -5,7 +5,7 @@
 
 namespace NVisualSort {
 
-	// ࣬ʾά
+	// 坐标类，表示二维坐标
 	class Coordinate {
 
 	public:
@@ -61,10 +61,10 @@ namespace NVisualSort {
 	};
 
 	static_assert(sizeof(Coordinate) == sizeof(POINT),
-		"Coordinate ĴС POINT ĴСͬ");
+		"Coordinate 的大小必须与 POINT 的大小相同");
 	static_assert(offsetof(Coordinate, x) == offsetof(POINT, x),
-		"Coordinate::x ƫ POINT::x ƥ");
+		"Coordinate::x 偏移量必须与 POINT::x 匹配");
 	static_assert(offsetof(Coordinate, y) == offsetof(POINT, y),
-		"Coordinate::y ƫ POINT::y ƥ");
+		"Coordinate::y 偏移量必须与 POINT::y 匹配");
 
 }
\ No newline at end of file
@@ -1,339 +1,154 @@
 #pragma once
-#include <atomic>
+#include "Element.h"
+#include "ShardedCounter.h"
+#include <cstddef>
 #include <utility>
 #include <vector>
 
 namespace NVisualSort {
 
-	inline std::atomic<size_t> ActualStepNum{0};
+	inline ShardedCounter ActualStepNum; // 实际步数（按线程分片累加）
 
-	class Counter {
+	// 按类别统计的元素操作次数；一次赋值 a = b 会同时记一次写入（a）与一次读取（b），所以各类之和可能大于实际步数
+	inline ShardedCounter CounterCompareNum; // 比较次数
+	inline ShardedCounter CounterReadNum;    // 读取次数（拷贝、转换为 int、参与算术运算）
+	inline ShardedCounter CounterWriteNum;   // 写入次数（赋值、复合赋值、自增自减）
+	inline ShardedCounter CounterSwapNum;    // 交换次数
+
+	// Counter 的操作类别
+	enum class CounterOperation {
+		Compare,
+		Read,
+		Write,
+		Swap
+	};
+
+	inline void AddCounterOperation(CounterOperation operation_) {
+		switch (operation_) {
+		case CounterOperation::Compare: ++CounterCompareNum; break;
+		case CounterOperation::Read: ++CounterReadNum; break;
+		case CounterOperation::Write: ++CounterWriteNum; break;
+		case CounterOperation::Swap: ++CounterSwapNum; break;
+		}
+	}
+
+	// 各类操作次数的快照
+	struct CounterStepNums {
+		size_t actual = 0;
+		size_t compare = 0;
+		size_t read = 0;
+		size_t write = 0;
+		size_t swap = 0;
+	};
+
+	// 计数策略：只有被计数数组中的元素（m_notTemp 为真）参与的操作才计数，拷贝出来的临时元素不计数；
+	// 例外是两个元素之间的比较：临时元素也是从数组拷贝出来的数据，它们之间的比较同样是排序所做的比较，总是计入比较次数
+	template<typename T>
+	class CountPolicy {
 
 	private:
 
-		int m_value = 0;
 		bool m_notTemp = false;
 
-		inline void IncrementIfNeeded() const {
-			if (this->m_notTemp) {
+		static void Add(const T& element_, CounterOperation operation_) {
+			if (element_.m_notTemp) {
 				++ActualStepNum;
+				AddCounterOperation(operation_);
 			}
 		}
 
-		inline void IncrementIfNeeded(const Counter& other_) const {
-			if (this->m_notTemp || other_.m_notTemp) {
+		// 比较两个元素只记一次比较（两个都是临时元素时也记，但不计入实际步数）；其他双目操作中 element1_ 按 operation_ 记、element2_ 按读取记
+		static void Add(const T& element1_, const T& element2_, CounterOperation operation_) {
+			if (element1_.m_notTemp || element2_.m_notTemp) {
 				++ActualStepNum;
 			}
-		}
-
-	public:
-
-		Counter(int value_ = 0, bool not_temp_ = false) :m_value(value_), m_notTemp(not_temp_) {}
-
-		Counter(const Counter& other_) {
-			this->m_value = other_.m_value;
-			this->m_notTemp = false;
-			other_.IncrementIfNeeded();
-		}
-
-		void SetCounter(int value_, bool not_temp_) {
-			this->m_value = value_;
-			this->m_notTemp = not_temp_;
-		}
-
-		static void SetCounters(const std::vector<int>& data_, std::vector<Counter>& counters_) {
-			counters_.resize(data_.size());
-			for (size_t counterIndex = 0; counterIndex < data_.size(); ++counterIndex) {
-				counters_[counterIndex].m_value = data_[counterIndex];
-				counters_[counterIndex].m_notTemp = true;
+			if (operation_ == CounterOperation::Compare) {
+				++CounterCompareNum;
+				return;
+			}
+			if (element1_.m_notTemp) {
+				AddCounterOperation(operation_);
+			}
+			if (element2_.m_notTemp) {
+				++CounterReadNum;
 			}
 		}
 
-		bool operator>(int value_) const {
-			IncrementIfNeeded();
-			return m_value > value_;
-		}
-
-		bool operator>(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value > counter_.m_value;
-		}
-
-		bool operator<(int value_) const {
-			IncrementIfNeeded();
-			return m_value < value_;
-		}
-
-		bool operator<(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value < counter_.m_value;
-		}
-
-		bool operator==(int value_) const {
-			IncrementIfNeeded();
-			return m_value == value_;
-		}
-
-		bool operator==(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value == counter_.m_value;
-		}
-
-		bool operator>=(int value_) const {
-			IncrementIfNeeded();
-			return m_value >= value_;
-		}
-
-		bool operator>=(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value >= counter_.m_value;
-		}
-
-		bool operator<=(int value_) const {
-			IncrementIfNeeded();
-			return m_value <= value_;
-		}
-
-		bool operator<=(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value <= counter_.m_value;
-		}
-
-		bool operator!=(int value_) const {
-			IncrementIfNeeded();
-			return m_value != value_;
-		}
-
-		bool operator!=(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value != counter_.m_value;
-		}
-
-		Counter& operator=(int value_) {
-			IncrementIfNeeded();
-			m_value = value_;
-			return *this;
-		}
-
-		Counter& operator=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value = counter_.m_value;
-			return *this;
-		}
-
-		operator int() const {
-			IncrementIfNeeded();
-			return m_value;
-		}
-
-		Counter& operator+=(int value_) {
-			IncrementIfNeeded();
-			m_value += value_;
-			return *this;
-		}
-
-		Counter& operator+=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value += counter_.m_value;
-			return *this;
-		}
-
-		Counter& operator-=(int value_) {
-			IncrementIfNeeded();
-			m_value -= value_;
-			return *this;
-		}
-
-		Counter& operator-=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value -= counter_.m_value;
-			return *this;
-		}
-
-		Counter& operator*=(int value_) {
-			IncrementIfNeeded();
-			m_value *= value_;
-			return *this;
-		}
-
-		Counter& operator*=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value *= counter_.m_value;
-			return *this;
-		}
-
-		Counter& operator/=(int value_) {
-			IncrementIfNeeded();
-			m_value /= value_;
-			return *this;
-		}
+	protected:
 
-		Counter& operator/=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value /= counter_.m_value;
-			return *this;
+		static void OnCompare(const T& element_, int) {
+			CountPolicy::Add(element_, CounterOperation::Compare);
 		}
-
-		Counter& operator%=(int value_) {
-			IncrementIfNeeded();
-			m_value %= value_;
-			return *this;
+		static void OnCompare(const T& element1_, const T& element2_) {
+			CountPolicy::Add(element1_, element2_, CounterOperation::Compare);
 		}
-
-		Counter& operator%=(const Counter& counter_) {
-			IncrementIfNeeded(counter_);
-			m_value %= counter_.m_value;
-			return *this;
+		static void OnRead(const T& element_) {
+			CountPolicy::Add(element_, CounterOperation::Read);
 		}
-
-		// ݼ
-		Counter& operator++() {
-			IncrementIfNeeded();
-			++m_value;
-			return *this;
+		static void OnRead(const T& element1_, const T& element2_) {
+			CountPolicy::Add(element1_, element2_, CounterOperation::Read);
 		}
-
-		int operator++(int) {
-			IncrementIfNeeded();
-			return m_value++;
+		static void OnWrite(const T& element_) {
+			CountPolicy::Add(element_, CounterOperation::Write);
 		}
-
-		Counter& operator--() {
-			IncrementIfNeeded();
-			--m_value;
-			return *this;
+		static void OnAssign(const T& target_, const T& source_, bool) {
+			CountPolicy::Add(target_, source_, CounterOperation::Write);
 		}
-
-		int operator--(int) {
-			IncrementIfNeeded();
-			return m_value--;
+		static void OnUpdate(const T& target_, const T& source_) {
+			CountPolicy::Add(target_, source_, CounterOperation::Write);
 		}
-
-		// 
-		int operator+(int value_) const {
-			IncrementIfNeeded();
-			return m_value + value_;
+		static void OnSwap(const T& element1_, const T& element2_, bool) {
+			if (element1_.m_notTemp || element2_.m_notTemp) {
+				++ActualStepNum;
+				++CounterSwapNum;
+			}
 		}
-
-		int operator-(int value_) const {
-			IncrementIfNeeded();
-			return m_value - value_;
+		static void OnSwap(const T& element_) {
+			CountPolicy::Add(element_, CounterOperation::Swap);
 		}
 
-		int operator*(int value_) const {
-			IncrementIfNeeded();
-			return m_value * value_;
-		}
+	public:
 
-		int operator/(int value_) const {
-			IncrementIfNeeded();
-			return m_value / value_;
-		}
+		static constexpr bool IsDrawn = false;
 
-		int operator%(int value_) const {
-			IncrementIfNeeded();
-			return m_value % value_;
+		static void AddSteps(size_t step_num_) {
+			ActualStepNum += step_num_;
 		}
 
-		int operator+(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value + counter_.m_value;
+		// 缓冲区中的元素也计数
+		static void MarkAsArray(std::vector<T>& buffer_) {
+			for (T& counter : buffer_) {
+				counter.SetCounter(counter.GetValue(), true);
+			}
 		}
 
-		int operator-(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value - counter_.m_value;
+		void SetCounter(int value_, bool not_temp_) {
+			static_cast<T&>(*this).SetValue(value_);
+			this->m_notTemp = not_temp_;
 		}
 
-		int operator*(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value * counter_.m_value;
+		// 把实际步数与各类操作次数清零
+		static void ResetStepNums() {
+			ActualStepNum = 0;
+			CounterCompareNum = 0;
+			CounterReadNum = 0;
+			CounterWriteNum = 0;
+			CounterSwapNum = 0;
 		}
 
-		int operator/(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value / counter_.m_value;
+		static CounterStepNums GetStepNums() {
+			return { ActualStepNum.load(), CounterCompareNum.load(), CounterReadNum.load(), CounterWriteNum.load(), CounterSwapNum.load() };
 		}
 
-		int operator%(const Counter& counter_) const {
-			IncrementIfNeeded(counter_);
-			return m_value % counter_.m_value;
+		static void SetCounters(const std::vector<int>& data_, std::vector<T>& counters_) {
+			counters_.resize(data_.size());
+			for (size_t counterIndex = 0; counterIndex < data_.size(); ++counterIndex) {
+				counters_[counterIndex].SetCounter(data_[counterIndex], true);
+			}
 		}
 
-		// Ԫ
-		friend bool operator>(int, const Counter&);
-		friend bool operator<(int, const Counter&);
-		friend bool operator==(int, const Counter&);
-		friend bool operator>=(int, const Counter&);
-		friend bool operator<=(int, const Counter&);
-		friend bool operator!=(int, const Counter&);
-		friend void swap(Counter&, Counter&);
-		friend void swap(Counter&, int&);
-		friend void swap(int&, Counter&);
-
 	};
 
-	bool operator>(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ > counter_.m_value;
-	}
-
-	bool operator<(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ < counter_.m_value;
-	}
-
-	bool operator==(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ == counter_.m_value;
-	}
-
-	bool operator>=(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ >= counter_.m_value;
-	}
-
-	bool operator<=(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ <= counter_.m_value;
-	}
-
-	bool operator!=(int value_, const Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		return value_ != counter_.m_value;
-	}
-
-	void swap(Counter& counter1_, Counter& counter2_) {
-		if (counter1_.m_notTemp || counter2_.m_notTemp) {
-			++ActualStepNum;
-		}
-		std::swap(counter1_.m_value, counter2_.m_value);
-	}
-
-	void swap(Counter& counter_, int& value_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		std::swap(counter_.m_value, value_);
-	}
-
-	void swap(int& value_, Counter& counter_) {
-		if (counter_.m_notTemp) {
-			++ActualStepNum;
-		}
-		std::swap(value_, counter_.m_value);
-	}
+	using Counter = Element<CountPolicy>;
 
-}
+}
\ No newline at end of file
@@ -22,12 +22,12 @@ namespace NVisualSort {
 
 	private:
 
-		inline static constexpr Fraction MinWidth{ 1,3 }; // СΪȵ1/3
-		inline static constexpr Fraction MinHeight{ 1,5 }; // С߶Ϊ߶ȵ1/5
-		inline static constexpr Fraction MaxWidth{ 8,9 }; // Ϊȵ8/9
-		inline static constexpr Fraction MaxHeight{ 8,9 }; // ߶Ϊ߶ȵ8/9
-		inline static constexpr Fraction Margin{ 1,20 }; // ıͱ߿ı߾Ϊ߶ȵ1/20
-		inline static constexpr Fraction TextSize{ 1,20 }; // ıСΪ߶ȵ1/20
+		inline static constexpr Fraction MinWidth{ 1,3 }; // 最小宽度为画布宽度的1/3
+		inline static constexpr Fraction MinHeight{ 1,5 }; // 最小高度为画布高度的1/5
+		inline static constexpr Fraction MaxWidth{ 8,9 }; // 最大宽度为画布宽度的8/9
+		inline static constexpr Fraction MaxHeight{ 8,9 }; // 最大高度为画布高度的8/9
+		inline static constexpr Fraction Margin{ 1,20 }; // 文本上下区域和边框上下区域的边距为画布高度的1/20
+		inline static constexpr Fraction TextSize{ 1,20 }; // 文本大小为画布高度的1/20
 
 		Sketch m_mainBox;
 		ButtonSequence m_buttons;
@@ -70,7 +70,7 @@ namespace NVisualSort {
 					F(1, 2) - F(this->m_mainBox.GetHeight()) / GetConfigManager().GetHeight() / 2,
 					F(1, 2) + F(textWidth) / GetConfigManager().GetWidth() / 2,
 					F(1, 2) + F(this->m_mainBox.GetHeight()) / GetConfigManager().GetHeight() / 2
-				); // ʹıȲˮƽ
+				); // 使用文本宽度并水平居中
 				this->m_mainBox.SetFrameRect(mainRect);
 			});
 		}
@@ -80,7 +80,7 @@ namespace NVisualSort {
 				::settextstyle(Dialog::GetTextSize(), 0, this->m_mainBox.GetTypeface().c_str());
 				RECT tempRect = this->m_mainBox.GetFrameRect();
 				int textHeight = ::drawtext(this->m_mainBox.GetText().c_str(), &tempRect, DT_CALCRECT | DT_WORDBREAK);
-				textHeight = textHeight + Dialog::GetMargin() * 2; // ӱ߾
+				textHeight = textHeight + Dialog::GetMargin() * 2; // 添加边距
 				textHeight = std::clamp(textHeight, static_cast<int>(Dialog::GetMinHeight()), static_cast<int>(Dialog::GetMaxHeight()));
 				using F = Fraction;
 				RECT mainRect = ComputeRect(
@@ -89,7 +89,7 @@ namespace NVisualSort {
 					F(1, 2) - F(textHeight) / GetConfigManager().GetHeight() / 2,
 					F(1, 2) + F(this->m_mainBox.GetWidth()) / GetConfigManager().GetWidth() / 2,
 					F(1, 2) + F(textHeight) / GetConfigManager().GetHeight() / 2
-				); // ʹı߶Ȳֱ
+				); // 使用文本高度并垂直居中
 				this->m_mainBox.SetFrameRect(mainRect);
 			});
 		}
@@ -178,8 +178,8 @@ namespace NVisualSort {
 		}
 
 		void RunNonBlockDialog() {
-			this->m_mainBox.DrawSketch(false); // ȻƶԻ
-			this->m_buttons.RunNonBlockButtonLoop(); // ѭ¼Զưť
+			this->m_mainBox.DrawSketch(false); // 先绘制对话框
+			this->m_buttons.RunNonBlockButtonLoop(); // 循环事件自动绘制按钮
 		}
 
 	};
@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 脏区间集合：收集一帧内改动过的横坐标区间，刷新时排序并合并重叠或相邻的区间，每个合并后的区间只刷新一次
+	class DirtyIntervalSet {
+
+	public:
+
+		struct Interval {
+			int left = 0;
+			int right = 0;
+			constexpr Interval() : Interval(0, 0) {}
+			constexpr Interval(int left_, int right_) noexcept : left(left_), right(right_) {}
+		};
+
+		static constexpr size_t MaxFlushNum = 16; // 合并后仍多于这么多个区间时，直接刷新它们的外包区间
+
+	private:
+
+		std::vector<Interval> m_intervals;
+
+	public:
+
+		// 连续改动同一区间（如同一个条形先高亮再恢复原色）只记一次
+		void Add(int left_, int right_) {
+			if (!this->m_intervals.empty() && this->m_intervals.back().left == left_ && this->m_intervals.back().right == right_) {
+				return;
+			}
+			this->m_intervals.emplace_back(left_, right_);
+		}
+
+		bool IsEmpty() const noexcept {
+			return this->m_intervals.empty();
+		}
+
+		void Clear() noexcept {
+			this->m_intervals.clear();
+		}
+
+		// 合并后对每个区间调用 flush_func_(left, right)，然后清空
+		template<typename Func>
+		void Flush(Func&& flush_func_) {
+			if (this->m_intervals.empty()) {
+				return;
+			}
+			std::sort(this->m_intervals.begin(), this->m_intervals.end(), [](const Interval& a_, const Interval& b_) {
+				return a_.left < b_.left;
+			});
+			size_t mergedNum = 0;
+			for (size_t i = 1; i < this->m_intervals.size(); ++i) {
+				Interval& last = this->m_intervals[mergedNum];
+				if (this->m_intervals[i].left <= last.right) {
+					last.right = (std::max)(last.right, this->m_intervals[i].right);
+				}
+				else {
+					this->m_intervals[++mergedNum] = this->m_intervals[i];
+				}
+			}
+			++mergedNum;
+			if (mergedNum > DirtyIntervalSet::MaxFlushNum) {
+				// 合并后的区间互不相交且按左端点有序，最后一个的右端点最大
+				flush_func_(this->m_intervals[0].left, this->m_intervals[mergedNum - 1].right);
+			}
+			else {
+				for (size_t i = 0; i < mergedNum; ++i) {
+					flush_func_(this->m_intervals[i].left, this->m_intervals[i].right);
+				}
+			}
+			this->m_intervals.clear();
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <mutex>
 #include <functional>
+#include <thread>
 #include <easyx.h>
 #include <utility>
 #include <vector>
@@ -9,25 +12,194 @@
 #include "Coordinate.h"
 #include "WideError.h"
 #include "ConfigManager.h"
+#include "DirtyIntervalSet.h"
+#include "FrameBuffer.h"
+#include "MpscQueue.h"
 
 namespace NVisualSort {
 
+	enum class DrawCommandType : uint8_t {
+		ClearRectangle,
+		SolidRectangle,
+		FillRectangle,
+		FlushBatchDraw
+	};
+
+	// 绘制队列中的一条命令，只覆盖条形用到的矩形清除、填充与刷新
+	struct DrawCommand {
+		DrawCommandType type = DrawCommandType::FlushBatchDraw;
+		RECT rect = {};
+		COLORREF color = 0;      // 填充颜色
+		COLORREF frameColor = 0; // FillRectangle 的边框
+		int frameThick = 0;
+		int frameStyle = 0;
+	};
+
 	class DrawingTool {
 
 	private:
 
+		static constexpr size_t DrawQueueCapacity = 8192;
+
 		std::recursive_mutex m_drawMutex;
 
-		// ģʽ£ֹƶ
+		// 绘制队列：演示排序时条形的绘制由排序线程放进无锁队列，渲染线程统一执行，排序线程（包括线程池的工作线程）不再争用 m_drawMutex
+		// 只有 Queue 开头的函数走队列，界面其它部分仍直接加锁绘制；同一线程放入的命令按顺序执行，不同线程之间本来就没有顺序
+		MpscQueue<DrawCommand> m_drawQueue{ DrawingTool::DrawQueueCapacity };
+		std::atomic<bool> m_isDrawQueueRunning = false;
+		std::atomic<bool> m_stopRenderThread = false;
+		std::atomic<bool> m_isRenderIdle = false; // 渲染线程队列空时在它上面阻塞，放入命令的线程看到它为真才唤醒
+		std::thread m_renderThread;
+		DirtyIntervalSet m_flushIntervals; // 渲染线程一批命令中要刷新的横坐标区间（只有渲染线程访问）
+
+		// 单例模式下，禁止拷贝和移动
 		DrawingTool() noexcept = default;
 		DrawingTool(const DrawingTool&) = delete;
 		DrawingTool& operator=(const DrawingTool&) = delete;
 		DrawingTool(DrawingTool&&) = delete;
 		DrawingTool& operator=(DrawingTool&&) = delete;
 
+		~DrawingTool() {
+			this->StopDrawQueue();
+		}
+
+		void ExecuteCommand(const DrawCommand& command_) {
+			switch (command_.type) {
+			case DrawCommandType::ClearRectangle:
+				this->ClearRectangle(command_.rect);
+				break;
+			case DrawCommandType::SolidRectangle:
+				this->SolidRectangle(command_.rect, command_.color);
+				break;
+			case DrawCommandType::FillRectangle:
+				this->FillRectangle(command_.rect, command_.frameThick, command_.frameStyle, command_.frameColor, command_.color);
+				break;
+			default:
+				break;
+			}
+		}
+
+		// 每次取出队列中现有的全部命令，在一次加锁内执行完；其中的刷新按横坐标区间合并（与 Strip 的脏区间相同，见 DirtyIntervalSet），
+		// 每个合并后的区间各刷新一次。条形的刷新都是整个条形区域的高度，纵向取这批刷新的外包范围
+		void RenderLoop() {
+			DrawCommand command;
+			while (true) {
+				bool isStopping = this->m_stopRenderThread.load(std::memory_order_acquire); // 先读，保证停止前放入的命令都会被执行
+				size_t commandNum = 0;
+				{
+					std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
+					int flushTop = 0;
+					int flushBottom = 0;
+					while (this->m_drawQueue.TryPop(command)) {
+						++commandNum;
+						if (command.type != DrawCommandType::FlushBatchDraw) {
+							this->ExecuteCommand(command);
+							continue;
+						}
+						flushTop = this->m_flushIntervals.IsEmpty() ? command.rect.top : (std::min)(flushTop, static_cast<int>(command.rect.top));
+						flushBottom = this->m_flushIntervals.IsEmpty() ? command.rect.bottom : (std::max)(flushBottom, static_cast<int>(command.rect.bottom));
+						this->m_flushIntervals.Add(command.rect.left, command.rect.right);
+					}
+					this->m_flushIntervals.Flush([this, flushTop, flushBottom](int left_, int right_) {
+						this->FlushBatchDraw(left_, flushTop, right_, flushBottom);
+					});
+				}
+				if (commandNum == 0) {
+					if (isStopping) {
+						return;
+					}
+					this->WaitForCommand();
+				}
+			}
+		}
+
+		// 队列空时阻塞，直到有线程放入命令或要求停止（与 WakeRenderThread 中的栅栏配对，不会漏掉唤醒）
+		void WaitForCommand() {
+			this->m_isRenderIdle.store(true, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (this->m_drawQueue.GetIsEmpty() && !this->m_stopRenderThread.load(std::memory_order_acquire)) {
+				this->m_isRenderIdle.wait(true, std::memory_order_acquire);
+			}
+			this->m_isRenderIdle.store(false, std::memory_order_relaxed);
+		}
+
+		// 放入命令或要求停止之后调用：渲染线程空闲时唤醒它，忙时只多一次读取
+		void WakeRenderThread() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (this->m_isRenderIdle.load(std::memory_order_relaxed) && this->m_isRenderIdle.exchange(false, std::memory_order_acq_rel)) {
+				this->m_isRenderIdle.notify_one();
+			}
+		}
+
+		void PushCommand(const DrawCommand& command_) {
+			this->m_drawQueue.Push(command_);
+			this->WakeRenderThread();
+		}
+
 	public:
 
-		// ַ֧ƺ
+		// 开启绘制队列并启动渲染线程（已开启时不做任何事）
+		void StartDrawQueue() {
+			if (this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				return;
+			}
+			this->m_stopRenderThread.store(false, std::memory_order_release);
+			this->m_renderThread = std::thread([this]() {
+				this->RenderLoop();
+			});
+			this->m_isDrawQueueRunning.store(true, std::memory_order_release);
+		}
+
+		// 等渲染线程执行完队列中的命令后关闭绘制队列，之后 Queue 开头的函数直接绘制
+		// 调用时不能再有线程往队列中放入命令（排序已经结束）
+		void StopDrawQueue() {
+			if (!this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				return;
+			}
+			this->m_stopRenderThread.store(true, std::memory_order_release);
+			this->WakeRenderThread();
+			this->m_renderThread.join();
+			this->m_isDrawQueueRunning.store(false, std::memory_order_release);
+		}
+
+		bool GetIsDrawQueueRunning() const noexcept {
+			return this->m_isDrawQueueRunning.load(std::memory_order_acquire);
+		}
+
+		// 以下 Queue 开头的函数在绘制队列开启时只放入命令，否则与同名函数相同
+		void QueueClearRectangle(int left_, int top_, int right_, int bottom_) {
+			if (this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				this->PushCommand(DrawCommand{ DrawCommandType::ClearRectangle, RECT(left_, top_, right_, bottom_) });
+				return;
+			}
+			this->ClearRectangle(left_, top_, right_, bottom_);
+		}
+
+		void QueueSolidRectangle(RECT rect_, COLORREF background_color_) {
+			if (this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				this->PushCommand(DrawCommand{ DrawCommandType::SolidRectangle, rect_, background_color_ });
+				return;
+			}
+			this->SolidRectangle(rect_, background_color_);
+		}
+
+		void QueueFillRectangle(RECT rect_, int frame_thick_, int frame_style_, COLORREF frame_color_, COLORREF background_color_) {
+			if (this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				this->PushCommand(DrawCommand{ DrawCommandType::FillRectangle, rect_, background_color_, frame_color_, frame_thick_, frame_style_ });
+				return;
+			}
+			this->FillRectangle(rect_, frame_thick_, frame_style_, frame_color_, background_color_);
+		}
+
+		void QueueFlushBatchDraw(int left_, int top_, int right_, int bottom_) {
+			if (this->m_isDrawQueueRunning.load(std::memory_order_acquire)) {
+				this->PushCommand(DrawCommand{ DrawCommandType::FlushBatchDraw, RECT(left_, top_, right_, bottom_) });
+				return;
+			}
+			this->FlushBatchDraw(left_, top_, right_, bottom_);
+		}
+
+		// 支持泛化绘制函数
 		void ExecuteWithLock(const std::function<void()>& func_) {
 			if (func_) {
 				std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
@@ -35,16 +207,15 @@ namespace NVisualSort {
 			}
 		}
 
-		// մ
+		// 清空窗口
 		void ClearDevice() noexcept {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::cleardevice();
 		}
 
-		// 
+		// 清除矩形区域
 		void ClearRectangle(RECT rect_) noexcept {
-			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
-			::clearrectangle(rect_.left, rect_.top, rect_.right, rect_.bottom);
+			this->ClearRectangle(rect_.left, rect_.top, rect_.right, rect_.bottom);
 		}
 
 		void ClearRectangle(int left_, int top_, int right_, int bottom_) noexcept {
@@ -52,7 +223,7 @@ namespace NVisualSort {
 			::clearrectangle(left_, top_, right_, bottom_);
 		}
 
-		// 
+		// 绘制线
 		void Line(std::pair<Coordinate, Coordinate> start_end_points_, int line_thick_, int line_style_, COLORREF line_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setlinestyle(line_style_, line_thick_);
@@ -60,7 +231,7 @@ namespace NVisualSort {
 			::line(start_end_points_.first.x, start_end_points_.first.y, start_end_points_.second.x, start_end_points_.second.y);
 		}
 
-		// 򣨰߿
+		// 填充矩形区域（包含边框）
 		void FillRectangle(RECT rect_, int frame_thick_, int frame_style_, COLORREF frame_color_, COLORREF background_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setlinestyle(frame_style_, frame_thick_);
@@ -69,10 +240,10 @@ namespace NVisualSort {
 			::fillrectangle(rect_.left, rect_.top, rect_.right, rect_.bottom);
 		}
 
-		// Σ߿
+		// 填充多边形（包含边框）
 		void FillPolygon(const std::vector<Coordinate>& points_, int frame_thick_, int frame_style_, COLORREF frame_color_, COLORREF background_color_) {
 			if (points_.size() < 3) {
-				throw WideError(L"ζ٣Ϊ" + std::to_wstring(points_.size()));
+				throw WideError(L"多边形顶点数量过少！数量为：" + std::to_wstring(points_.size()));
 			}
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setlinestyle(frame_style_, frame_thick_);
@@ -81,7 +252,7 @@ namespace NVisualSort {
 			::fillpolygon(points_.front().AsPointPtr(), static_cast<int>(points_.size()));
 		}
 
-		// ԲǾ򣨰߿
+		// 填充圆角矩形区域（包含边框）
 		void FillRoundRect(RECT rect_, int ellipse_width_, int ellipse_height_, int frame_thick_, int frame_style_, COLORREF frame_color_, COLORREF background_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setlinestyle(frame_style_, frame_thick_);
@@ -96,31 +267,31 @@ namespace NVisualSort {
 			::solidcircle(center_.x, center_.y, radius_);
 		}
 
-		// 򣨲߿
+		// 填充矩形区域（不包含边框）
 		void SolidRectangle(RECT rect_, COLORREF background_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setfillcolor(background_color_);
 			::solidrectangle(rect_.left, rect_.top, rect_.right, rect_.bottom);
 		}
 
-		// Σ߿
+		// 填充多边形（不包含边框）
 		void SolidPolygon(const std::vector<Coordinate>& points_, COLORREF background_color_) {
 			if (points_.size() < 3) {
-				throw WideError(L"ζ٣Ϊ" + std::to_wstring(points_.size()));
+				throw WideError(L"多边形顶点数量过少！数量为：" + std::to_wstring(points_.size()));
 			}
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setfillcolor(background_color_);
 			::solidpolygon(points_.front().AsPointPtr(), static_cast<int>(points_.size()));
 		}
 
-		// ԲǾ򣨲߿
+		// 填充圆角矩形区域（不包含边框）
 		void SolidRoundRect(RECT rect_, int ellipse_width_, int ellipse_height_, COLORREF background_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setfillcolor(background_color_);
 			::solidroundrect(rect_.left, rect_.top, rect_.right, rect_.bottom, ellipse_width_, ellipse_height_);
 		}
 
-		// ԲǾα߿
+		// 绘制圆角矩形边框
 		void RoundRect(RECT rect_, int ellipse_width_, int ellipse_height_, int frame_thick_, int frame_style_, COLORREF frame_color_) {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::setlinestyle(frame_style_, frame_thick_);
@@ -128,25 +299,43 @@ namespace NVisualSort {
 			::roundrect(rect_.left, rect_.top, rect_.right, rect_.bottom, ellipse_width_, ellipse_height_);
 		}
 
-		// ˢ
+		// 把内存画布整块拷贝到窗口的 (left_, top_) 处（超出窗口的部分被裁掉），之后要自己刷新
+		// 直接写 EasyX 的显存：FrameBuffer 的颜色是 COLORREF（0x00BBGGRR），显存是 0x00RRGGBB，逐像素用 BGR 转换
+		void DrawFrameBuffer(const FrameBuffer& frame_buffer_, int left_, int top_) noexcept {
+			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
+			DWORD* imageBuffer = ::GetImageBuffer();
+			int imageWidth = ::getwidth();
+			int beginX = (std::max)(left_, 0);
+			int beginY = (std::max)(top_, 0);
+			int endX = (std::min)(left_ + frame_buffer_.GetWidth(), imageWidth);
+			int endY = (std::min)(top_ + frame_buffer_.GetHeight(), ::getheight());
+			for (int y = beginY; y < endY; ++y) {
+				const uint32_t* sourceRow = frame_buffer_.GetPixels() + static_cast<size_t>(y - top_) * frame_buffer_.GetWidth();
+				DWORD* targetRow = imageBuffer + static_cast<size_t>(y) * imageWidth;
+				for (int x = beginX; x < endX; ++x) {
+					targetRow[x] = BGR(FrameBuffer::ToColor(sourceRow[x - left_]));
+				}
+			}
+		}
+
+		// 刷新区域
 		void FlushBatchDraw() noexcept {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::FlushBatchDraw();
 		}
 
-		// ˢ
+		// 刷新区域
 		void FlushBatchDraw(int left_, int top_, int right_, int bottom_) noexcept {
 			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
 			::FlushBatchDraw(left_, top_, right_, bottom_);
 		}
 
-		// ˢ
+		// 刷新区域
 		void FlushBatchDraw(RECT rect_) noexcept {
-			std::lock_guard<std::recursive_mutex> lock(this->m_drawMutex);
-			::FlushBatchDraw(rect_.left, rect_.top, rect_.right, rect_.bottom);
+			this->FlushBatchDraw(rect_.left, rect_.top, rect_.right, rect_.bottom);
 		}
 
-		// ı
+		// 绘制文本
 		void DrawText_(const std::wstring& text_, RECT rect_, int text_size_, COLORREF text_color_, UINT text_mode_ = DT_CENTER | DT_VCENTER, const std::wstring& font_ = DefaultTypeface) {
 			if(text_.empty()) {
 				return;
@@ -161,7 +350,7 @@ namespace NVisualSort {
 
 	};
 
-	// ȡƹʵ
+	// 获取绘制工具实例
 	inline DrawingTool& GetDrawingTool() noexcept {
 		static DrawingTool instance;
 		return instance;
@@ -0,0 +1,323 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 排序元素：只存一个 int，每个运算符只实现一次，运算之后调用插桩策略 Policy<Element> 的钩子
+	// Counter（计数）、Tracer（记录）、Strip（绘制）都是它的别名，新的插桩方式只需要写一个新的策略
+	// 策略是元素的基类（CRTP），可以带每个元素自己的状态（如 Counter 的 m_notTemp），它的静态成员与公有成员函数也就成了元素的成员
+	// 策略要提供的钩子（静态、protected 即可）：
+	//   OnCompare(e, int)、OnCompare(e1, e2)      比较
+	//   OnRead(e)、OnRead(e1, e2)                 拷贝构造、转换为 int、算术运算
+	//   OnWrite(e)                                赋值为 int、与 int 的复合赋值、自增自减（e 已经是新值）
+	//   OnAssign(target, source, keep_color)      元素之间的赋值（keep_color 为 CopyWithoutSetColor）
+	//   OnUpdate(target, source)                  元素之间的复合赋值
+	//   OnSwap(e1, e2, keep_color)、OnSwap(e)     元素之间的交换（keep_color 为 SwapWithoutSetColor）、与 int 交换
+	// 以及 IsDrawn（是否逐步绘制）、AddSteps（不经过元素的步数，如睡眠排序的等待）
+	// 与 MarkAsArray（排序用的缓冲区与原数组地位相同时，让缓冲区中的元素也按数组中的元素插桩）
+	template<template<typename> class Policy>
+	class Element : public Policy<Element<Policy>> {
+
+	private:
+
+		int m_value = 0;
+
+	public:
+
+		constexpr Element(int value_ = 0) noexcept : m_value(value_) {}
+
+		Element(const Element& other_) : Policy<Element>(), m_value(other_.m_value) {
+			Element::OnRead(other_);
+		}
+
+		// 读写值本身，不插桩
+		constexpr int GetValue() const noexcept {
+			return this->m_value;
+		}
+		Element& SetValue(int value_) noexcept {
+			this->m_value = value_;
+			return *this;
+		}
+
+		bool operator>(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value > value_;
+		}
+		bool operator>(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value > other_.m_value;
+		}
+		bool operator<(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value < value_;
+		}
+		bool operator<(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value < other_.m_value;
+		}
+		bool operator>=(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value >= value_;
+		}
+		bool operator>=(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value >= other_.m_value;
+		}
+		bool operator<=(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value <= value_;
+		}
+		bool operator<=(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value <= other_.m_value;
+		}
+		bool operator==(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value == value_;
+		}
+		bool operator==(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value == other_.m_value;
+		}
+		bool operator!=(int value_) const {
+			Element::OnCompare(*this, value_);
+			return this->m_value != value_;
+		}
+		bool operator!=(const Element& other_) const {
+			Element::OnCompare(*this, other_);
+			return this->m_value != other_.m_value;
+		}
+
+		friend bool operator>(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ > element_.m_value;
+		}
+		friend bool operator<(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ < element_.m_value;
+		}
+		friend bool operator>=(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ >= element_.m_value;
+		}
+		friend bool operator<=(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ <= element_.m_value;
+		}
+		friend bool operator==(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ == element_.m_value;
+		}
+		friend bool operator!=(int value_, const Element& element_) {
+			Element::OnCompare(element_, value_);
+			return value_ != element_.m_value;
+		}
+
+		Element& operator=(int value_) {
+			this->m_value = value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator=(const Element& other_) {
+			this->m_value = other_.m_value;
+			Element::OnAssign(*this, other_, false);
+			return *this;
+		}
+
+		// 赋值但不改变颜色（堆排序、基数排序给条形染色后用它搬动）
+		Element& CopyWithoutSetColor(const Element& other_) {
+			this->m_value = other_.m_value;
+			Element::OnAssign(*this, other_, true);
+			return *this;
+		}
+
+		operator int() const {
+			Element::OnRead(*this);
+			return this->m_value;
+		}
+
+		Element& operator+=(int value_) {
+			this->m_value += value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator+=(const Element& other_) {
+			this->m_value += other_.m_value;
+			Element::OnUpdate(*this, other_);
+			return *this;
+		}
+		Element& operator-=(int value_) {
+			this->m_value -= value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator-=(const Element& other_) {
+			this->m_value -= other_.m_value;
+			Element::OnUpdate(*this, other_);
+			return *this;
+		}
+		Element& operator*=(int value_) {
+			this->m_value *= value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator*=(const Element& other_) {
+			this->m_value *= other_.m_value;
+			Element::OnUpdate(*this, other_);
+			return *this;
+		}
+		Element& operator/=(int value_) {
+			this->m_value /= value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator/=(const Element& other_) {
+			this->m_value /= other_.m_value;
+			Element::OnUpdate(*this, other_);
+			return *this;
+		}
+		Element& operator%=(int value_) {
+			this->m_value %= value_;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		Element& operator%=(const Element& other_) {
+			this->m_value %= other_.m_value;
+			Element::OnUpdate(*this, other_);
+			return *this;
+		}
+
+		// 递增递减运算符
+		Element& operator++() {
+			++this->m_value;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		int operator++(int) {
+			int oldValue = this->m_value++;
+			Element::OnWrite(*this);
+			return oldValue;
+		}
+		Element& operator--() {
+			--this->m_value;
+			Element::OnWrite(*this);
+			return *this;
+		}
+		int operator--(int) {
+			int oldValue = this->m_value--;
+			Element::OnWrite(*this);
+			return oldValue;
+		}
+
+		// 算术运算符
+		int operator+(int value_) const {
+			Element::OnRead(*this);
+			return this->m_value + value_;
+		}
+		int operator-(int value_) const {
+			Element::OnRead(*this);
+			return this->m_value - value_;
+		}
+		int operator*(int value_) const {
+			Element::OnRead(*this);
+			return this->m_value * value_;
+		}
+		int operator/(int value_) const {
+			Element::OnRead(*this);
+			return this->m_value / value_;
+		}
+		int operator%(int value_) const {
+			Element::OnRead(*this);
+			return this->m_value % value_;
+		}
+		int operator+(const Element& other_) const {
+			Element::OnRead(*this, other_);
+			return this->m_value + other_.m_value;
+		}
+		int operator-(const Element& other_) const {
+			Element::OnRead(*this, other_);
+			return this->m_value - other_.m_value;
+		}
+		int operator*(const Element& other_) const {
+			Element::OnRead(*this, other_);
+			return this->m_value * other_.m_value;
+		}
+		int operator/(const Element& other_) const {
+			Element::OnRead(*this, other_);
+			return this->m_value / other_.m_value;
+		}
+		int operator%(const Element& other_) const {
+			Element::OnRead(*this, other_);
+			return this->m_value % other_.m_value;
+		}
+
+		friend void swap(Element& element1_, Element& element2_) {
+			std::swap(element1_.m_value, element2_.m_value);
+			Element::OnSwap(element1_, element2_, false);
+		}
+		friend void swap(Element& element_, int& value_) {
+			std::swap(element_.m_value, value_);
+			Element::OnSwap(element_);
+		}
+		friend void swap(int& value_, Element& element_) {
+			std::swap(value_, element_.m_value);
+			Element::OnSwap(element_);
+		}
+
+		// 交换但不改变颜色
+		friend void SwapWithoutSetColor(Element& element1_, Element& element2_) {
+			std::swap(element1_.m_value, element2_.m_value);
+			Element::OnSwap(element1_, element2_, true);
+		}
+
+	};
+
+	// int 版本没有颜色，与 swap 相同；这样排序算法可以对所有元素类型写同一句 SwapWithoutSetColor
+	inline void SwapWithoutSetColor(int& value1_, int& value2_) noexcept {
+		std::swap(value1_, value2_);
+	}
+
+	// 不插桩的策略只有声明：ElementOf<NonePolicy> 就是 int，int 版本的排序没有任何包装的开销
+	template<typename T>
+	class NonePolicy;
+
+	template<template<typename> class Policy>
+	struct ElementType {
+		using Type = Element<Policy>;
+	};
+
+	template<>
+	struct ElementType<NonePolicy> {
+		using Type = int;
+	};
+
+	template<template<typename> class Policy>
+	using ElementOf = typename ElementType<Policy>::Type;
+
+	static_assert(std::is_same_v<ElementOf<NonePolicy>, int>);
+
+	// 排序算法通过它区分元素类型，而不是逐个比较 Counter、Strip
+	template<typename T>
+	struct ElementTraits {
+		static constexpr bool IsDrawn = false; // 是否逐步绘制（演示用的数据量小、并行任务要切得更细）
+		static void AddSteps(size_t) noexcept {}
+		static void MarkAsArray(std::vector<T>&) noexcept {}
+	};
+
+	template<template<typename> class Policy>
+	struct ElementTraits<Element<Policy>> {
+		static constexpr bool IsDrawn = Policy<Element<Policy>>::IsDrawn;
+		// 不经过元素运算的步数（如睡眠排序的等待、珠排序的空转）
+		static void AddSteps(size_t step_num_) {
+			Policy<Element<Policy>>::AddSteps(step_num_);
+		}
+		// 缓冲区与原数组地位相同（如并行归并的缓冲区）
+		static void MarkAsArray(std::vector<Element<Policy>>& buffer_) {
+			Policy<Element<Policy>>::MarkAsArray(buffer_);
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "WideError.h"
+
+namespace NVisualSort {
+
+	// 内存中的 RGBA 画布（不依赖 Windows.h 与 EasyX），用于无界面渲染与导出
+	// 颜色参数与 COLORREF 相同（0x00BBGGRR），像素按 R、G、B、A 字节顺序存放，在小端机器上就是 COLORREF | 0xFF000000
+	// 与 EasyX 一样，矩形的左上右下四条边都包含在内
+	class FrameBuffer {
+
+	private:
+
+		int m_width = 0;
+		int m_height = 0;
+		uint32_t m_backgroundPixel = FrameBuffer::ToPixel(0);
+		std::vector<uint32_t> m_pixels;
+
+	public:
+
+		static constexpr uint32_t ToPixel(uint32_t color_) noexcept {
+			return (color_ & 0x00FFFFFF) | 0xFF000000;
+		}
+
+		static constexpr uint32_t ToColor(uint32_t pixel_) noexcept {
+			return pixel_ & 0x00FFFFFF;
+		}
+
+		FrameBuffer(int width_, int height_, uint32_t background_color_ = 0)
+			: m_width(width_), m_height(height_), m_backgroundPixel(FrameBuffer::ToPixel(background_color_)) {
+			if (width_ <= 0 || height_ <= 0) {
+				throw WideError(L"画布大小不正确！宽：" + std::to_wstring(width_) + L" 高：" + std::to_wstring(height_));
+			}
+			this->m_pixels.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), this->m_backgroundPixel);
+		}
+
+		int GetWidth() const noexcept {
+			return this->m_width;
+		}
+
+		int GetHeight() const noexcept {
+			return this->m_height;
+		}
+
+		// 按行存放的像素，每行 GetWidth() 个
+		const uint32_t* GetPixels() const noexcept {
+			return this->m_pixels.data();
+		}
+
+		uint32_t GetColor(int x_, int y_) const noexcept {
+			return FrameBuffer::ToColor(this->m_pixels[static_cast<size_t>(y_) * this->m_width + x_]);
+		}
+
+		uint32_t GetBackgroundColor() const noexcept {
+			return FrameBuffer::ToColor(this->m_backgroundPixel);
+		}
+
+		void SetBackgroundColor(uint32_t background_color_) noexcept {
+			this->m_backgroundPixel = FrameBuffer::ToPixel(background_color_);
+		}
+
+		// 用背景色清空整个画布
+		void Clear() noexcept {
+			std::fill(this->m_pixels.begin(), this->m_pixels.end(), this->m_backgroundPixel);
+		}
+
+		// 填充矩形（超出画布的部分被裁掉），逐行 fill_n，连续的 32 位像素会被编译器展开成向量存储
+		void SolidRectangle(int left_, int top_, int right_, int bottom_, uint32_t color_) noexcept {
+			this->FillPixels(left_, top_, right_, bottom_, FrameBuffer::ToPixel(color_));
+		}
+
+		// 用背景色填充矩形
+		void ClearRectangle(int left_, int top_, int right_, int bottom_) noexcept {
+			this->FillPixels(left_, top_, right_, bottom_, this->m_backgroundPixel);
+		}
+
+		// 把 source_ 整块拷贝到左上角 (left_, top_) 处（超出画布的部分被裁掉），用于把多块画布合成到一起
+		void CopyFrom(const FrameBuffer& source_, int left_, int top_) noexcept {
+			int beginX = (std::max)(left_, 0);
+			int beginY = (std::max)(top_, 0);
+			int endX = (std::min)(left_ + source_.m_width, this->m_width);
+			int endY = (std::min)(top_ + source_.m_height, this->m_height);
+			if (beginX >= endX || beginY >= endY) {
+				return;
+			}
+			for (int y = beginY; y < endY; ++y) {
+				const uint32_t* sourceRow = source_.m_pixels.data() + static_cast<size_t>(y - top_) * source_.m_width + (beginX - left_);
+				std::copy_n(sourceRow, endX - beginX, this->m_pixels.data() + static_cast<size_t>(y) * this->m_width + beginX);
+			}
+		}
+
+	private:
+
+		void FillPixels(int left_, int top_, int right_, int bottom_, uint32_t pixel_) noexcept {
+			left_ = (std::max)(left_, 0);
+			top_ = (std::max)(top_, 0);
+			right_ = (std::min)(right_, this->m_width - 1);
+			bottom_ = (std::min)(bottom_, this->m_height - 1);
+			if (left_ > right_ || top_ > bottom_) {
+				return;
+			}
+			size_t rowWidth = static_cast<size_t>(right_ - left_ + 1);
+			uint32_t* row = this->m_pixels.data() + static_cast<size_t>(top_) * this->m_width + left_;
+			for (int y = top_; y <= bottom_; ++y, row += this->m_width) {
+				std::fill_n(row, rowWidth, pixel_);
+			}
+		}
+
+	};
+
+}
\ No newline at end of file
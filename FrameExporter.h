@@ -0,0 +1,221 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FrameBuffer.h"
+#include "WideError.h"
+
+namespace NVisualSort {
+
+	enum class FrameFormat {
+		PpmSequence, // 每帧一个 PPM 图片：frame.ppm -> frame_000000.ppm、frame_000001.ppm ...
+		Y4m          // 一个未压缩的 YUV4MPEG2 视频流（4:4:4，BT.601 有限范围），可以直接交给 ffmpeg 等工具压缩
+	};
+
+	// 把 FrameBuffer 逐帧导出，格式由文件扩展名决定（.ppm 或 .y4m）
+	// 编码与写文件在单独的线程中进行，帧通过有界队列传递：队列满时 PushFrame 阻塞，渲染比编码快也不会无限制地占用内存
+	class FrameExporter {
+
+	private:
+
+		std::string m_path;
+		FrameFormat m_format = FrameFormat::Y4m;
+		int m_width = 0;
+		int m_height = 0;
+		size_t m_queueCapacity = 0;
+		size_t m_frameNum = 0; // 已提交的帧数
+
+		std::deque<std::vector<uint32_t>> m_queue; // 等待编码的帧
+		std::vector<std::vector<uint32_t>> m_freeFrames; // 编码完的帧缓冲，留给下一帧用
+		std::mutex m_mutex;
+		std::condition_variable m_queueCondition; // 队列有新帧、队列有空位、出错或结束时通知
+		bool m_finish = false;
+		std::exception_ptr m_error; // 编码线程中的异常，在 PushFrame 或 Finish 中重新抛出
+
+		std::ofstream m_stream; // Y4M 视频流
+		std::thread m_encoder;
+
+		static FrameFormat GetFormat(const std::string& path_) {
+			size_t dotIndex = path_.find_last_of('.');
+			std::string extension = dotIndex == std::string::npos ? std::string() : path_.substr(dotIndex);
+			if (extension == ".y4m") {
+				return FrameFormat::Y4m;
+			}
+			if (extension == ".ppm") {
+				return FrameFormat::PpmSequence;
+			}
+			throw WideError(L"不支持的导出格式（只支持 .ppm 与 .y4m）！");
+		}
+
+		std::string GetFramePath(size_t frame_index_) const {
+			std::string number = std::to_string(frame_index_);
+			number.insert(0, number.size() < 6 ? 6 - number.size() : 0, '0');
+			size_t dotIndex = this->m_path.find_last_of('.');
+			return this->m_path.substr(0, dotIndex) + "_" + number + this->m_path.substr(dotIndex);
+		}
+
+		void EncodeFrame(const std::vector<uint32_t>& frame_, size_t frame_index_, std::vector<uint8_t>& encoded_) {
+			size_t pixelNum = frame_.size();
+			if (this->m_format == FrameFormat::PpmSequence) {
+				encoded_.resize(pixelNum * 3);
+				for (size_t i = 0; i < pixelNum; ++i) {
+					encoded_[i * 3] = static_cast<uint8_t>(frame_[i]);
+					encoded_[i * 3 + 1] = static_cast<uint8_t>(frame_[i] >> 8);
+					encoded_[i * 3 + 2] = static_cast<uint8_t>(frame_[i] >> 16);
+				}
+				std::ofstream file(this->GetFramePath(frame_index_), std::ios::binary);
+				std::string header = "P6\n" + std::to_string(this->m_width) + " " + std::to_string(this->m_height) + "\n255\n";
+				file.write(header.data(), static_cast<std::streamsize>(header.size()));
+				file.write(reinterpret_cast<const char*>(encoded_.data()), static_cast<std::streamsize>(encoded_.size()));
+				if (!file) {
+					throw WideError(L"写入导出图片失败！");
+				}
+			}
+			else {
+				encoded_.resize(pixelNum * 3);
+				uint8_t* yPlane = encoded_.data();
+				uint8_t* uPlane = yPlane + pixelNum;
+				uint8_t* vPlane = uPlane + pixelNum;
+				for (size_t i = 0; i < pixelNum; ++i) {
+					int r = static_cast<int>(frame_[i] & 0xFF);
+					int g = static_cast<int>((frame_[i] >> 8) & 0xFF);
+					int b = static_cast<int>((frame_[i] >> 16) & 0xFF);
+					yPlane[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+					uPlane[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+					vPlane[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+				}
+				this->m_stream.write("FRAME\n", 6);
+				this->m_stream.write(reinterpret_cast<const char*>(encoded_.data()), static_cast<std::streamsize>(encoded_.size()));
+				if (!this->m_stream) {
+					throw WideError(L"写入导出视频失败！");
+				}
+			}
+		}
+
+		void EncoderLoop() {
+			try {
+				std::vector<uint8_t> encoded;
+				for (size_t frameIndex = 0;; ++frameIndex) {
+					std::vector<uint32_t> frame;
+					{
+						std::unique_lock<std::mutex> lock(this->m_mutex);
+						this->m_queueCondition.wait(lock, [this]() {
+							return !this->m_queue.empty() || this->m_finish;
+						});
+						if (this->m_queue.empty()) {
+							return;
+						}
+						frame = std::move(this->m_queue.front());
+						this->m_queue.pop_front();
+					}
+					this->m_queueCondition.notify_all();
+					this->EncodeFrame(frame, frameIndex, encoded);
+					std::lock_guard<std::mutex> lock(this->m_mutex);
+					this->m_freeFrames.push_back(std::move(frame));
+				}
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				this->m_error = std::current_exception();
+				this->m_queue.clear();
+				this->m_queueCondition.notify_all();
+			}
+		}
+
+	public:
+
+		static constexpr size_t DefaultQueueCapacity = 8;
+
+		FrameExporter(const std::string& path_, int width_, int height_, unsigned int fps_, size_t queue_capacity_ = FrameExporter::DefaultQueueCapacity)
+			: m_path(path_), m_format(FrameExporter::GetFormat(path_)), m_width(width_), m_height(height_),
+			m_queueCapacity(queue_capacity_ == 0 ? 1 : queue_capacity_) {
+			if (width_ <= 0 || height_ <= 0 || fps_ == 0) {
+				throw WideError(L"导出参数不正确！");
+			}
+			if (this->m_format == FrameFormat::Y4m) {
+				this->m_stream.open(path_, std::ios::binary);
+				std::string header = "YUV4MPEG2 W" + std::to_string(width_) + " H" + std::to_string(height_)
+					+ " F" + std::to_string(fps_) + ":1 Ip A1:1 C444\n";
+				this->m_stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+				if (!this->m_stream) {
+					throw WideError(L"无法创建导出视频文件！");
+				}
+			}
+			this->m_encoder = std::thread([this]() {
+				this->EncoderLoop();
+			});
+		}
+		FrameExporter(const FrameExporter&) = delete;
+		FrameExporter(FrameExporter&&) = delete;
+		FrameExporter& operator = (const FrameExporter&) = delete;
+		FrameExporter& operator = (FrameExporter&&) = delete;
+
+		~FrameExporter() {
+			if (this->m_encoder.joinable()) {
+				{
+					std::lock_guard<std::mutex> lock(this->m_mutex);
+					this->m_finish = true;
+				}
+				this->m_queueCondition.notify_all();
+				this->m_encoder.join();
+			}
+		}
+
+		size_t GetFrameNum() const noexcept {
+			return this->m_frameNum;
+		}
+
+		// 复制一帧放进队列，队列满时等待编码线程
+		void PushFrame(const FrameBuffer& frame_buffer_) {
+			if (frame_buffer_.GetWidth() != this->m_width || frame_buffer_.GetHeight() != this->m_height) {
+				throw WideError(L"导出帧的大小与导出器不一致！");
+			}
+			std::vector<uint32_t> frame;
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_queueCondition.wait(lock, [this]() {
+					return this->m_queue.size() < this->m_queueCapacity || this->m_error;
+				});
+				if (this->m_error) {
+					std::rethrow_exception(this->m_error);
+				}
+				if (!this->m_freeFrames.empty()) {
+					frame = std::move(this->m_freeFrames.back());
+					this->m_freeFrames.pop_back();
+				}
+			}
+			frame.assign(frame_buffer_.GetPixels(), frame_buffer_.GetPixels() + static_cast<size_t>(this->m_width) * this->m_height);
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				this->m_queue.push_back(std::move(frame));
+				++this->m_frameNum;
+			}
+			this->m_queueCondition.notify_all();
+		}
+
+		// 等待队列中的帧全部写完；编码线程出错时在这里抛出
+		void Finish() {
+			if (this->m_encoder.joinable()) {
+				{
+					std::lock_guard<std::mutex> lock(this->m_mutex);
+					this->m_finish = true;
+				}
+				this->m_queueCondition.notify_all();
+				this->m_encoder.join();
+				this->m_stream.close();
+			}
+			if (this->m_error) {
+				std::rethrow_exception(this->m_error);
+			}
+		}
+
+	};
+
+}
\ No newline at end of file
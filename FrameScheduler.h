@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace NVisualSort {
+
+	// 固定帧率调度器：每帧按演示速度算出本帧要执行的操作数（小数部分累计到下一帧），帧末睡到下一帧开始
+	// 绘制比帧率慢时不追赶，从当前时间重新计时，避免一次补上很多帧
+	class FrameScheduler {
+
+	private:
+
+		std::chrono::nanoseconds m_frameDuration;
+		std::chrono::steady_clock::time_point m_nextFrameTime;
+		double m_operationCredit = 0; // 上一帧没用完的小数操作数
+
+	public:
+
+		static constexpr unsigned int DefaultFps = 60;
+		static constexpr std::chrono::nanoseconds DefaultFrameDuration = std::chrono::nanoseconds(std::chrono::seconds(1)) / DefaultFps;
+
+		explicit FrameScheduler(unsigned int fps_ = FrameScheduler::DefaultFps)
+			: m_frameDuration(std::chrono::nanoseconds(std::chrono::seconds(1)) / (std::max)(fps_, 1u)),
+			m_nextFrameTime(std::chrono::steady_clock::now()) {}
+
+		std::chrono::nanoseconds GetFrameDuration() const noexcept {
+			return this->m_frameDuration;
+		}
+
+		// 本帧要执行的操作数，operations_per_millisecond_ 为每毫秒执行的操作数
+		size_t GetFrameOperationNum(double operations_per_millisecond_) noexcept {
+			this->m_operationCredit += operations_per_millisecond_ * std::chrono::duration<double, std::milli>(this->m_frameDuration).count();
+			size_t operationNum = static_cast<size_t>(this->m_operationCredit);
+			this->m_operationCredit -= static_cast<double>(operationNum);
+			return operationNum;
+		}
+
+		// 睡到下一帧开始
+		void WaitNextFrame() {
+			this->m_nextFrameTime += this->m_frameDuration;
+			auto now = std::chrono::steady_clock::now();
+			if (this->m_nextFrameTime < now) {
+				this->m_nextFrameTime = now;
+				return;
+			}
+			std::this_thread::sleep_until(this->m_nextFrameTime);
+		}
+
+		// 暂停之后调用，从当前时间重新计时
+		void Restart() noexcept {
+			this->m_nextFrameTime = std::chrono::steady_clock::now();
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "Element.h"
+#include "StripStyle.h"
+
+// 无界面模式（定义 VISUALSORT_HEADLESS）下代替 Strip.h，不依赖 Windows.h、EasyX 与 DrawingTool。
+// 排序算法里绘制相关的代码都在 if constexpr (ElementTraits<T>::IsDrawn) 分支中，int、Counter、Tracer 版本不会实例化它们，
+// 这里只提供这些分支用到的名字，让 Sort.h 能在 Linux 等平台上编译。
+
+using COLORREF = unsigned long;
+
+// 与 EasyX 的颜色定义保持一致
+#define BLACK			0
+#define BLUE			0xAA0000
+#define GREEN			0x00AA00
+#define CYAN			0xAAAA00
+#define RED				0x0000AA
+#define MAGENTA			0xAA00AA
+#define BROWN			0x0055AA
+#define LIGHTBLUE		0xFF5555
+#define LIGHTGREEN		0x55FF55
+#define LIGHTCYAN		0xFFFF55
+#define LIGHTRED		0x5555FF
+#define LIGHTMAGENTA	0xFF55FF
+#define YELLOW			0x55FFFF
+#define WHITE			0xFFFFFF
+
+namespace NVisualSort {
+
+	// 绘制策略只有声明：Strip 这个名字存在，但无界面模式下不能实例化任何 Strip 版本的排序
+	template<typename T>
+	class DrawPolicy;
+
+	using Strip = Element<DrawPolicy>;
+
+}
\ No newline at end of file
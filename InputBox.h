@@ -19,19 +19,19 @@ namespace NVisualSort {
 
 	private:
 
-		inline static constexpr Fraction MinWidth{ 1,2 }; // СΪȵ1/2
-		inline static constexpr Fraction MinHeight{ 1,2 }; // С߶Ϊ߶ȵ1/2
-		inline static constexpr Fraction MaxWidth{ 8,9 }; // Ϊȵ8/9
-		inline static constexpr Fraction MaxHeight{ 8,9 }; // ߶Ϊ߶ȵ8/9
-		inline static constexpr Fraction AspectRatio{ 1,2 }; // ߿Ϊ1:2
-
-		ButtonSequence m_buttons; // ť
-		Sketch m_mainBox;         // Ի
-		Sketch m_titleBox;        // 
-		Sketch m_contentBox;      // 
-		Sketch m_inputBox;        // 
-		std::wstring m_inputText; // ı
-		size_t m_maxNum = 99999;  // ֵ
+		inline static constexpr Fraction MinWidth{ 1,2 }; // 最小宽度为画布宽度的1/2
+		inline static constexpr Fraction MinHeight{ 1,2 }; // 最小高度为画布高度的1/2
+		inline static constexpr Fraction MaxWidth{ 8,9 }; // 最大宽度为画布宽度的8/9
+		inline static constexpr Fraction MaxHeight{ 8,9 }; // 最大高度为画布高度的8/9
+		inline static constexpr Fraction AspectRatio{ 1,2 }; // 高宽比为1:2
+
+		ButtonSequence m_buttons; // 按钮序列
+		Sketch m_mainBox;         // 主对话框
+		Sketch m_titleBox;        // 标题区域
+		Sketch m_contentBox;      // 内容区域
+		Sketch m_inputBox;        // 输入区域
+		std::wstring m_inputText; // 输入文本
+		size_t m_maxNum = 99999;  // 输入最大值限制
 
 		void ClampMainRect() {
 			using F = Fraction;
@@ -59,16 +59,16 @@ namespace NVisualSort {
 		}
 
 		void SetButtonsAuto() {
-			constexpr const wchar_t* buttonString[] = { L"1",L"2",L"3",L"4",L"5",L"6",L"7",L"8",L"9",L"ȷ",L"0",L"ɾ" };
+			constexpr const wchar_t* buttonString[] = { L"1",L"2",L"3",L"4",L"5",L"6",L"7",L"8",L"9",L"确认",L"0",L"删除" };
 			std::vector<Button> buttons(13);
 			using F = Fraction;
-			F leftMargin(7, 13); // ߾Ϊ dialog ڿȵ7/13
-			F bWidth(3, 26); // ťΪ dialog ڿȵ3/26
-			F horiGap(1, 26); // ťˮƽΪ dialog ڿȵ1/26
-			F topMargin(1, 13); // ϱ߾Ϊ dialog ڸ߶ȵ1/13
-			F bHeight(2, 13); // ť߶Ϊ dialog ڸ߶ȵ2/13
-			F vertGap(1, 13); // ťֱΪ dialog ڸ߶ȵ1/13
-			size_t horiCount = 3; // ÿаť
+			F leftMargin(7, 13); // 左边距为 dialog 窗口宽度的7/13
+			F bWidth(3, 26); // 按钮宽度为 dialog 窗口宽度的3/26
+			F horiGap(1, 26); // 按钮水平间距为 dialog 窗口宽度的1/26
+			F topMargin(1, 13); // 上边距为 dialog 窗口高度的1/13
+			F bHeight(2, 13); // 按钮高度为 dialog 窗口高度的2/13
+			F vertGap(1, 13); // 按钮垂直间距为 dialog 窗口高度的1/13
+			size_t horiCount = 3; // 每行按钮数量
 			for (size_t i = 0; i < 12; ++i) {
 				RECT tempRect = ComputeRect(this->m_mainBox.GetFrameRect(),
 					leftMargin + (bWidth + horiGap) * (i % horiCount),
@@ -77,7 +77,7 @@ namespace NVisualSort {
 					topMargin + (bHeight + vertGap) * (i / horiCount) + bHeight
 				);
 				buttons[i].SetButton(tempRect, buttonString[i]);
-				if (i != 9 && i != 11) { // ְť
+				if (i != 9 && i != 11) { // 数字按钮
 					buttons[i].SetReleaseFunc([this](Button& button_, ExMessage) {
 						if (this->m_inputBox.GetText() == L"0") {
 							this->m_inputBox.SetTextWithoutResize(button_.GetSketch().GetText());
@@ -188,7 +188,7 @@ namespace NVisualSort {
 
 		InputBox& SetExcutFunc(const std::function<void(Button&, ExMessage)>& execut_func_) {
 			if (this->m_buttons.GetButtonNum() != 13) {
-				throw WideError(L"InputBox δʼ");
+				throw WideError(L"InputBox 未初始化！");
 			}
 			if (execut_func_) {
 				this->m_buttons.GetButtons()[9].SetReleaseFunc([this, execut_func_](Button& button_, ExMessage) {
@@ -25,23 +25,23 @@ namespace NVisualSort {
 
 	private:
 
-		bool m_fullScreen = true; // Ƿȫʾ
-		std::shared_ptr<std::thread> m_getMessageThreadPtr; // (ȡϢ)ָ߳
+		bool m_fullScreen = true; // 是否全屏显示
+		std::shared_ptr<std::thread> m_getMessageThreadPtr; // (获取鼠标消息)的线程指针
 
 		MainMenu() {
 			DEVMODE devMode = {};
 			EnumDisplaySettings(nullptr, ENUM_CURRENT_SETTINGS, &devMode);
-			GetConfigManager().SetWidth(devMode.dmPelsWidth); // ôڿ
-			GetConfigManager().SetHeight(devMode.dmPelsHeight); // ôڸ߶
-			::initgraph(GetConfigManager().GetWidth(), GetConfigManager().GetHeight(), EX_NOCLOSE | EX_NOMINIMIZE); // 
+			GetConfigManager().SetWidth(devMode.dmPelsWidth); // 设置窗口宽度
+			GetConfigManager().SetHeight(devMode.dmPelsHeight); // 设置窗口高度
+			::initgraph(GetConfigManager().GetWidth(), GetConfigManager().GetHeight(), EX_NOCLOSE | EX_NOMINIMIZE); // 创建窗口
 			HWND hwnd = GetHWnd();
 			LONG_PTR style = GetWindowLongPtr(hwnd, GWL_STYLE);
 			style &= ~(WS_CAPTION | WS_THICKFRAME | WS_MINIMIZEBOX | WS_MAXIMIZEBOX | WS_SYSMENU);
-			SetWindowLongPtr(hwnd, GWL_STYLE, style); // Ӧôڷޱ߿ޱȵȣ
-			this->SetStyleAuto(); // ԶһЩ񣨱ֿݵȵȣ
-			::timeBeginPeriod(1); // ϵͳ߶ʱķֱ
-			this->m_getMessageThreadPtr = std::make_shared<std::thread>(ButtonSequence::GetMessageLoop); // ʼȡϢ
-			this->RunMainMenu(); // ˵
+			SetWindowLongPtr(hwnd, GWL_STYLE, style); // 应用窗口风格（无边框、无标题栏等等）
+			this->SetStyleAuto(); // 自动设置一些风格（比如文字抗锯齿等等）
+			::timeBeginPeriod(1); // 向系统请求提高定时器的分辨率
+			this->m_getMessageThreadPtr = std::make_shared<std::thread>(ButtonSequence::GetMessageLoop); // 开始获取鼠标消息
+			this->RunMainMenu(); // 进入主菜单
 		}
 
 		MainMenu(const MainMenu&) = delete;
@@ -57,7 +57,7 @@ namespace NVisualSort {
 
 		void FullScreen() const {
 			if (this->m_getMessageThreadPtr->joinable()) {
-				throw WideError(L"ȡϢ̴߳ڹ״ֱ̬Ӹı䴰ڴСᵼ");
+				throw WideError(L"获取鼠标消息的线程处于工作状态，直接改变窗口大小会导致死锁");
 			}
 			::EndBatchDraw();
 			::closegraph();
@@ -81,15 +81,16 @@ namespace NVisualSort {
 			logFont.lfQuality = ANTIALIASED_QUALITY;
 			::settextstyle(&logFont);
 			HWND hwnd = GetHWnd();
-			SetWindowText(hwnd, L"㿴һ");
+			SetWindowText(hwnd, L"你看，它们像柱子一样");
 			BeginBatchDraw();
 			GetDrawingTool().ClearDevice();
 			GetDrawingTool().FlushBatchDraw();
+			Strip::InvalidateLayout(); // 窗口大小可能改变了
 		}
 
 		void MaxWindow() const {
 			if (this->m_getMessageThreadPtr->joinable()) {
-				throw WideError(L"ȡϢ̴߳ڹ״ֱ̬Ӹı䴰ڴСᵼ");
+				throw WideError(L"获取鼠标消息的线程处于工作状态，直接改变窗口大小会导致死锁");
 			}
 			
 			GetConfigManager().SetDimensions(GetConfigManager().GetMaxWidth(), GetConfigManager().GetMaxClientHeight());
@@ -103,7 +104,7 @@ namespace NVisualSort {
 
 		void ResizeWindow() const {
 			if (this->m_getMessageThreadPtr->joinable()) {
-				throw WideError(L"ȡϢ̴߳ڹ״ֱ̬Ӹı䴰ڴСᵼ");
+				throw WideError(L"获取鼠标消息的线程处于工作状态，直接改变窗口大小会导致死锁");
 			}
 			::closegraph();
 			::initgraph(GetConfigManager().GetWidth(), GetConfigManager().GetHeight(), EX_NOCLOSE | EX_NOMINIMIZE);
@@ -111,22 +112,22 @@ namespace NVisualSort {
 		}
 		
 		void RunMainMenu() {
-			using F = Fraction; // ֤࣬ʱľ
+			using F = Fraction; // 分数类，保证整数除法时的精度
 			while (true) {
 				Sketch titleSketch(ComputeRect(GetConfigManager().GetCanvasRect(),
-					F(1, 8), F(1, 10), F(7, 8), F(3, 10)), L"ӻ"); // 
+					F(1, 8), F(1, 10), F(7, 8), F(3, 10)), L"排序可视化"); // 标题设置
 				titleSketch.SetHasFrame(false).SetHasBackground(false);
 				Sketch WuYou(ComputeRect(GetConfigManager().GetCanvasRect(),
-					F(281, 336), F(20, 21), F(1), F(1)), L"by yeah");
+					F(281, 336), F(20, 21), F(1), F(1)), L"by 无忧yeah");
 				WuYou.SetHasFrame(false).SetHasBackground(false).SetTextMode(DT_SINGLELINE | DT_BOTTOM | DT_RIGHT);
-				static ButtonSequence buttons(3); // ťʼá˳
-				constexpr F bWidth(3, 16); // ťռڿȵı
-				constexpr F bHegiht(3, 20); // ť߶ռڸ߶ȵı
-				constexpr F vertiGap(1, 20); // ťֱռڸ߶ȵı
-				constexpr F lMargin(13, 32); // һť봰ľռڿȵı
-				constexpr F tMargin(7, 20); // һť봰Ϸľռڸ߶ȵı
-				constexpr const wchar_t* texts[] = {L"ʼ",L"",L"˳"};
-				static std::optional<size_t> choice; // ѡĸť
+				static ButtonSequence buttons(3); // 三个按钮：开始、设置、退出
+				constexpr F bWidth(3, 16); // 按钮宽度占窗口宽度的比例
+				constexpr F bHegiht(3, 20); // 按钮高度占窗口高度的比例
+				constexpr F vertiGap(1, 20); // 按钮竖直间隔占窗口高度的比例
+				constexpr F lMargin(13, 32); // 第一个按钮离窗口左侧的距离占窗口宽度的比例
+				constexpr F tMargin(7, 20); // 第一个按钮离窗口上方的距离占窗口高度的比例
+				constexpr const wchar_t* texts[] = {L"开始",L"设置",L"退出"};
+				static std::optional<size_t> choice; // 选择了哪个按钮
 				choice = std::nullopt;
 				for (size_t i = 0; i < buttons.GetButtonNum(); ++i) {
 					buttons.GetButtons()[i].SetButton(ComputeRect(GetConfigManager().GetCanvasRect(),
@@ -136,45 +137,45 @@ namespace NVisualSort {
 							buttons.SetExitFlag(true);
 						}
 					);
-				} // ť
+				} // 设置三个按钮的属性
 				GetDrawingTool().ClearDevice();
 				titleSketch.DrawSketch(false);
 				WuYou.DrawSketch(false);
-				buttons.RunBlockButtonLoop(); // ʼť⣨ֱѡһť
+				buttons.RunBlockButtonLoop(); // 开始按钮检测（阻塞，直到选择了一个按钮）
 
 				if (!choice.has_value()) {
-					throw WideError(L"δѡκѡ");
+					throw WideError(L"未选择任何选项");
 				}
-				else if (choice.value() == 0) { // ѡ±Ϊ0İťʼť
+				else if (choice.value() == 0) { // 选择了下标为0的按钮（开始按钮）
 					this->RunVisualSortMenu();
 				}
-				else if (choice.value() == 1) { // ѡ±Ϊ1İťðť
+				else if (choice.value() == 1) { // 选择了下标为1的按钮（设置按钮）
 					this->RunSetMenu();
 				}
-				else if (choice.value() == 2) { // ѡ±Ϊ2İť˳ť
-					ButtonSequence::s_exitGetMessage.store(true, std::memory_order_release); // ˳־Ϊ
-					PostMessage(GetHWnd(), WM_MOUSEMOVE, 0, MAKELPARAM(100, 100)); // һϢûȡϢ߳һ˳־
+				else if (choice.value() == 2) { // 选择了下标为2的按钮（退出按钮）
+					ButtonSequence::s_exitGetMessage.store(true, std::memory_order_release); // 设置退出标志为真
+					PostMessage(GetHWnd(), WM_MOUSEMOVE, 0, MAKELPARAM(100, 100)); // 发送一个无意义的鼠标消息，让获取消息的线程醒来，并检测一次退出标志
 					if (this->m_getMessageThreadPtr->joinable()) {
-						this->m_getMessageThreadPtr->join(); // ̻߳ع
+						this->m_getMessageThreadPtr->join(); // 线程回归
 					}
 					else {
-						throw WideError(L"ȡϢ߳޷ع");
+						throw WideError(L"获取鼠标消息的线程无法回归");
 					}
 					return;
 				}
 				else {
-					throw WideError(L"δ֪ѡ");
+					throw WideError(L"未知选项");
 				}
 			}
 		}
 
 		void RunVisualSortMenu() const {
-			const static size_t sortNum = GetVisualSort().GetSorts().size(); // ܹм
-			const static size_t pageNum = sortNum / 21 + (sortNum % 21 != 0 ? 1 : 0); // мҳһҳ21
-			static size_t nowPage = 0; // һҳ
-			static ButtonSequence buttons; // ťǣذť棩һҳť
-			using F = Fraction; // 
-			static auto DrawPageInform = []() ->void { // غҳϢ 1 / 2 ҳ
+			const static size_t sortNum = GetVisualSort().GetSorts().size(); // 总共有几个排序
+			const static size_t pageNum = sortNum / 21 + (sortNum % 21 != 0 ? 1 : 0); // 有几页排序（一页最多21个）
+			static size_t nowPage = 0; // 现在是哪一页
+			static ButtonSequence buttons; // 按钮们，包括返回按钮（红叉叉）、上下一页、排序按钮
+			using F = Fraction; // 分数类
+			static auto DrawPageInform = []() ->void { // 本地函数，绘制页数信息（比如 1 / 2 页）
 				Sketch pageInform(ComputeRect(GetConfigManager().GetCanvasRect(),
 					F(51, 112), F(20, 21), F(61, 112), F(1)),
 					std::to_wstring(nowPage + 1) + L" / " + std::to_wstring(pageNum)
@@ -182,9 +183,9 @@ namespace NVisualSort {
 				pageInform.SetHasBackground(false).SetHasFrame(false).DrawSketch(false);
 			};
 			while (true) {
-				buttons.Clear(); // ðť
-				std::optional<size_t> choice = std::nullopt; // ѡĸť
-				int crossSize = (std::min)(GetConfigManager().GetWidth() / 38, GetConfigManager().GetHeight() / 24); // ĴС
+				buttons.Clear(); // 重置按钮们
+				std::optional<size_t> choice = std::nullopt; // 选择了哪个按钮
+				int crossSize = (std::min)(GetConfigManager().GetWidth() / 38, GetConfigManager().GetHeight() / 24); // 红叉叉的大小
 				buttons.AddButtonAsCross(Coordinate(GetConfigManager().GetWidth() - crossSize, crossSize), crossSize, [&choice](Button&) {choice = 0; });
 				constexpr F bWidth(433, 1500);
 				constexpr F bHeight(3, 28);
@@ -202,8 +203,8 @@ namespace NVisualSort {
 					), GetVisualSort().GetSorts()[sortIndex].GetSortName(), [sortIndex](Button&, ExMessage) {
 						InputBox inputBox;
 						inputBox.SetTitleText(GetVisualSort().GetSorts()[sortIndex].GetSortName());
-						inputBox.SetMaxNum(GetVisualSort().GetSorts()[sortIndex].GetMaxSize());
-						std::wstring contentText = L"ֵ" + std::to_wstring(GetVisualSort().GetSorts()[sortIndex].GetMaxSize());
+						inputBox.SetMaxNum(GetVisualSort().GetMaxSize(sortIndex));
+						std::wstring contentText = L"数值不超过" + std::to_wstring(GetVisualSort().GetMaxSize(sortIndex));
 						for (auto it = GetVisualSort().GetSorts()[sortIndex].GetNumRequires().begin();
 							it != GetVisualSort().GetSorts()[sortIndex].GetNumRequires().end(); ++it) {
 							contentText += L"\n" + it->GetRequireInform();
@@ -213,8 +214,8 @@ namespace NVisualSort {
 							size_t resultNum = inputBox.GetInputNum();
 							std::vector<std::wstring> errorMessages;
 							if (resultNum > 1) {
-								if (resultNum > GetVisualSort().GetSorts()[sortIndex].GetMaxSize()) {
-									errorMessages.emplace_back(L"ֵ");
+								if (resultNum > static_cast<size_t>(GetVisualSort().GetMaxSize(sortIndex))) {
+									errorMessages.emplace_back(L"数据量超过允许最大值");
 								}
 								for (size_t i = 0; i < GetVisualSort().GetSorts()[sortIndex].GetNumRequires().size(); ++i) {
 									if (!GetVisualSort().GetSorts()[sortIndex].GetNumRequires()[i].Check(resultNum)) {
@@ -246,7 +247,7 @@ namespace NVisualSort {
 				}
 				if (pageNum > 1) {
 					buttons.AddButton(ComputeRect(GetConfigManager().GetCanvasRect(),
-						F(41, 112), F(20, 21), F(51, 112), F(1)), L"һҳ", [&choice](Button& button_, ExMessage) {
+						F(41, 112), F(20, 21), F(51, 112), F(1)), L"上一页", [&choice](Button& button_, ExMessage) {
 							if(nowPage > 0) {
 								choice = 1;
 								buttons.SetExitFlag(true);
@@ -255,7 +256,7 @@ namespace NVisualSort {
 						}
 					);
 					buttons.AddButton(ComputeRect(GetConfigManager().GetCanvasRect(),
-						F(61, 112), F(20, 21), F(71, 112), F(1)), L"һҳ", [&choice](Button& button_, ExMessage) {
+						F(61, 112), F(20, 21), F(71, 112), F(1)), L"下一页", [&choice](Button& button_, ExMessage) {
 							if (nowPage + 1 < pageNum) {
 								choice = 2;
 								buttons.SetExitFlag(true);
@@ -265,13 +266,57 @@ namespace NVisualSort {
 					);
 				}
 
+				// 赛跑：默认的六个 O(n log n) 排序同时演示
+				buttons.AddButton(ComputeRect(GetConfigManager().GetCanvasRect(),
+					F(81, 112), F(20, 21), F(91, 112), F(1)), L"赛跑", [](Button&, ExMessage) {
+						InputBox inputBox;
+						inputBox.SetTitleText(L"赛跑");
+						inputBox.SetMaxNum(GetVisualSort().GetRaceMaxSize());
+						std::wstring contentText = L"数值不超过" + std::to_wstring(GetVisualSort().GetRaceMaxSize()) + L"\n";
+						for (const std::wstring& sortName : SortRace::GetDefaultSortNames()) {
+							contentText += (contentText.back() == L'\n' ? L"" : L"、") + sortName;
+						}
+						inputBox.SetContentText(contentText);
+						inputBox.SetExcutFunc([&inputBox](Button& button_, ExMessage) {
+							size_t resultNum = inputBox.GetInputNum();
+							std::vector<std::wstring> errorMessages;
+							if (resultNum > 1) {
+								if (resultNum > static_cast<size_t>(GetVisualSort().GetRaceMaxSize())) {
+									errorMessages.emplace_back(L"数据量超过允许最大值");
+								}
+								if (errorMessages.empty()) {
+									GetVisualSort().RunRace(resultNum);
+									inputBox.SetExitFlag(true);
+								}
+								else {
+									Dialog prompt(errorMessages);
+									prompt.RunBlockDialog();
+									GetDrawingTool().ClearDevice();
+									buttons.DrawButtons(false);
+									if (pageNum > 1) {
+										DrawPageInform();
+									}
+									inputBox.DrawInputBox();
+								}
+							}
+							Button::GetDefaultHoverDrawFunction()(button_, {});
+						});
+						inputBox.RunBlockInputLoop();
+						GetDrawingTool().ClearDevice();
+						if (pageNum > 1) {
+							DrawPageInform();
+						}
+						buttons.DrawButtons();
+					}
+				);
+
 				GetDrawingTool().ClearDevice();
 				if (pageNum > 1) {
 					DrawPageInform();
 				}
 				buttons.RunBlockButtonLoop();
 				if (!choice.has_value()) {
-					throw WideError(L"δѡκѡ");
+					throw WideError(L"未选择任何选项");
 				}
 				else if (choice.value() == 0) {
 					return;
@@ -287,7 +332,7 @@ namespace NVisualSort {
 					}
 				}
 				else {
-					throw WideError(L"δ֪ѡ");
+					throw WideError(L"未知选项");
 				}
 			}
 		}
@@ -295,6 +340,8 @@ namespace NVisualSort {
 		void RunSetMenu() {
 			static bool isShowShuffle = GetVisualSort().GetShowShuffle();
 			isShowShuffle = GetVisualSort().GetShowShuffle();
+			static bool isReplayMode = GetVisualSort().GetReplayMode();
+			isReplayMode = GetVisualSort().GetReplayMode();
 			static bool isFullScreen = this->m_fullScreen;
 			isFullScreen = this->m_fullScreen;
 			using F = Fraction;
@@ -308,21 +355,21 @@ namespace NVisualSort {
 				GetConfigManager().GetCenterX() + (mainWidth / 2),
 				GetConfigManager().GetCenterY() + (mainHeight / 2)
 			)).SetHasBackground(false);
-			static std::vector<Sketch> sketches(4);
+			static std::vector<Sketch> sketches(5);
 			constexpr F sWidth(6, 11);
-			constexpr F sHeight(1, 8);
+			constexpr F sHeight(1, 10);
 			constexpr F lMargin(1, 22);
-			constexpr F tMargin(1, 16);
-			constexpr F vertiGap(1, 16);
-			constexpr const wchar_t* sketchTexts[] = { L"ʾҹ",L"ȫʾ",L"ڿ",L"ڸ߶" };
-			for (size_t i = 0; i < 4; ++i) {
+			constexpr F tMargin(1, 20);
+			constexpr F vertiGap(1, 20);
+			constexpr const wchar_t* sketchTexts[] = { L"显示打乱过程",L"窗口全屏显示",L"调整窗口宽度",L"调整窗口高度",L"记录后回放" };
+			for (size_t i = 0; i < 5; ++i) {
 				sketches[i].SetSketch(ComputeRect(mainSketch.GetFrameRect(),
 					lMargin, tMargin + i * (sHeight + vertiGap),
 					lMargin + sWidth, tMargin + i * (sHeight + vertiGap) + sHeight),
 					sketchTexts[i]
 				).SetHasBackground(false).SetHasFrame(false);
 			}
-			static ButtonSequence buttons(6);
+			static ButtonSequence buttons(7);
 			static auto DrawSetMenuFunc = []() {
 				mainSketch.DrawSketch(false);
 				for (size_t i = 0; i < sketches.size(); ++i) {
@@ -331,10 +378,10 @@ namespace NVisualSort {
 				buttons.DrawButtons(false);
 			};
 			buttons.SetButtonAsSwitch(0, ComputeRect(mainSketch.GetFrameRect(),
-				F(15, 22), F(1, 16), F(21, 22), F(3, 16)), isShowShuffle
+				F(15, 22), F(1, 20), F(21, 22), F(3, 20)), isShowShuffle
 			);
 			buttons.SetButtonAsSwitch(1, ComputeRect(mainSketch.GetFrameRect(),
-				F(15, 22), F(1, 4), F(21, 22), F(3, 8)), isFullScreen, []() {
+				F(15, 22), F(1, 5), F(21, 22), F(3, 10)), isFullScreen, []() {
 					if (isFullScreen) {
 						buttons.GetButtons()[2].GetSketch().SetTextWithoutResize(std::to_wstring(static_cast<int>(GetConfigManager().GetMaxWidth())));
 						buttons.GetButtons()[3].GetSketch().SetTextWithoutResize(std::to_wstring(static_cast<int>(GetConfigManager().GetMaxHeight())));
@@ -349,13 +396,13 @@ namespace NVisualSort {
 			);
 
 			buttons.GetButtons()[2].SetButton(ComputeRect(mainSketch.GetFrameRect(),
-				F(15, 22), F(7, 16), F(21, 22), F(9, 16)),
+				F(15, 22), F(7, 20), F(21, 22), F(9, 20)),
 				std::to_wstring(static_cast<int>(GetConfigManager().GetWidth())), [](Button& button_, ExMessage) {
 					if (!isFullScreen) {
 						InputBox inputBox;
-						inputBox.SetTitleText(L"봰ڿ").
-							SetContentText(L"ֵ" + std::to_wstring(static_cast<int>(GetConfigManager().GetMaxWidth())) + L"\n" +
-							L"ֵС" + std::to_wstring(static_cast<int>(GetConfigManager().GetMinWidth()))).
+						inputBox.SetTitleText(L"输入窗口宽度").
+							SetContentText(L"数值不超过" + std::to_wstring(static_cast<int>(GetConfigManager().GetMaxWidth())) + L"\n" +
+							L"数值不小于" + std::to_wstring(static_cast<int>(GetConfigManager().GetMinWidth()))).
 							SetMaxNum(GetConfigManager().GetMaxWidth()).SetCrossFunc([]() {
 								GetDrawingTool().ClearDevice();
 								DrawSetMenuFunc();
@@ -364,11 +411,11 @@ namespace NVisualSort {
 							SetExcutFunc([&button_, &inputBox](Button&, ExMessage) {
 							size_t result = inputBox.GetInputNum();
 							if (result < static_cast<size_t>(GetConfigManager().GetMinWidth())) {
-								Dialog prompt(L"ֵС");
+								Dialog prompt(L"数值过小");
 								prompt.RunBlockDialog();
 							}
 							else if (result > static_cast<size_t>(GetConfigManager().GetMaxWidth())) {
-								Dialog prompt(L"ֵ");
+								Dialog prompt(L"数值过大");
 								prompt.RunBlockDialog();
 							}
 							else {
@@ -385,7 +432,7 @@ namespace NVisualSort {
 						inputBox.RunBlockInputLoop();
 					}
 					else {
-						Dialog prompt(L"ȫ״̬£޸Ĵڿ");
+						Dialog prompt(L"全屏状态下，不能修改窗口宽度");
 						prompt.RunBlockDialog();
 						GetDrawingTool().ClearDevice();
 						DrawSetMenuFunc();
@@ -395,13 +442,13 @@ namespace NVisualSort {
 			).GetSketch().SetTextMode(DT_LEFT).SetFrameRoundSize(0);
 
 			buttons.GetButtons()[3].SetButton(ComputeRect(mainSketch.GetFrameRect(),
-				F(15, 22), F(5, 8), F(21, 22), F(3, 4)),
+				F(15, 22), F(1, 2), F(21, 22), F(3, 5)),
 				std::to_wstring(static_cast<int>(GetConfigManager().GetHeight())), [](Button& button_, ExMessage) {
 					if (!isFullScreen) {
 						InputBox inputBox;
-						inputBox.SetTitleText(L"봰ڸ߶").
-							SetContentText(L"ֵ" + std::to_wstring(static_cast<int>(GetConfigManager().GetMaxClientHeight())) + L"\n" +
-								L"ֵС" + std::to_wstring(static_cast<int>(GetConfigManager().GetMinHeight()))).
+						inputBox.SetTitleText(L"输入窗口高度").
+							SetContentText(L"数值不超过" + std::to_wstring(static_cast<int>(GetConfigManager().GetMaxClientHeight())) + L"\n" +
+								L"数值不小于" + std::to_wstring(static_cast<int>(GetConfigManager().GetMinHeight()))).
 							SetMaxNum(GetConfigManager().GetMaxClientHeight()).SetCrossFunc([]() {
 								GetDrawingTool().ClearDevice();
 								DrawSetMenuFunc();
@@ -410,11 +457,11 @@ namespace NVisualSort {
 							SetExcutFunc([&button_, &inputBox](Button&, ExMessage) {
 							size_t result = inputBox.GetInputNum();
 							if (result < static_cast<size_t>(GetConfigManager().GetMinHeight())) {
-								Dialog prompt(L"ֵС");
+								Dialog prompt(L"数值过小");
 								prompt.RunBlockDialog();
 							}
 							else if (result > static_cast<size_t>(GetConfigManager().GetMaxHeight())) {
-								Dialog prompt(L"ֵ");
+								Dialog prompt(L"数值过大");
 								prompt.RunBlockDialog();
 							}
 							else {
@@ -431,7 +478,7 @@ namespace NVisualSort {
 						inputBox.RunBlockInputLoop();
 					}
 					else {
-						Dialog prompt(L"ȫ״̬£޸Ĵڸ߶");
+						Dialog prompt(L"全屏状态下，不能修改窗口高度");
 						prompt.RunBlockDialog();
 						GetDrawingTool().ClearDevice();
 						DrawSetMenuFunc();
@@ -440,16 +487,20 @@ namespace NVisualSort {
 				}
 			).GetSketch().SetTextMode(DT_LEFT).SetFrameRoundSize(0);
 
+			buttons.SetButtonAsSwitch(6, ComputeRect(mainSketch.GetFrameRect(),
+				F(15, 22), F(13, 20), F(21, 22), F(3, 4)), isReplayMode
+			);
+
 			static std::optional<bool> confirm = std::nullopt;
 			confirm = std::nullopt;
 			buttons.GetButtons()[4].SetButton(ComputeRect(mainSketch.GetFrameRect(),
-				F(2, 11), F(13, 16), F(4, 11), F(15, 16)), L"ȷ", [](Button&, ExMessage) {
+				F(2, 11), F(13, 16), F(4, 11), F(15, 16)), L"确认", [](Button&, ExMessage) {
 					confirm = true;
 					buttons.SetExitFlag(true);
 				}
 			).GetSketch().SetFrameRoundSize(5);
 			buttons.GetButtons()[5].SetButton(ComputeRect(mainSketch.GetFrameRect(),
-				F(7, 11), F(13, 16), F(9, 11), F(15, 16)), L"ȡ", [](Button&, ExMessage) {
+				F(7, 11), F(13, 16), F(9, 11), F(15, 16)), L"取消", [](Button&, ExMessage) {
 					confirm = false;
 					buttons.SetExitFlag(true);
 				}
@@ -465,14 +516,15 @@ namespace NVisualSort {
 				this->m_getMessageThreadPtr->join();
 			}
 			else {
-				throw WideError(L"ȡϢ߳޷ع");
+				throw WideError(L"获取鼠标消息的线程无法回归");
 			}
 
 			if (!confirm.has_value()) {
-				throw WideError(L"δ֪ѡ");
+				throw WideError(L"未知的选项！");
 			}
 			else if (confirm.value()) {
 				GetVisualSort().SetShowShuffle(isShowShuffle);
+				GetVisualSort().SetReplayMode(isReplayMode);
 				if (isFullScreen) {
 					if (!this->m_fullScreen) {
 						this->m_fullScreen = true;
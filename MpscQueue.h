@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace NVisualSort {
+
+	// 有界无锁队列：多个线程放入，只有一个线程取出（环形数组，每个槽位带序号，见 Dmitry Vyukov 的有界 MPMC 队列）
+	// 同一个线程放入的元素按放入顺序取出；放入方只在争抢同一个槽位时重试，不会因取出方而阻塞
+	template<typename T>
+	class MpscQueue {
+
+	private:
+
+		static constexpr size_t CacheLineSize = 64;
+
+		struct Cell {
+			std::atomic<size_t> sequence{0}; // 等于下标时可以放入，等于下标 + 1 时可以取出
+			T value{};
+		};
+
+		std::unique_ptr<Cell[]> m_cells;
+		size_t m_mask = 0;
+		alignas(CacheLineSize) std::atomic<size_t> m_tail{0}; // 下一个放入的位置
+		alignas(CacheLineSize) size_t m_head = 0;              // 下一个取出的位置（只有取出方访问）
+
+	public:
+
+		// 容量向上取到 2 的整数次幂
+		explicit MpscQueue(size_t capacity_) {
+			size_t capacity = 2;
+			while (capacity < capacity_) {
+				capacity <<= 1;
+			}
+			this->m_cells = std::make_unique<Cell[]>(capacity);
+			this->m_mask = capacity - 1;
+			for (size_t i = 0; i < capacity; ++i) {
+				this->m_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		size_t GetCapacity() const noexcept {
+			return this->m_mask + 1;
+		}
+
+		// 队列满时返回 false
+		bool TryPush(const T& value_) noexcept {
+			size_t position = this->m_tail.load(std::memory_order_relaxed);
+			Cell* cell = nullptr;
+			while (true) {
+				cell = &this->m_cells[position & this->m_mask];
+				size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+				if (difference == 0) {
+					if (this->m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				}
+				else if (difference < 0) {
+					return false;
+				}
+				else {
+					position = this->m_tail.load(std::memory_order_relaxed);
+				}
+			}
+			cell->value = value_;
+			cell->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// 队列满时让出时间片等待取出方
+		void Push(const T& value_) noexcept {
+			while (!this->TryPush(value_)) {
+				std::this_thread::yield();
+			}
+		}
+
+		// 只能在取出线程中调用：没有可以取出的元素（队列空或下一个元素还没写完）
+		bool GetIsEmpty() const noexcept {
+			return this->m_cells[this->m_head & this->m_mask].sequence.load(std::memory_order_acquire) != this->m_head + 1;
+		}
+
+		// 只能在取出线程中调用，队列空（或下一个元素还没写完）时返回 false
+		bool TryPop(T& value_) noexcept {
+			Cell& cell = this->m_cells[this->m_head & this->m_mask];
+			if (cell.sequence.load(std::memory_order_acquire) != this->m_head + 1) {
+				return false;
+			}
+			value_ = cell.value;
+			cell.sequence.store(this->m_head + this->m_mask + 1, std::memory_order_release);
+			++this->m_head;
+			return true;
+		}
+
+	};
+
+}
\ No newline at end of file
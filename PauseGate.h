@@ -0,0 +1,141 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+
+namespace NVisualSort {
+
+	// 暂停闸门：暂停时所有排序线程阻塞在同一个条件变量上，继续、取消或打断时一次全部唤醒，不再每 10 毫秒轮询
+	// 三个状态都在锁内修改（保证不会漏掉通知），但也是原子变量，没有暂停时 GetIsBlocking 只是一次原子读取
+	class PauseGate {
+
+	private:
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::atomic<bool> m_isPaused = false;
+		std::atomic<bool> m_isCancelled = false;
+		std::atomic<bool> m_isInterrupted = false; // 打断当前的暂停（回放模式下拖动时间轴后需要立即跳转），由等待方清除
+		std::stop_source m_stopSource; // 取消时请求停止，排序算法通过 GetStopToken 得到的令牌在检查点返回
+
+		template<typename Func>
+		void SetState(Func&& func_) {
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				func_();
+			}
+			this->m_condition.notify_all();
+		}
+
+		bool GetIsOpen() const noexcept {
+			return !this->m_isPaused.load(std::memory_order_acquire)
+				|| this->m_isInterrupted.load(std::memory_order_acquire)
+				|| this->m_isCancelled.load(std::memory_order_acquire);
+		}
+
+	public:
+
+		PauseGate() noexcept = default;
+		PauseGate(const PauseGate&) = delete;
+		PauseGate& operator=(const PauseGate&) = delete;
+
+		// 开始新的排序时调用
+		void Reset() {
+			this->SetState([this]() {
+				this->m_isPaused.store(false, std::memory_order_release);
+				this->m_isCancelled.store(false, std::memory_order_release);
+				this->m_isInterrupted.store(false, std::memory_order_release);
+				this->m_stopSource = std::stop_source();
+			});
+		}
+
+		void Pause() {
+			this->SetState([this]() {
+				this->m_isPaused.store(true, std::memory_order_release);
+			});
+		}
+
+		void Resume() {
+			this->SetState([this]() {
+				this->m_isPaused.store(false, std::memory_order_release);
+			});
+		}
+
+		bool GetIsPaused() const noexcept {
+			return this->m_isPaused.load(std::memory_order_acquire);
+		}
+
+		// 取消排序：唤醒所有等待的线程，由它们自己决定是否退出
+		void Cancel() {
+			this->SetState([this]() {
+				this->m_isCancelled.store(true, std::memory_order_release);
+				this->m_stopSource.request_stop();
+			});
+		}
+
+		bool GetIsCancelled() const noexcept {
+			return this->m_isCancelled.load(std::memory_order_acquire);
+		}
+
+		// 本次排序的停止令牌，Reset 之后要重新获取
+		std::stop_token GetStopToken() {
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			return this->m_stopSource.get_token();
+		}
+
+		void Interrupt() {
+			this->SetState([this]() {
+				this->m_isInterrupted.store(true, std::memory_order_release);
+			});
+		}
+
+		void ClearInterrupt() noexcept {
+			this->m_isInterrupted.store(false, std::memory_order_release);
+		}
+
+		// 暂停中（且没有被打断）时，Wait 会阻塞
+		bool GetIsBlocking() const noexcept {
+			return !this->GetIsOpen();
+		}
+
+		// 暂停中阻塞，直到继续、取消或打断；返回阻塞的时长
+		std::chrono::steady_clock::duration Wait() {
+			if (this->GetIsOpen()) {
+				return std::chrono::steady_clock::duration::zero();
+			}
+			auto beginTime = std::chrono::steady_clock::now();
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_condition.wait(lock, [this]() {
+				return this->GetIsOpen();
+			});
+			return std::chrono::steady_clock::now() - beginTime;
+		}
+
+		// 等待 duration_，暂停的时间不计入；被取消时立即返回 false
+		bool WaitFor(std::chrono::steady_clock::duration duration_) {
+			auto endTime = std::chrono::steady_clock::now() + duration_;
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			while (true) {
+				if (this->m_condition.wait_until(lock, endTime, [this]() {
+					return this->GetIsCancelled() || this->GetIsPaused();
+				})) {
+					if (this->GetIsCancelled()) {
+						return false;
+					}
+					auto pauseBeginTime = std::chrono::steady_clock::now();
+					this->m_condition.wait(lock, [this]() {
+						return this->GetIsCancelled() || !this->GetIsPaused();
+					});
+					endTime += std::chrono::steady_clock::now() - pauseBeginTime;
+				}
+				else {
+					return true;
+				}
+			}
+		}
+
+	};
+
+}
\ No newline at end of file
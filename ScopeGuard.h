@@ -29,7 +29,7 @@ namespace NVisualSort {
 
 		ScopeGuard& operator=(ScopeGuard&& other_) noexcept {
 			if (this != &other_) {
-				// ִеǰ
+				// 首先执行当前对象的清理函数
 				if (this->m_active) {
 					this->ExecuteNow();
 				}
@@ -40,18 +40,18 @@ namespace NVisualSort {
 			return *this;
 		}
 
-		// ֹظ
+		// 禁止拷贝（避免重复清理）
 		ScopeGuard(const ScopeGuard&) = delete;
 		ScopeGuard& operator=(const ScopeGuard&) = delete;
 
-		//  - Զִ
+		// 析构函数 - 自动执行清理
 		~ScopeGuard() noexcept {
 			if (this->m_active) {
 				ExecuteNow();
 			}
 		}
 
-		// ͷӵִ - LIFO
+		// 添加清理函数到队列头部（最后添加的首先执行 - LIFO）
 		template<typename Func>
 		ScopeGuard& AddFront(Func&& func_) {
 			if (this->m_active) {
@@ -60,7 +60,7 @@ namespace NVisualSort {
 			return *this;
 		}
 
-		// β˳ִ - FIFO
+		// 添加清理函数到队列尾部（按添加顺序执行 - FIFO）
 		template<typename Func>
 		ScopeGuard& AddBack(Func&& func_) {
 			if (this->m_active) {
@@ -69,19 +69,19 @@ namespace NVisualSort {
 			return *this;
 		}
 
-		// Ĭӵβ
+		// 添加清理函数（默认添加到尾部）
 		template<typename Func>
 		ScopeGuard& operator+=(Func&& func_) {
 			return AddBack(std::forward<Func>(func_));
 		}
 
-		// ãʽã
+		// 添加清理函数并返回自身的引用（链式调用）
 		template<typename Func>
 		ScopeGuard& Add(Func&& func_) {
 			return AddBack(std::forward<Func>(func_));
 		}
 
-		// ִǷactive
+		// 立即执行所有清理函数（无论是否active）
 		void ExecuteNow() noexcept {
 			while (!this->m_cleanupFunctions.empty()) {
 				try {
@@ -91,41 +91,41 @@ namespace NVisualSort {
 					}
 				}
 				catch (...) {
-					// е쳣ֹ쳣
+					// 忽略清理函数中的异常，防止异常传播
 				}
 				this->m_cleanupFunctions.pop_back();
 			}
 		}
 
-		// ȡScopeGuardʱִ
+		// 取消ScopeGuard（析构时不执行清理）
 		void Dismiss() noexcept {
 			this->m_active = false;
 			this->m_cleanupFunctions.clear();
 		}
 
-		// ¼ScopeGuard֮ǰȡ
+		// 重新激活ScopeGuard（如果之前被取消）
 		void Reactivate() noexcept {
 			this->m_active = true;
 		}
 
-		// Ƿڻ״̬
+		// 检查是否处于活动状态
 		bool IsActive() const noexcept {
 			return this->m_active;
 		}
 
-		// ȡǰִе
+		// 获取当前待执行的清理函数数量
 		size_t Size() const noexcept {
 			return this->m_cleanupFunctions.size();
 		}
 
-		// ǷΪ
+		// 检查是否为空
 		bool Empty() const noexcept {
 			return this->m_cleanupFunctions.empty();
 		}
 
-		// ScopeGuardһ
+		// 创建ScopeGuard并立即添加一个清理函数（工厂函数）
 		template<typename Func>
-		[[nodiscard("Create ķֵӦñԣУ")]] static ScopeGuard Create(Func&& func_) {
+		[[nodiscard("Create 的返回值不应该被忽略，否则清理会立即进行！")]] static ScopeGuard Create(Func&& func_) {
 			ScopeGuard guard;
 			guard.AddBack(std::forward<Func>(func_));
 			return guard;
@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace NVisualSort {
+
+	// 分片计数器：每个线程只累加自己的分片，各分片独占一条缓存行，多线程排序时不会争抢同一条缓存行
+	// 读取时才把所有分片加起来；没有线程在累加时，读到的值是精确的
+	class ShardedCounter {
+
+	private:
+
+		static constexpr size_t ShardNum = 64; // 线程数超过它时，多个线程共用一个分片（仍然精确，只是会有争抢）
+		static constexpr size_t CacheLineSize = 64;
+
+		struct alignas(CacheLineSize) Shard {
+			std::atomic<size_t> value{0};
+		};
+
+		std::array<Shard, ShardNum> m_shards;
+
+		inline static std::atomic<size_t> s_nextShardIndex = 0;
+
+		// 每个线程第一次计数时轮流分到一个分片，之后一直使用它
+		static size_t GetShardIndex() noexcept {
+			thread_local size_t shardIndex = ShardedCounter::s_nextShardIndex.fetch_add(1, std::memory_order_relaxed) % ShardNum;
+			return shardIndex;
+		}
+
+	public:
+
+		constexpr ShardedCounter() noexcept = default;
+		ShardedCounter(const ShardedCounter&) = delete;
+		ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+		void Add(size_t value_) noexcept {
+			this->m_shards[ShardedCounter::GetShardIndex()].value.fetch_add(value_, std::memory_order_relaxed);
+		}
+
+		// 所有分片之和
+		size_t Load() const noexcept {
+			size_t total = 0;
+			for (const Shard& shard : this->m_shards) {
+				total += shard.value.load(std::memory_order_relaxed);
+			}
+			return total;
+		}
+
+		// 重置为 value_，只能在没有线程累加时调用
+		void Store(size_t value_) noexcept {
+			for (Shard& shard : this->m_shards) {
+				shard.value.store(0, std::memory_order_relaxed);
+			}
+			this->m_shards[0].value.store(value_, std::memory_order_release);
+		}
+
+		// 以下与 std::atomic<size_t> 的用法保持一致，原来的 ++、+=、= 与读取都不用改
+		size_t load(std::memory_order = std::memory_order_seq_cst) const noexcept {
+			return this->Load();
+		}
+		void store(size_t value_, std::memory_order = std::memory_order_seq_cst) noexcept {
+			this->Store(value_);
+		}
+		ShardedCounter& operator++() noexcept {
+			this->Add(1);
+			return *this;
+		}
+		ShardedCounter& operator+=(size_t value_) noexcept {
+			this->Add(value_);
+			return *this;
+		}
+		ShardedCounter& operator=(size_t value_) noexcept {
+			this->Store(value_);
+			return *this;
+		}
+		operator size_t() const noexcept {
+			return this->Load();
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -17,36 +17,36 @@ namespace NVisualSort {
 
 	private:
 
-		// ӻƺSketch&ΪҪSketchָ룬ƶָգ
+		// 附加绘制函数，Sketch&参数为自身（不要捕获自身Sketch指针，避免移动后的悬空指针风险！）
 		std::function<void(Sketch&)> m_additionalDrawFunction;
-		std::wstring m_text;                                          // ı
-		std::wstring m_typeface = DefaultTypeface;                    // ı
-		RECT m_frameRect = {};                                        // ߿
-		RECT m_textRect = {};                                         // ı
-		int m_frameThick = 2;                                         // ߿ߴϸ
-		int m_frameStyle = PS_SOLID;                                  // ߿ʽĬΪʵߣ
-		COLORREF m_frameColor = WHITE;                                // ߿ɫĬΪɫ
-		int m_frameRoundSize = 10;                                    // ߿ԲǴС
-		COLORREF m_backgroundColor = DefaultCanvasColor;              // ɫĬΪĬϻɫ
-		int m_textSize = 0;                                           // ıС
-		COLORREF m_textColor = WHITE;                                 // ıɫ
-		UINT m_textMode = DT_SINGLELINE | DT_VCENTER | DT_CENTER;     // ıƸʽĬΪֹСˮƽֱУ
-		bool m_hasFrame = true;                                       // Ƿڱ߿
-		bool m_hasBackground = true;                                  // Ƿڱ
-
-		// 淶꣬ȷ<ң<
+		std::wstring m_text;                                          // 文本内容
+		std::wstring m_typeface = DefaultTypeface;                    // 文本字体
+		RECT m_frameRect = {};                                        // 边框矩形区域
+		RECT m_textRect = {};                                         // 文本矩形区域
+		int m_frameThick = 2;                                         // 边框线粗细
+		int m_frameStyle = PS_SOLID;                                  // 边框线样式（默认为实线）
+		COLORREF m_frameColor = WHITE;                                // 边框颜色（默认为白色）
+		int m_frameRoundSize = 10;                                    // 边框圆角大小
+		COLORREF m_backgroundColor = DefaultCanvasColor;              // 背景颜色（默认为默认画布颜色）
+		int m_textSize = 0;                                           // 文本大小
+		COLORREF m_textColor = WHITE;                                 // 文本颜色
+		UINT m_textMode = DT_SINGLELINE | DT_VCENTER | DT_CENTER;     // 文本绘制格式（默认为禁止换行、水平居中与竖直居中）
+		bool m_hasFrame = true;                                       // 是否存在边框
+		bool m_hasBackground = true;                                  // 是否存在背景
+
+		// 规范化坐标，确保左<右，上<下
 		constexpr void NormalizeCoordinates() noexcept {
 			if (this->m_frameRect.left > this->m_frameRect.right) std::swap(this->m_frameRect.left, this->m_frameRect.right);
 			if (this->m_frameRect.top > this->m_frameRect.bottom) std::swap(this->m_frameRect.top, this->m_frameRect.bottom);
 		}
 
-		// ԶııСڱ߿
+		// 自动设置文本区域（文本区域略小于边框区域）
 		void SetTextRectAuto() {
 			this->NormalizeCoordinates();
 
 			int width = this->m_frameRect.right - this->m_frameRect.left;
 			int height = this->m_frameRect.bottom - this->m_frameRect.top;
-			int margin = (std::min)(width, height) / 20; // ʹԱ߾
+			int margin = (std::min)(width, height) / 20; // 使用相对边距
 
 			this->m_textRect = {
 				this->m_frameRect.left + margin,
@@ -58,19 +58,19 @@ namespace NVisualSort {
 			this->SetTextSizeAuto();
 		}
 
-		// ԶúıС
+		// 自动设置合适文本大小
 		void SetTextSizeAuto() {
 
 			int textWidth = this->m_textRect.right - this->m_textRect.left;
 			int textHeight = this->m_textRect.bottom - this->m_textRect.top;
 
 			if (!this->m_text.empty() && (textWidth <= 0 || textHeight <= 0)) {
-				throw WideError(L"Sketch ıЧıΪ" + (this->m_text.empty() ? L"<>" : this->m_text));
+				throw WideError(L"Sketch 的文本矩形区域无效！文本内容为：" + (this->m_text.empty() ? L"<空>" : this->m_text));
 			}
 
 			GetDrawingTool().ExecuteWithLock([this, textWidth, textHeight]() {
 
-				// ʹöֲȷС
+				// 使用二分查找确定最佳字体大小
 				int lowSize = 1;
 				int highSize = textHeight;
 				int bestSize = 1;
@@ -79,7 +79,7 @@ namespace NVisualSort {
 					int middleSize = (lowSize + highSize) / 2;
 					::settextstyle(middleSize, 0, this->m_typeface.c_str());
 					int currentWidth = ::textwidth(this->m_text.c_str());
-					int currentHeight = ::textheight(L"Hg"); // ʹðַ
+					int currentHeight = ::textheight(L"Hg"); // 使用包含上下延伸的字符
 
 					if (currentWidth <= textWidth && currentHeight <= textHeight) {
 						bestSize = middleSize;
@@ -233,7 +233,7 @@ namespace NVisualSort {
 
 		Sketch& SetTextRectWithoutResize(RECT text_rect_) noexcept {
 			this->m_textRect = text_rect_;
-			// ȷıڱ߿
+			// 确保文本矩形在边框矩形内
 			this->m_textRect.left = (std::max)(this->m_textRect.left, this->m_frameRect.left);
 			this->m_textRect.top = (std::max)(this->m_textRect.top, this->m_frameRect.top);
 			this->m_textRect.right = (std::min)(this->m_textRect.right, this->m_frameRect.right);
@@ -339,7 +339,7 @@ namespace NVisualSort {
 		}
 
 		void DrawSketch(bool is_flush_ = true) {
-			// Ʊ
+			// 绘制背景
 			if (this->m_hasBackground) {
 				if (this->m_hasFrame) {
 					GetDrawingTool().FillRoundRect(
@@ -362,7 +362,7 @@ namespace NVisualSort {
 				);
 			}
 
-			// ı
+			// 绘制文本
 			if (!this->m_text.empty()) {
 				GetDrawingTool().DrawText_(
 					this->m_text, this->m_textRect, this->m_textSize,
@@ -370,12 +370,12 @@ namespace NVisualSort {
 				);
 			}
 
-			// ִжĻƺ
+			// 执行额外的绘制函数
 			if (this->m_additionalDrawFunction) {
 				this->m_additionalDrawFunction(*this);
 			}
 
-			// Ҫˢ
+			// 如果需要刷新
 			if (is_flush_) {
 				this->Flush();
 			}
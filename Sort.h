@@ -1,16 +1,26 @@
 #pragma once
+#ifdef VISUALSORT_HEADLESS
+#include "Headless.h"
+#else
 #include "Strip.h"
 #include "ConfigManager.h"
-#include "Counter.h"
-#include <future>
-#include <execution>
 #include <Windows.h>
 #include <easyx.h>
+#endif
+#include "Counter.h"
+#include "Tracer.h"
+#include "SortSteps.h"
+#include "ThreadPool.h"
+#include <future>
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <latch>
 #include <list>
 #include <mutex>
 #include <random>
@@ -38,17 +48,17 @@
 
 namespace NVisualSort {
 
-	// Լ
+	// 对数据量的约束
 	class NumRequire {
 
 	private:
 
-		std::wstring m_requireInform; // ԼϢ
-		std::function<bool(size_t)> m_checkFunc; // У麯Уʧܷfalse
+		std::wstring m_requireInform; // 约束信息
+		std::function<bool(size_t)> m_checkFunc; // 校验函数（校验失败返回false）
 
 	public:
 
-		NumRequire() : m_requireInform(L"Լ"), m_checkFunc([](size_t) { return true; }) {}
+		NumRequire() : m_requireInform(L"无约束"), m_checkFunc([](size_t) { return true; }) {}
 		NumRequire(std::wstring inform, std::function<bool(size_t)> checkFunc)
 			: m_requireInform(std::move(inform)), m_checkFunc(std::move(checkFunc)) {
 		}
@@ -79,26 +89,31 @@ namespace NVisualSort {
 
 	private:
 
-		std::wstring m_sortName; // 
-		int m_maxSize = 0; // 
-		std::function<void(std::vector<int>&)> m_intSortFunc; // int funcʵ
-		std::function<void(std::vector<Counter>&)> m_counterSortFunc;
-		std::function<void(std::vector<Strip>&)> m_stripSortFunc;
+		std::wstring m_sortName; // 排序名称
+		int m_maxSize = 0; // 排序最大数据量
+		std::function<void(std::vector<int>&, std::stop_token)> m_intSortFunc; // int 排序func实例
+		std::function<void(std::vector<Counter>&, std::stop_token)> m_counterSortFunc;
+		std::function<void(std::vector<Strip>&, std::stop_token)> m_stripSortFunc;
+		std::function<void(std::vector<Tracer>&, std::stop_token)> m_tracerSortFunc; // 记录操作用于回放
+		std::function<SortSteps(std::vector<int>&, StepwiseMode)> m_stepSortFunc; // 逐步执行的协程版本（可选，见 SortSteps.h）
+		std::function<SortSteps(std::vector<int>&, RunToEndMode)> m_stepSortToEndFunc; // 同一个协程的执行到底版本
 
 		std::vector<NumRequire> m_numRequires;
-		bool m_isUnpredictable = false; // 㷨Ƿ񲻿Ԥ⣨Ԥ˯
-		bool m_isMulThread = false; // 㷨ǷΪ߳
+		bool m_isUnpredictable = false; // 算法是否不可预测（不可预测如猴子排序，睡眠排序）
+		bool m_isMulThread = false; // 算法是否为多线程
 
 	public:
 
 		Sort(const std::wstring& sort_name_, int max_size_,
-			const std::function<void(std::vector<int>&)>& int_sort_func_,
-			const std::function<void(std::vector<Counter>&)>& counter_sort_func_,
-			const std::function<void(std::vector<Strip>&)>& strip_sort_func_,
+			const std::function<void(std::vector<int>&, std::stop_token)>& int_sort_func_,
+			const std::function<void(std::vector<Counter>&, std::stop_token)>& counter_sort_func_,
+			const std::function<void(std::vector<Strip>&, std::stop_token)>& strip_sort_func_,
+			const std::function<void(std::vector<Tracer>&, std::stop_token)>& tracer_sort_func_,
 			std::vector<NumRequire> num_requires_ = {},
 			bool is_unpredictable_ = false, bool is_mul_thread_ = false) :
 			m_sortName(sort_name_), m_maxSize(max_size_), m_intSortFunc(int_sort_func_),
 			m_counterSortFunc(counter_sort_func_), m_stripSortFunc(strip_sort_func_),
+			m_tracerSortFunc(tracer_sort_func_),
 			m_numRequires(num_requires_), m_isUnpredictable(is_unpredictable_),
 			m_isMulThread(is_mul_thread_) {
 		}
@@ -117,18 +132,53 @@ namespace NVisualSort {
 			return this->m_sortName;
 		}
 
-		void SetIntSortFunc(const std::function<void(std::vector<int>&)>& int_sort_func_) {
+		void SetIntSortFunc(const std::function<void(std::vector<int>&, std::stop_token)>& int_sort_func_) {
 			this->m_intSortFunc = int_sort_func_;
 		}
 
-		void SetCounterSortFunc(const std::function<void(std::vector<Counter>&)>& counter_sort_func_) {
+		void SetCounterSortFunc(const std::function<void(std::vector<Counter>&, std::stop_token)>& counter_sort_func_) {
 			this->m_counterSortFunc = counter_sort_func_;
 		}
 
-		void SetStripSortFunc(const std::function<void(std::vector<Strip>&)>& strip_sort_func_) {
+		void SetStripSortFunc(const std::function<void(std::vector<Strip>&, std::stop_token)>& strip_sort_func_) {
 			this->m_stripSortFunc = strip_sort_func_;
 		}
 
+		void SetTracerSortFunc(const std::function<void(std::vector<Tracer>&, std::stop_token)>& tracer_sort_func_) {
+			this->m_tracerSortFunc = tracer_sort_func_;
+		}
+
+		// 返回自身，注册排序时可以直接接在构造后面；两个参数是同一个逐步排序函数的两种实例化（见 VISUALSORT_STEP_SORT_FUNCS）
+		Sort& SetStepSortFunc(const std::function<SortSteps(std::vector<int>&, StepwiseMode)>& step_sort_func_,
+			const std::function<SortSteps(std::vector<int>&, RunToEndMode)>& step_sort_to_end_func_) {
+			this->m_stepSortFunc = step_sort_func_;
+			this->m_stepSortToEndFunc = step_sort_to_end_func_;
+			return *this;
+		}
+		bool GetHasStepSort() const {
+			return static_cast<bool>(this->m_stepSortFunc);
+		}
+
+		// 创建逐步执行的排序，第一次调用 Next 时才开始执行；data_ 在排序结束前必须保持有效
+		SortSteps CreateSortSteps(std::vector<int>& data_) {
+			if (!this->m_stepSortFunc) {
+				throw WideError(L"该排序没有逐步执行的版本！");
+			}
+			return this->m_stepSortFunc(data_, StepwiseMode{});
+		}
+
+		// 用逐步排序的 RunToEndMode 实例化一直执行到结束，返回总步数（与逐步执行时 Next 返回 true 的次数相同）；
+		// 不构造记录、不挂起，stop_token_ 请求停止时在下一轮返回，数据处于未排完的状态
+		size_t RunStepSortToEnd(std::vector<int>& data_, std::stop_token stop_token_ = {}) {
+			if (!this->m_stepSortToEndFunc) {
+				throw WideError(L"该排序没有逐步执行的版本！");
+			}
+			size_t stepNum = 0;
+			SortSteps steps = this->m_stepSortToEndFunc(data_, RunToEndMode{ &stepNum, stop_token_ });
+			steps.Next();
+			return stepNum;
+		}
+
 		void SetNumRequires(const std::vector<NumRequire>& num_requires_) {
 			this->m_numRequires = num_requires_;
 		}
@@ -162,51 +212,73 @@ namespace NVisualSort {
 			return this->m_isMulThread;
 		}
 
-		void RunIntSort(std::vector<int>& data_) {
-			this->m_intSortFunc(data_);
+		// 是否只有调用线程操作数据（睡眠排序不算多线程排序，但数据由线程池中的定时任务写入，不可预测的排序都不算）
+		bool GetIsCallingThreadOnly() const {
+			return !this->m_isMulThread && !this->m_isUnpredictable;
+		}
+
+		void RunIntSort(std::vector<int>& data_, std::stop_token stop_token_ = {}) {
+			this->m_intSortFunc(data_, stop_token_);
+		}
+
+		void RunCounterSort(std::vector<Counter>& data_, std::stop_token stop_token_ = {}) {
+			this->m_counterSortFunc(data_, stop_token_);
 		}
 
-		void RunCounterSort(std::vector<Counter>& data_) {
-			this->m_counterSortFunc(data_);
+		void RunStripSort(std::vector<Strip>& data_, std::stop_token stop_token_ = {}) {
+			this->m_stripSortFunc(data_, stop_token_);
 		}
 
-		void RunStripSort(std::vector<Strip>& data_) {
-			this->m_stripSortFunc(data_);
+		void RunTracerSort(std::vector<Tracer>& data_, std::stop_token stop_token_ = {}) {
+			this->m_tracerSortFunc(data_, stop_token_);
 		}
 
 		template<typename T> requires
-			(std::same_as<T, int> || std::same_as<T, Counter> || std::same_as<T, Strip>)
-		void RunSort(std::vector<T>& data_) {
+			(std::same_as<T, int> || std::same_as<T, Counter> || std::same_as<T, Strip> || std::same_as<T, Tracer>)
+		// stop_token_ 请求停止后，排序在下一个检查点（每一轮、每次划分或合并）直接返回，数据处于未排完的状态
+		void RunSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if constexpr (std::is_same_v<T, int>) {
-				this->m_intSortFunc(data_);
+				this->m_intSortFunc(data_, stop_token_);
 			}
 			else if constexpr (std::is_same_v<T, Counter>) {
-				this->m_counterSortFunc(data_);
+				this->m_counterSortFunc(data_, stop_token_);
 			}
 			else if constexpr (std::is_same_v<T, Strip>) {
-				this->m_stripSortFunc(data_);
+				this->m_stripSortFunc(data_, stop_token_);
+			}
+			else if constexpr (std::is_same_v<T, Tracer>) {
+				this->m_tracerSortFunc(data_, stop_token_);
 			}
 		}
 
 	};
 
-	// 㷨ʵ֣Щ㷨ֻ int,Counter,Strip ΪԪ͵ڱĿʹã
+	// 排序算法实现（这些算法只考虑了 int,Counter,Strip,Tracer 作为元素类型的情况，请谨慎在别的项目使用）
 	namespace NSortAlgorithms {
 
-		// רóʼ֤࣬ʵʱȷ
+		template<class T = int> void BogoSort(std::vector<T>& data_, std::stop_token stop_token_ = {});
+
+		// 猴子排序专用初始随机数类，保证真实排序时间计算正确。
 		class BogoSortRandomEngine {
 		private:
+			static unsigned int GenerateSeed() {
+#ifdef VISUALSORT_HEADLESS
+				return std::random_device{}();
+#else
+				return GetConfigManager().GenerateRandom();
+#endif
+			}
 			inline static std::atomic<bool> s_isIntUsed = false;
 			inline static std::atomic<bool> s_isCounterUsed = false;
 			inline static std::atomic<bool> s_isStripUsed = false;
-			inline static std::atomic<int> s_randomNumber = GetConfigManager().GenerateRandom();
-			template<class T> friend void BogoSort(std::vector<T>& data_);
+			inline static std::atomic<int> s_randomNumber = BogoSortRandomEngine::GenerateSeed();
+			template<class T> friend void BogoSort(std::vector<T>& data_, std::stop_token stop_token_);
 			template<class T> static int GetBogoRandom() {
 				if (s_isIntUsed.load() && s_isCounterUsed.load() && s_isStripUsed.load()) {
 					s_isIntUsed = false;
 					s_isCounterUsed = false;
 					s_isStripUsed = false;
-					s_randomNumber = GetConfigManager().GenerateRandom();
+					s_randomNumber = BogoSortRandomEngine::GenerateSeed();
 				}
 				if constexpr (std::is_same_v<T, int>) {
 					s_isIntUsed = true;
@@ -214,22 +286,26 @@ namespace NVisualSort {
 				else if constexpr (std::is_same_v<T, Counter>) {
 					s_isCounterUsed = true;
 				}
-				else if constexpr (std::is_same_v<T, Strip>) {
-					s_isStripUsed = true;
+				else if constexpr (std::is_same_v<T, Strip> || std::is_same_v<T, Tracer>) {
+					s_isStripUsed = true; // 回放模式下用 Tracer 版本代替 Strip 版本显示
 				}
 				return s_randomNumber;
 			}
 		};
-		// 
-		template<class T = int> void BogoSort(std::vector<T>& data_) {
+		// 猴子排序
+		template<class T> void BogoSort(std::vector<T>& data_, std::stop_token stop_token_) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			std::mt19937 randomEngin(BogoSortRandomEngine::GetBogoRandom<T>());
-			bool isSorted = false;
+			// 能停止时一直运行到停止请求；调用方无法停止时才限制次数，超过后报错
+			bool isBounded = !stop_token_.stop_possible();
 			int timeToLive = 1000000;
-			while (timeToLive--) {
+			while (!stop_token_.stop_requested()) {
+				if (isBounded && timeToLive-- == 0) {
+					throw WideError(L"猴子排序超时！");
+				}
 				ptrdiff_t i = 0;
 				for (; i < dataSize; ++i) {
 					std::swap(data_[i], data_[randomEngin() % dataSize]);
@@ -241,20 +317,22 @@ namespace NVisualSort {
 					return;
 				}
 			}
-			throw WideError(L"ʱ");
 		}
 
-		// Ƥ
-		template<class T = int> void StoogeSort(std::vector<T>& data_) {
+		// 臭皮匠排序
+		template<class T = int> void StoogeSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 
-			// ʹջģݹ
+			// 使用栈来模拟递归调用
 			std::stack<std::pair<ptrdiff_t, ptrdiff_t>> localStack;
 			localStack.push(std::make_pair(static_cast<ptrdiff_t>(0), static_cast<ptrdiff_t>(data_.size() - 1)));
 
 			while (!localStack.empty()) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t i = localStack.top().first;
 				ptrdiff_t j = localStack.top().second;
 				localStack.pop();
@@ -264,28 +342,24 @@ namespace NVisualSort {
 				if (data_[i] > data_[j]) {
 					std::swap(data_[i], data_[j]);
 				}
-				// 3Ԫأָ
+				// 如果子数组有3个或更多元素，继续分割
 				if (j - i > 1) {
 					ptrdiff_t k = (j - i + 1) / 3;
-					// 鰴෴˳ѹջΪLIFO
-					// ˳ǣȴһ֣Ȼڶ֣Ȼٴεһ
-					localStack.push(std::make_pair(i, j - k));// һδһ
-					localStack.push(std::make_pair(i + k, j));// ڶ
-					localStack.push(std::make_pair(i, j - k));// ڶδһ
+					// 将三个子数组按相反顺序压入栈（因为是LIFO）
+					// 这样处理顺序会是：先处理第一部分，然后第二部分，然后再次第一部分
+					localStack.push(std::make_pair(i, j - k));// 第一次处理第一部分
+					localStack.push(std::make_pair(i + k, j));// 处理第二部分
+					localStack.push(std::make_pair(i, j - k));// 第二次处理第一部分
 				}
 			}
 		}
 
-		// ˯˯ߵʱ両ҲԤ⣬ʱʾɿ
-		template<class T = int> void SleepSort(std::vector<T>& data_) {
+		// 睡眠排序（睡眠的时间浮动且不可预测，所以排序时间的显示不可靠）
+		template<class T = int> void SleepSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 
-			if (data_.size() > 300) {
-				throw WideError(L"˯󣬿ܻᵼջ");
-			}
-
 			ptrdiff_t dataSize = data_.size();
 			int maxValue = data_[0];
 			int minValue = data_[0];
@@ -298,51 +372,70 @@ namespace NVisualSort {
 				return;
 			}
 			else if (rangeSize > 100000) {
-				throw WideError(L"Сֵֵ󣬲ʹ˯");
+				throw WideError(L"该数据最小值与最大值差距过大，不建议使用睡眠排序！");
 			}
 
-			std::promise<void> startPromise;
-			std::shared_future<void> startPuture = startPromise.get_future().share();
-
-			std::vector<std::thread> workers;
-			std::atomic<ptrdiff_t> workerOKNum = 0;
-			std::mutex resultMutex;  // д
-
-			for (size_t i = 0; i < data_.size(); ++i) {
-				long long sleepTime = static_cast<long long>(data_[i]) - minValue;
+			// 先读出所有数据，之后线程池中的任务会改写 data_
+			std::vector<long long> sleepTimes(data_.size());
+			for (ptrdiff_t i = 0; i < dataSize; ++i) {
+				sleepTimes[i] = static_cast<long long>(data_[i]) - minValue;
+			}
 
-				workers.emplace_back([startPuture, sleepTime, minValue, &data_, &workerOKNum, &resultMutex]() {
-					// ߳ͬʱʼȴź
-					startPuture.wait();  // û̲߳еȴ
+			// 任务的共享状态：停止后排序函数不再等待直接返回，之后到期的任务看到 isAbandoned 就不再碰 data_
+			struct SleepState {
+				std::mutex mutex; // 保护结果数组的写入
+				std::condition_variable_any condition;
+				ptrdiff_t workerOKNum = 0;
+				bool isAbandoned = false;
+			};
+			auto state = std::make_shared<SleepState>();
 
-					// ˯
-					if constexpr (std::is_same_v<T, Strip>) {
-						std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime * 100));
-						AnimationStepNum += 1000;
-					}
-					else {
-						std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
-					}
-					if constexpr (std::is_same_v<T, Counter>) {
-						ActualStepNum += 1000;
+			// 每个数据是线程池中的一个定时任务，睡眠由线程池的定时器完成，不再为每个数据创建线程
+			// 留出 10 毫秒把任务都提交完，之后所有数据同时开始计时
+			auto startTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+			for (ptrdiff_t i = 0; i < dataSize; ++i) {
+				long long sleepTime = sleepTimes[i];
+				std::chrono::steady_clock::duration sleepDuration;
+				if constexpr (ElementTraits<T>::IsDrawn) {
+					sleepDuration = std::chrono::milliseconds(sleepTime * 100);
+				}
+				else {
+					sleepDuration = std::chrono::microseconds(sleepTime);
+				}
+				GetThreadPool().SubmitAt(startTime + sleepDuration, [sleepTime, minValue, &data_, state]() {
+					// 将结果放入结果数组（需要保护，因为多个任务可能同时到期）
+					{
+						std::lock_guard<std::mutex> lock(state->mutex);
+						if (state->isAbandoned) {
+							return;
+						}
+						ElementTraits<T>::AddSteps(1000);
+						data_[state->workerOKNum++] = static_cast<int>(sleepTime + minValue);
 					}
-
-					// 飨ҪΪ߳̿ͬʱ
-					std::lock_guard<std::mutex> lock(resultMutex);
-					data_[workerOKNum++] = static_cast<int>(sleepTime + minValue);
+					state->condition.notify_all();
 				});
 			}
-
-			// ע⣺Ҫ߳һʱЩ̻߳ûʼȴ
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
-			startPromise.set_value();
-
-			for (auto& worker : workers) {
-				if (worker.joinable()) {
-					worker.join();
+			{
+				auto isAllOK = [&state, dataSize]() {
+					return state->workerOKNum == dataSize;
+				};
+				if (GetThreadPool().IsWorkerThread()) {
+					// 工作线程等待时帮忙执行任务，避免所有工作线程都在等待而死锁；停止请求不是任务，要单独唤醒
+					std::stop_callback onStop(stop_token_, []() {
+						GetThreadPool().NotifyWaiters();
+					});
+					GetThreadPool().WaitUntil([&state, &isAllOK, &stop_token_]() {
+						std::lock_guard<std::mutex> lock(state->mutex);
+						return isAllOK() || stop_token_.stop_requested();
+					});
 				}
-				else {
-					throw WideError(L"˯޷ع̣߳");
+				std::unique_lock<std::mutex> lock(state->mutex);
+				if (!GetThreadPool().IsWorkerThread()) {
+					state->condition.wait(lock, stop_token_, isAllOK);
+				}
+				if (!isAllOK()) {
+					state->isAbandoned = true;
+					return;
 				}
 			}
 
@@ -357,47 +450,50 @@ namespace NVisualSort {
 			}
 		}
 
-		// ѭ
-		template<class T = int> void CycleSort(std::vector<T>& data_) {
+		// 循环排序
+		template<class T = int> void CycleSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			for (ptrdiff_t cycleStart = 0; cycleStart < dataSize - 1; ++cycleStart) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				T item(data_[cycleStart]);
-				// Ѱ item Ӧ÷õλ
+				// 寻找 item 应该放置的位置
 				ptrdiff_t itemPosition = cycleStart;
 				for (ptrdiff_t i = cycleStart + 1; i < dataSize; ++i) {
 					if (data_[i] < item) {
 						++itemPosition;
 					}
 				}
-				//  item Ѿȷλãһѭ
+				// 如果 item 已经在正确位置，继续下一个循环
 				if (itemPosition == cycleStart) {
 					continue;
 				}
-				// ȵԪ
+				// 跳过相等的元素
 				while (item == data_[itemPosition]) {
 					++itemPosition;
 				}
-				// ҵ˲ͬԪأ
+				// 如果找到了不同元素，交换
 				if (itemPosition != cycleStart) {
 					std::swap(item, data_[itemPosition]);
 				}
-				// תʣѭ
+				// 继续旋转剩余的循环
 				while (itemPosition != cycleStart) {
 					itemPosition = cycleStart;
-					// Ϊǰ item Ѱȷλ
+					// 为当前 item 寻找正确位置
 					for (ptrdiff_t i = cycleStart + 1; i < dataSize; ++i) {
 						if (data_[i] < item) {
 							++itemPosition;
 						}
 					}
-					// ȵԪ
+					// 跳过相等的元素
 					while (item == data_[itemPosition]) {
 						++itemPosition;
 					}
-					// ֱ item صԭʼλ
+					// 交换直到 item 回到原始位置
 					if (item != data_[itemPosition]) {
 						std::swap(item, data_[itemPosition]);
 					}
@@ -405,13 +501,16 @@ namespace NVisualSort {
 			}
 		}
 
-		// ð
-		template<class T = int> void BubbleSort(std::vector<T>& data_) {
+		// 冒泡老祖
+		template<class T = int> void BubbleSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			for (ptrdiff_t i = 0; i < dataSize; ++i) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				bool noSwapped = true;
 				for (ptrdiff_t j = 0; j < dataSize - i - 1; ++j) {
 					if (data_[j] > data_[j + 1]) {
@@ -425,13 +524,16 @@ namespace NVisualSort {
 			}
 		}
 
-		// ˫ð
-		template<class T = int> void BidirectionalBubbleSort(std::vector<T>& data_) {
+		// 双向冒泡
+		template<class T = int> void BidirectionalBubbleSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			for (ptrdiff_t i = 0; i < (dataSize >> 1); ++i) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				bool noSwap = true;
 				for (ptrdiff_t j = i; j < dataSize - i - 1; ++j) {
 					if (data_[j] > data_[j + 1]) {
@@ -451,8 +553,8 @@ namespace NVisualSort {
 			}
 		}
 
-		// ż
-		template<class T = int> void OddEvenSort(std::vector<T>& data_) {
+		// 奇偶排序
+		template<class T = int> void OddEvenSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
@@ -460,6 +562,9 @@ namespace NVisualSort {
 			bool odd = true;
 			bool even = true;
 			while (odd && even) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				odd = false;
 				even = false;
 				for (ptrdiff_t i = 0; i < dataSizeSub1; i += 2) {
@@ -477,15 +582,18 @@ namespace NVisualSort {
 			}
 		}
 
-		// ѡ
-		template<class T = int> void SelectionSort(std::vector<T>& data_) {
+		// 选择排序
+		template<class T = int> void SelectionSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			for (ptrdiff_t i = 0; i < dataSize - 1; ++i) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t minValuePos = i;
-				if constexpr (std::is_same_v<T, Strip>) {
+				if constexpr (ElementTraits<T>::IsDrawn) {
 					data_[i].SetColor(GREEN);
 				}
 				for (ptrdiff_t j = i + 1; j < dataSize; ++j) {
@@ -497,14 +605,17 @@ namespace NVisualSort {
 			}
 		}
 
-		// ˫ѡ
-		template<class T = int> void BidirectionalSelectionSort(std::vector<T>& data_) {
+		// 双向选择
+		template<class T = int> void BidirectionalSelectionSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			for (ptrdiff_t i = 0; i < (dataSize >> 1); ++i) {
-				if constexpr (std::is_same_v<T, Strip>) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
+				if constexpr (ElementTraits<T>::IsDrawn) {
 					data_[i].SetColor(GREEN);
 				}
 				ptrdiff_t maxValuePos = i;
@@ -531,13 +642,16 @@ namespace NVisualSort {
 			}
 		}
 
-		// 
-		template<class T = int> void InsertionSort(std::vector<T>& data_) {
+		// 插入排序
+		template<class T = int> void InsertionSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 
 			for (auto it = data_.begin() + 1; it != data_.end(); ++it) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				if (*it >= *(it - 1)) {
 					continue;
 				}
@@ -548,13 +662,13 @@ namespace NVisualSort {
 			}
 		}
 
-		// 
-		template<class T = int> void BeadSort(std::vector<T>& data_) {
+		// 珠排序
+		template<class T = int> void BeadSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-				throw WideError(L"ָ֧");
+				throw WideError(L"珠排序不支持浮点数！");
 			}
 			ptrdiff_t dataSize = data_.size();
 			int maxValue = data_[0];
@@ -568,7 +682,7 @@ namespace NVisualSort {
 				return;
 			}
 			else if (rangeSize > 10000000) {
-				throw WideError(L"Сֵֵ󣬲ʺʹ");
+				throw WideError(L"该数据最小值与最大值差距过大，不适合使用珠排序！");
 			}
 			std::vector<ptrdiff_t> beadQueue(rangeSize, 0);
 			for (ptrdiff_t i = 0; i < dataSize; ++i) {
@@ -576,23 +690,27 @@ namespace NVisualSort {
 					++beadQueue[j];
 				}
 			}
+			if (stop_token_.stop_requested()) {
+				return;
+			}
+
 			ptrdiff_t i = 0;
 			for (; i < dataSize - beadQueue[0]; ++i) {
 				data_[i] = minValue;
 			}
 			for (; i < dataSize - *beadQueue.rbegin(); ++i) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				for (ptrdiff_t j = static_cast<long long>(data_[i - 1]) - minValue; j < rangeSize; ++j) {
 					if (beadQueue[j] < dataSize - i) {
 						data_[i] = static_cast<int>(j + minValue);
 						break;
 					}
-					if constexpr (std::is_same_v<T, Counter>) {
-						++ActualStepNum;
-					}
-					else if constexpr (std::is_same_v<T, Strip>) {
+					if constexpr (ElementTraits<T>::IsDrawn) {
 						std::this_thread::sleep_for(std::chrono::milliseconds(1));
-						++AnimationStepNum;
 					}
+					ElementTraits<T>::AddSteps(1);
 				}
 			}
 			for (; i < dataSize; ++i) {
@@ -600,8 +718,8 @@ namespace NVisualSort {
 			}
 		}
 
-		// 
-		template<class T = int> void CombSort(std::vector<T>& data_) {
+		// 梳排序
+		template<class T = int> void CombSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
@@ -612,6 +730,9 @@ namespace NVisualSort {
 			constexpr double shrink = 1.3;
 
 			while (gap > 1 || swapped) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				gap = static_cast<ptrdiff_t>(gap / shrink);
 				if (gap < 1) {
 					gap = 1;
@@ -632,18 +753,21 @@ namespace NVisualSort {
 			}
 		}
 
-		// ϣ
-		template<class T = int> void ShellSort(std::vector<T>& data_) {
+		// 希尔排序
+		template<class T = int> void ShellSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 
-			// ʹ Ciura 
+			// 使用 Ciura 增量序列
 			std::vector<ptrdiff_t> gaps = { 701, 301, 132, 57, 23, 10, 4, 1 };
 
 			for (ptrdiff_t gap : gaps) {
 				if (gap >= dataSize) continue;
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 
 				for (ptrdiff_t i = gap; i < dataSize; ++i) {
 					T temp = data_[i];
@@ -658,13 +782,13 @@ namespace NVisualSort {
 			}
 		}
 
-		// ˫
-		template<class T = int> void BitonicSort(std::vector<T>& data_) {
+		// 双调排序
+		template<class T = int> void BitonicSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			if ((data_.size() & (data_.size() - 1)) != 0) {
-				throw WideError(L"˫ҪΪ2ķǸݣ");
+				throw WideError(L"双调排序要求数据量为2的非负整数次幂！");
 			}
 
 			struct Range {
@@ -677,6 +801,9 @@ namespace NVisualSort {
 			localStack.push({ 0, static_cast<ptrdiff_t>(data_.size()), true, true });
 
 			while (!localStack.empty()) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t position = localStack.top().m_position;
 				ptrdiff_t length = localStack.top().m_length;
 				bool ascending = localStack.top().m_ascending;
@@ -689,33 +816,33 @@ namespace NVisualSort {
 
 				ptrdiff_t middleIndex = length / 2;
 
-				if (type == false) {  // func1: ִкϲ
-					// ִкϲ
+				if (type == false) {  // func1: 执行合并
+					// 执行合并操作
 					for (ptrdiff_t i = 0; i < middleIndex; ++i) {
 						if ((data_[i + position] > data_[i + middleIndex + position]) == ascending) {
 							std::swap(data_[i + position], data_[i + middleIndex + position]);
 						}
 					}
 
-					// ݹ鴦
+					// 递归处理子序列
 					localStack.push({ position + middleIndex, middleIndex, ascending, false });
 					localStack.push({ position, middleIndex, ascending, false });
 				}
-				else {  // func2: ݹֽ
-					// func1ϲִУ
+				else {  // func2: 递归分解
+					// 添加func1合并任务（最后执行）
 					localStack.push({ position, length, ascending, false });
 
-					// Ұ벿
+					// 添加右半部分任务
 					localStack.push({ position + middleIndex, length - middleIndex, ascending, true });
 
-					// 벿asdȡ
+					// 添加左半部分任务（asd取反）
 					localStack.push({ position, middleIndex, !ascending, true });
 				}
 			}
 		}
 
-		// 鲢
-		template<class T = int> void MergeSort(std::vector<T>& data_) {
+		// 归并排序
+		template<class T = int> void MergeSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
@@ -733,6 +860,9 @@ namespace NVisualSort {
 			std::vector<T> dataQueue(data_.size() / 2 + 1);
 
 			while (!localStack.empty()) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t leftIndex = localStack.rbegin()->m_leftIndex;
 				ptrdiff_t rightIndex = localStack.rbegin()->m_rightIndex;
 				bool isProcessed = localStack.rbegin()->m_isProcessed;
@@ -745,15 +875,15 @@ namespace NVisualSort {
 				ptrdiff_t middleIndex = leftIndex + (rightIndex - leftIndex) / 2;
 
 				if (!isProcessed) {
-					// һηʣҪȴ
-					// ѹ뵱ǰ񣨱ΪѴ
+					// 第一次访问：需要先处理子问题
+					// 压入当前任务（标记为已处理）
 					localStack.push_back({ leftIndex, rightIndex, true });
-					// ѹ
+					// 压入右子任务
 					localStack.push_back({ middleIndex + 1, rightIndex, false });
-					// ѹ
+					// 压入左子任务
 					localStack.push_back({ leftIndex, middleIndex, false });
 				}
-				// ڶηʣѴʼϲ
+				// 第二次访问，子问题已处理，开始合并
 				else {
 					for (ptrdiff_t i = leftIndex; i <= middleIndex; ++i) {
 						dataQueue[i - leftIndex] = data_[i];
@@ -777,74 +907,209 @@ namespace NVisualSort {
 			}
 		}
 
-		// 
-		template<class T = int> void HeapSort(std::vector<T>& data_) {
+		// 并行归并排序的实现：在 data_ 与等大的缓冲区之间来回归并（不再拷贝左半部分），
+		// 左右两半交给线程池并行排序，较大的区间按合并路径（co-rank）切开后并行合并
+		template<class T> class ParallelMergeSorter {
+
+		private:
+
+			// 小于它的区间直接插入排序
+			static constexpr ptrdiff_t LeafSize = 16;
+			// 大于它的区间才拆成并行任务；Strip 版本取得小一些，好让多个归并前沿同时推进
+			static constexpr ptrdiff_t TaskSize = ElementTraits<T>::IsDrawn ? 64 : 2048;
+			static constexpr ptrdiff_t MergeTaskSize = ElementTraits<T>::IsDrawn ? 128 : 8192;
+
+			std::vector<T>& m_data;
+			std::vector<T> m_buffer;
+			std::stop_token m_stopToken; // 每次合并与每个区间开始前检查，停止后各个任务直接返回
+
+			std::vector<T>& GetArray(bool in_buffer_) noexcept {
+				return in_buffer_ ? this->m_buffer : this->m_data;
+			}
+
+			void Merge(bool from_buffer_, ptrdiff_t left_begin_, ptrdiff_t left_end_,
+				ptrdiff_t right_begin_, ptrdiff_t right_end_, ptrdiff_t target_begin_) {
+				if (this->m_stopToken.stop_requested()) {
+					return;
+				}
+				std::vector<T>& source = this->GetArray(from_buffer_);
+				std::vector<T>& target = this->GetArray(!from_buffer_);
+				ptrdiff_t totalNum = (left_end_ - left_begin_) + (right_end_ - right_begin_);
+				if (totalNum > MergeTaskSize) {
+					ptrdiff_t halfNum = totalNum / 2;
+					ptrdiff_t leftNum = CoRank(source, left_begin_, left_end_, right_begin_, right_end_, halfNum);
+					ptrdiff_t leftMiddle = left_begin_ + leftNum;
+					ptrdiff_t rightMiddle = right_begin_ + (halfNum - leftNum);
+					GetThreadPool().ParallelInvoke(
+						[&]() { this->Merge(from_buffer_, left_begin_, leftMiddle, right_begin_, rightMiddle, target_begin_); },
+						[&]() { this->Merge(from_buffer_, leftMiddle, left_end_, rightMiddle, right_end_, target_begin_ + halfNum); });
+					return;
+				}
+				ptrdiff_t leftIndex = left_begin_;
+				ptrdiff_t rightIndex = right_begin_;
+				ptrdiff_t targetIndex = target_begin_;
+				while (leftIndex < left_end_ && rightIndex < right_end_) {
+					if (source[rightIndex] < source[leftIndex]) {
+						target[targetIndex++] = source[rightIndex++];
+					}
+					else {
+						target[targetIndex++] = source[leftIndex++];
+					}
+				}
+				while (leftIndex < left_end_) {
+					target[targetIndex++] = source[leftIndex++];
+				}
+				while (rightIndex < right_end_) {
+					target[targetIndex++] = source[rightIndex++];
+				}
+			}
+
+			// 排序 [begin_, end_)，结果放在 m_buffer（in_buffer_ 为 true）或 m_data 中
+			void SortRange(ptrdiff_t begin_, ptrdiff_t end_, bool in_buffer_) {
+				if (this->m_stopToken.stop_requested()) {
+					return;
+				}
+				if (end_ - begin_ <= LeafSize) {
+					std::vector<T>& target = this->GetArray(in_buffer_);
+					if (in_buffer_) {
+						for (ptrdiff_t i = begin_; i < end_; ++i) {
+							target[i] = this->m_data[i];
+						}
+					}
+					for (ptrdiff_t i = begin_ + 1; i < end_; ++i) {
+						if (!(target[i] < target[i - 1])) {
+							continue;
+						}
+						T key = target[i];
+						ptrdiff_t j = i;
+						do {
+							target[j] = target[j - 1];
+							--j;
+						} while (j > begin_ && key < target[j - 1]);
+						target[j] = key;
+					}
+					return;
+				}
+				// 两半排进另一个数组，再合并回来
+				ptrdiff_t middle = begin_ + (end_ - begin_) / 2;
+				if (end_ - begin_ > TaskSize) {
+					GetThreadPool().ParallelInvoke(
+						[&]() { this->SortRange(begin_, middle, !in_buffer_); },
+						[&]() { this->SortRange(middle, end_, !in_buffer_); });
+				}
+				else {
+					this->SortRange(begin_, middle, !in_buffer_);
+					this->SortRange(middle, end_, !in_buffer_);
+				}
+				this->Merge(!in_buffer_, begin_, middle, middle, end_, begin_);
+			}
+
+		public:
+
+			// 在 [left_begin_, left_end_) 与 [right_begin_, right_end_) 的合并结果中，前 target_num_ 个元素里有几个来自左边（相等时左边优先）
+			static ptrdiff_t CoRank(const std::vector<T>& source_, ptrdiff_t left_begin_, ptrdiff_t left_end_,
+				ptrdiff_t right_begin_, ptrdiff_t right_end_, ptrdiff_t target_num_) {
+				ptrdiff_t low = (std::max)(static_cast<ptrdiff_t>(0), target_num_ - (right_end_ - right_begin_));
+				ptrdiff_t high = (std::min)(target_num_, left_end_ - left_begin_);
+				while (low < high) {
+					ptrdiff_t leftNum = low + (high - low) / 2;
+					ptrdiff_t rightNum = target_num_ - leftNum;
+					// 右边第 rightNum 个元素不小于左边第 leftNum + 1 个元素，说明左边还应该多取
+					if (rightNum > 0 && !(source_[right_begin_ + rightNum - 1] < source_[left_begin_ + leftNum])) {
+						low = leftNum + 1;
+					}
+					else {
+						high = leftNum;
+					}
+				}
+				return low;
+			}
+
+			ParallelMergeSorter(std::vector<T>& data_, std::stop_token stop_token_) : m_data(data_), m_buffer(data_.size()), m_stopToken(stop_token_) {
+				// 缓冲区与原数组地位相同，由插桩策略决定是否按数组中的元素对待（Counter 版本对缓冲区的操作也计数）
+				ElementTraits<T>::MarkAsArray(this->m_buffer);
+			}
+
+			void Sort() {
+				this->SortRange(0, static_cast<ptrdiff_t>(this->m_data.size()), false);
+			}
+
+		};
+
+		// 并行归并排序
+		template<class T = int> void ParallelMergeSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
-			auto sortFunc = [&data_](ptrdiff_t heap_size_) {
+			ParallelMergeSorter<T>(data_, stop_token_).Sort();
+		}
+
+		// 堆排序（对 [begin_index_, end_index_) 排序，模式消除快速排序退化时也用它）
+		template<class T = int> void HeapSortRange(std::vector<T>& data_, ptrdiff_t begin_index_, ptrdiff_t end_index_, std::stop_token stop_token_ = {}) {
+			if (end_index_ - begin_index_ < 2) {
+				return;
+			}
+			// 堆中下标为 index_ 的元素
+			auto at = [&data_, begin_index_](ptrdiff_t index_) -> T& {
+				return data_[begin_index_ + index_];
+			};
+			auto sortFunc = [&at](ptrdiff_t heap_size_) {
 				ptrdiff_t leftIndex = 1;
 				ptrdiff_t rightIndex = 2;
 				ptrdiff_t index = 0;
 				while (leftIndex < heap_size_) {
 					ptrdiff_t largestIndex = 0;
-					if (data_[leftIndex] < data_[rightIndex] && rightIndex < heap_size_) {
+					if (at(leftIndex) < at(rightIndex) && rightIndex < heap_size_) {
 						largestIndex = rightIndex;
 					}
 					else largestIndex = leftIndex;
-					if (data_[index] > data_[largestIndex]) {
+					if (at(index) > at(largestIndex)) {
 						largestIndex = index;
 					}
 					if (index == largestIndex) {
 						break;
 					}
-					if constexpr (std::is_same_v<T, Strip>) {
-						SwapWithoutSetColor(data_[index], data_[largestIndex]);
-					}
-					else if constexpr (std::is_same_v<T, Counter>) {
-						swap(data_[index], data_[largestIndex]);
-					}
-					else {
-						std::swap(data_[index], data_[largestIndex]);
-					}
+					SwapWithoutSetColor(at(index), at(largestIndex));
 					index = largestIndex;
 					leftIndex = 2 * index + 1;
 					rightIndex = leftIndex + 1;
 				}
 				};
-			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			ptrdiff_t dataSize = end_index_ - begin_index_;
 			for (ptrdiff_t i = 0; i < dataSize; ++i) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t currentIndex = i;
-				if constexpr (std::is_same_v<T, Strip>) {
+				if constexpr (ElementTraits<T>::IsDrawn) {
 					const std::vector<COLORREF> heapColor = {
 						BLUE,GREEN,CYAN,RED,MAGENTA,BROWN,YELLOW,LIGHTBLUE,LIGHTGREEN,LIGHTCYAN,LIGHTRED,LIGHTMAGENTA
 					};
-					data_[i].SetColor(heapColor[static_cast<size_t>(log2(i + 1)) % heapColor.size()]);
+					at(i).SetColor(heapColor[static_cast<size_t>(log2(i + 1)) % heapColor.size()]);
 				}
 				ptrdiff_t fatherIndex = (currentIndex - 1) / 2;
-				while (data_[currentIndex] > data_[fatherIndex]) {
-					if constexpr (std::is_same_v<T, Strip>) {
-						SwapWithoutSetColor(data_[currentIndex], data_[fatherIndex]);
-					}
-					else if constexpr (std::is_same_v<T, Counter>) {
-						swap(data_[currentIndex], data_[fatherIndex]);
-					}
-					else {
-						std::swap(data_[currentIndex], data_[fatherIndex]);
-					}
+				while (at(currentIndex) > at(fatherIndex)) {
+					SwapWithoutSetColor(at(currentIndex), at(fatherIndex));
 					currentIndex = fatherIndex;
 					fatherIndex = (currentIndex - 1) / 2;
 				}
 			}
 			ptrdiff_t heapSize = dataSize;
 			while (heapSize > 1) {
-				std::swap(data_[0], data_[--heapSize]);
+				if (stop_token_.stop_requested()) {
+					return;
+				}
+				std::swap(at(0), at(--heapSize));
 				sortFunc(heapSize);
 			}
 		}
 
-		// 
-		template<class T = int> void QuickSort(std::vector<T>& data_) {
+		template<class T = int> void HeapSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			HeapSortRange(data_, 0, static_cast<ptrdiff_t>(data_.size()), stop_token_);
+		}
+
+		// 快速排序
+		template<class T = int> void QuickSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
@@ -852,6 +1117,9 @@ namespace NVisualSort {
 			localStack.push({ static_cast<ptrdiff_t>(0), static_cast<ptrdiff_t>(data_.size()) - 1 });
 
 			while (!localStack.empty()) {
+				if (stop_token_.stop_requested()) {
+					return;
+				}
 				ptrdiff_t leftIndex = localStack.top().first;
 				ptrdiff_t rightIndex = localStack.top().second;
 				localStack.pop();
@@ -864,7 +1132,7 @@ namespace NVisualSort {
 				ptrdiff_t j = rightIndex;
 				T base = data_[leftIndex];
 
-				if constexpr (std::is_same_v<T, Strip>) {
+				if constexpr (ElementTraits<T>::IsDrawn) {
 					data_[leftIndex].SetColor(GREEN);
 				}
 
@@ -876,7 +1144,7 @@ namespace NVisualSort {
 
 				std::swap(data_[i], data_[leftIndex]);
 
-				// ѹջУȴϴԼջ
+				// 将子区间压入栈中，先处理较大的区间以减少栈深度
 				if (i - leftIndex < rightIndex - i) {
 					localStack.push(std::make_pair(i + 1, rightIndex));
 					localStack.push(std::make_pair(leftIndex, i - 1));
@@ -888,114 +1156,303 @@ namespace NVisualSort {
 			}
 		}
 
-		// ͰȾɫõģ޸ɫҪһɫ
+		// 模式消除快速排序（pdqsort）：三数取中/九数取中选基准，小区间插入排序，
+		// 坏划分超过 log2(n) 次时退化为堆排序，划分时没有发生交换就尝试用插入排序直接收尾
+		constexpr ptrdiff_t PdqSortInsertionThreshold = 24; // 小于它的区间直接插入排序
+		constexpr ptrdiff_t PdqSortNintherThreshold = 128; // 大于它的区间用九数取中
+		constexpr ptrdiff_t PdqSortPartialInsertionLimit = 8; // 尝试收尾时最多移动的元素数
+		template<class T = int> void PdqSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			if (data_.size() < 2) {
+				return;
+			}
+			auto swapFunc = [&data_](ptrdiff_t index1_, ptrdiff_t index2_) {
+				using std::swap;
+				swap(data_[index1_], data_[index2_]);
+				};
+			auto sort3Func = [&data_, &swapFunc](ptrdiff_t index1_, ptrdiff_t index2_, ptrdiff_t index3_) {
+				if (data_[index2_] < data_[index1_]) swapFunc(index1_, index2_);
+				if (data_[index3_] < data_[index2_]) swapFunc(index2_, index3_);
+				if (data_[index2_] < data_[index1_]) swapFunc(index1_, index2_);
+				};
+			// 对 [begin_, end_) 插入排序，移动的元素超过 move_limit_ 个就放弃并返回 false；
+			// leftmost_ 为 false 时 data_[begin_ - 1] 不大于区间内的任何元素，可以省掉边界检查
+			auto insertionSortFunc = [&data_](ptrdiff_t begin_, ptrdiff_t end_, bool leftmost_, ptrdiff_t move_limit_) {
+				ptrdiff_t moveNum = 0;
+				for (ptrdiff_t current = begin_ + 1; current < end_; ++current) {
+					if (!(data_[current] < data_[current - 1])) {
+						continue;
+					}
+					T key = std::move(data_[current]);
+					ptrdiff_t sift = current;
+					do {
+						data_[sift] = std::move(data_[sift - 1]);
+						--sift;
+					} while ((!leftmost_ || sift != begin_) && key < data_[sift - 1]);
+					data_[sift] = std::move(key);
+					moveNum += current - sift;
+					if (moveNum > move_limit_) {
+						return false;
+					}
+				}
+				return true;
+				};
+			// 基准在 data_[begin_]，小于基准的放左边；返回基准的最终位置，以及区间是否本来就已经划分好
+			auto partitionRightFunc = [&data_, &swapFunc](ptrdiff_t begin_, ptrdiff_t end_) {
+				T pivot = std::move(data_[begin_]);
+				ptrdiff_t first = begin_;
+				ptrdiff_t last = end_;
+				// 三数取中保证右侧有不小于基准的元素，左侧有小于等于基准的元素，不会越界
+				while (data_[++first] < pivot);
+				if (first - 1 == begin_) {
+					while (first < last && !(data_[--last] < pivot));
+				}
+				else {
+					while (!(data_[--last] < pivot));
+				}
+				bool isPartitioned = first >= last;
+				while (first < last) {
+					swapFunc(first, last);
+					while (data_[++first] < pivot);
+					while (!(data_[--last] < pivot));
+				}
+				ptrdiff_t pivotIndex = first - 1;
+				data_[begin_] = std::move(data_[pivotIndex]);
+				data_[pivotIndex] = std::move(pivot);
+				return std::make_pair(pivotIndex, isPartitioned);
+				};
+			// 基准在 data_[begin_]，等于基准的放左边；用于大量重复元素，返回基准的最终位置
+			auto partitionLeftFunc = [&data_, &swapFunc](ptrdiff_t begin_, ptrdiff_t end_) {
+				T pivot = std::move(data_[begin_]);
+				ptrdiff_t first = begin_;
+				ptrdiff_t last = end_;
+				while (pivot < data_[--last]);
+				if (last + 1 == end_) {
+					while (first < last && !(pivot < data_[++first]));
+				}
+				else {
+					while (!(pivot < data_[++first]));
+				}
+				while (first < last) {
+					swapFunc(first, last);
+					while (pivot < data_[--last]);
+					while (!(pivot < data_[++first]));
+				}
+				ptrdiff_t pivotIndex = last;
+				data_[begin_] = std::move(data_[pivotIndex]);
+				data_[pivotIndex] = std::move(pivot);
+				return pivotIndex;
+				};
+
+			// 待排序的区间，每次先处理较短的一侧，所以栈深度不超过 log2(n)
+			struct Range {
+				ptrdiff_t begin;
+				ptrdiff_t end;
+				int badAllowed; // 还允许几次坏划分
+				bool leftmost; // 左边是否没有别的元素
+			};
+			std::array<Range, 64> localStack;
+			size_t stackSize = 0;
+			localStack[stackSize++] = { 0, static_cast<ptrdiff_t>(data_.size()), static_cast<int>(std::log2(data_.size())), true };
+
+			while (stackSize > 0) {
+				Range range = localStack[--stackSize];
+				while (true) {
+					if (stop_token_.stop_requested()) {
+						return;
+					}
+					ptrdiff_t rangeSize = range.end - range.begin;
+					if (rangeSize < PdqSortInsertionThreshold) {
+						insertionSortFunc(range.begin, range.end, range.leftmost, rangeSize * rangeSize);
+						break;
+					}
+
+					// 把基准放到 data_[range.begin]
+					ptrdiff_t halfSize = rangeSize / 2;
+					if (rangeSize > PdqSortNintherThreshold) {
+						sort3Func(range.begin, range.begin + halfSize, range.end - 1);
+						sort3Func(range.begin + 1, range.begin + (halfSize - 1), range.end - 2);
+						sort3Func(range.begin + 2, range.begin + (halfSize + 1), range.end - 3);
+						sort3Func(range.begin + (halfSize - 1), range.begin + halfSize, range.begin + (halfSize + 1));
+						swapFunc(range.begin, range.begin + halfSize);
+					}
+					else {
+						sort3Func(range.begin + halfSize, range.begin, range.end - 1);
+					}
+					if constexpr (ElementTraits<T>::IsDrawn) {
+						data_[range.begin].SetColor(GREEN);
+					}
+
+					// 左边的元素等于基准时，这个区间的元素都不小于基准，把等于基准的元素一次性排除
+					if (!range.leftmost && !(data_[range.begin - 1] < data_[range.begin])) {
+						range.begin = partitionLeftFunc(range.begin, range.end) + 1;
+						continue;
+					}
+
+					auto [pivotIndex, isPartitioned] = partitionRightFunc(range.begin, range.end);
+					ptrdiff_t leftSize = pivotIndex - range.begin;
+					ptrdiff_t rightSize = range.end - (pivotIndex + 1);
+					if (leftSize < rangeSize / 8 || rightSize < rangeSize / 8) {
+						// 坏划分：次数用完就退化为堆排序，否则交换几个元素打乱可能导致坏划分的模式
+						if (--range.badAllowed == 0) {
+							HeapSortRange(data_, range.begin, range.end, stop_token_);
+							break;
+						}
+						if (leftSize >= PdqSortInsertionThreshold) {
+							swapFunc(range.begin, range.begin + leftSize / 4);
+							swapFunc(pivotIndex - 1, pivotIndex - leftSize / 4);
+							if (leftSize > PdqSortNintherThreshold) {
+								swapFunc(range.begin + 1, range.begin + (leftSize / 4 + 1));
+								swapFunc(range.begin + 2, range.begin + (leftSize / 4 + 2));
+								swapFunc(pivotIndex - 2, pivotIndex - (leftSize / 4 + 1));
+								swapFunc(pivotIndex - 3, pivotIndex - (leftSize / 4 + 2));
+							}
+						}
+						if (rightSize >= PdqSortInsertionThreshold) {
+							swapFunc(pivotIndex + 1, pivotIndex + (1 + rightSize / 4));
+							swapFunc(range.end - 1, range.end - rightSize / 4);
+							if (rightSize > PdqSortNintherThreshold) {
+								swapFunc(pivotIndex + 2, pivotIndex + (2 + rightSize / 4));
+								swapFunc(pivotIndex + 3, pivotIndex + (3 + rightSize / 4));
+								swapFunc(range.end - 2, range.end - (1 + rightSize / 4));
+								swapFunc(range.end - 3, range.end - (2 + rightSize / 4));
+							}
+						}
+					}
+					else if (isPartitioned
+						&& insertionSortFunc(range.begin, pivotIndex, range.leftmost, PdqSortPartialInsertionLimit)
+						&& insertionSortFunc(pivotIndex + 1, range.end, false, PdqSortPartialInsertionLimit)) {
+						// 划分时没有交换过元素，两侧用少量移动就排好了
+						break;
+					}
+
+					// 较长的一侧入栈，继续处理较短的一侧
+					Range leftRange = { range.begin, pivotIndex, range.badAllowed, range.leftmost };
+					Range rightRange = { pivotIndex + 1, range.end, range.badAllowed, false };
+					if (leftSize < rightSize) {
+						localStack[stackSize++] = rightRange;
+						range = leftRange;
+					}
+					else {
+						localStack[stackSize++] = leftRange;
+						range = rightRange;
+					}
+				}
+			}
+		}
+
+		// 基数排序给桶染色用的，可以随意修改颜色（至少要有一个颜色）
 		inline std::vector<COLORREF> RadixSortBucketColor = {
 			BLUE,MAGENTA,CYAN,RED,BROWN,YELLOW,GREEN,WHITE,BLACK,
 			LIGHTBLUE,LIGHTGREEN,LIGHTCYAN,LIGHTRED,LIGHTMAGENTA
 		};
-		// 
-		template<class T = int> void RadixSort(std::vector<T>& data_) {
+		// 基数排序（LSD，每次处理 8 位）
+		template<class T = int> void RadixSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-				throw WideError(L"ָ֧");
-			}
+				throw WideError(L"基数排序不支持浮点数！");
+			}
+			constexpr int digitBits = 8;
+			constexpr int digitNum = 32 / digitBits;
+			constexpr size_t base = static_cast<size_t>(1) << digitBits;
+			// 翻转符号位后，int 的大小顺序与 unsigned 一致，负数也能直接排序
+			auto getKey = [](int value_) -> uint32_t {
+				return static_cast<uint32_t>(value_) ^ 0x80000000u;
+				};
+			auto getValue = [&data_](ptrdiff_t index_) -> int {
+				if constexpr (ElementTraits<T>::IsDrawn) {
+					return data_[index_].GetValue();
+				}
+				else {
+					return static_cast<int>(data_[index_]);
+				}
+				};
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
-			int maxValue = data_[0];
-			int minValue = data_[0];
-			for (ptrdiff_t i = 1; i < dataSize; ++i) {
-				if (data_[i] > maxValue) maxValue = data_[i];
-				else if (data_[i] < minValue) minValue = data_[i];
-			}
-			long long rangeSize = static_cast<long long>(maxValue) - minValue;
-			if (rangeSize == 0) {
-				return;
-			}
 
-			const int base = 16;
-			std::vector<std::list<T>> bucket(base);
+			// 一次遍历统计所有位的直方图
+			std::array<std::array<size_t, base>, digitNum> histograms{};
+			uint32_t firstKey = getKey(getValue(0));
 			for (ptrdiff_t i = 0; i < dataSize; ++i) {
-				if constexpr (std::is_same_v<T, Strip>) {
-					ptrdiff_t bucketIndex = (static_cast<ptrdiff_t>(data_[i].GetValue()) - minValue) % base;
-					bucket[bucketIndex].push_back(data_[i].GetValue());
-					bucket[bucketIndex].back().SetColor(RadixSortBucketColor[bucketIndex % RadixSortBucketColor.size()]);
-					data_[i].SetColor(RadixSortBucketColor[bucketIndex % RadixSortBucketColor.size()]);
-					Strip::DrawStrip1(data_[i], StripCopyColor);
-					++AnimationStepNum;
-				}
-				else {
-					int tempValue = data_[i];
-					bucket[(static_cast<ptrdiff_t>(tempValue) - minValue) % base].push_back(tempValue);
+				uint32_t key = getKey(getValue(i));
+				for (int digitIndex = 0; digitIndex < digitNum; ++digitIndex) {
+					++histograms[digitIndex][(key >> (digitIndex * digitBits)) & (base - 1)];
 				}
 			}
 
-			std::list<T> dataQueue;
-			for (int i = 0; i < base; ++i) {
-				dataQueue.splice(dataQueue.end(), bucket[i]);
-			}
-			auto copyDataFromQueue = [&dataQueue, &data_]() {
-				ptrdiff_t dataIndex = 0;
-				for (auto it = dataQueue.begin(); it != dataQueue.end(); ++it) {
-					if constexpr (std::is_same_v<T, Strip>) {
-						data_[dataIndex++].CopyValueAndColor(*it);
-					}
-					else {
-						data_[dataIndex++] = *it;
-					}
+			std::vector<T> buffer(data_.size());
+			std::vector<COLORREF> bufferColors(ElementTraits<T>::IsDrawn ? data_.size() : 0); // buffer 中是临时条形，没有颜色，桶的颜色另外记下
+			std::vector<T>* source = &data_;
+			std::vector<T>* target = &buffer;
+			for (int digitIndex = 0; digitIndex < digitNum; ++digitIndex) {
+				if (stop_token_.stop_requested()) {
+					break; // int 版本的结果可能在 buffer 中，还要换回 data_
 				}
-				};
-			if constexpr (std::is_same_v<T, Strip> || std::is_same_v<T, Counter>) {
-				copyDataFromQueue();
-			}
-
-			int digit = 0;
-			for (ptrdiff_t i = rangeSize; i > 0; i /= base) {
-				++digit;
-			}
-			int divNum = base;
-			for (int i = 1; i < digit; ++i) {
-				if constexpr (std::is_same_v<T, Strip>) {
-					ptrdiff_t dataIndex = 0;
-					while (!dataQueue.empty()) {
-						ptrdiff_t bucketIndex = ((static_cast<ptrdiff_t>(*dataQueue.begin()) - minValue) / static_cast<ptrdiff_t>(divNum)) % base;
-						bucket[bucketIndex].splice(bucket[bucketIndex].end(), dataQueue, dataQueue.begin());
-						bucket[bucketIndex].back().SetColor(RadixSortBucketColor[bucketIndex % RadixSortBucketColor.size()]);
-						data_[dataIndex].SetColor(RadixSortBucketColor[bucketIndex % RadixSortBucketColor.size()]);
-						Strip::DrawStrip1(data_[dataIndex++], StripCopyColor);
-						++AnimationStepNum;
+				std::array<size_t, base>& histogram = histograms[digitIndex];
+				int shift = digitIndex * digitBits;
+				// 所有元素都落在同一个桶里，这一位不用排
+				if (histogram[(firstKey >> shift) & (base - 1)] == static_cast<size_t>(dataSize)) {
+					continue;
+				}
+				size_t offset = 0;
+				for (size_t& count : histogram) {
+					size_t bucketSize = count;
+					count = offset;
+					offset += bucketSize;
+				}
+
+				if constexpr (std::is_same_v<T, int>) {
+					// int 版本在两个数组之间来回分配，不拷贝回去
+					for (ptrdiff_t i = 0; i < dataSize; ++i) {
+						int value = (*source)[i];
+						(*target)[histogram[(getKey(value) >> shift) & (base - 1)]++] = value;
 					}
+					std::swap(source, target);
 				}
 				else {
-					while (!dataQueue.empty()) {
-						ptrdiff_t bucketIndex = ((static_cast<ptrdiff_t>(*dataQueue.begin()) - minValue) / static_cast<ptrdiff_t>(divNum)) % base;
-						bucket[bucketIndex].splice(bucket[bucketIndex].end(), dataQueue, dataQueue.begin());
+					// Counter、Strip 版本每一轮都拷贝回原数组，以便统计步数与显示
+					for (ptrdiff_t i = 0; i < dataSize; ++i) {
+						if constexpr (ElementTraits<T>::IsDrawn) {
+							int value = data_[i].GetValue();
+							size_t bucketIndex = (getKey(value) >> shift) & (base - 1);
+							COLORREF bucketColor = RadixSortBucketColor[bucketIndex % RadixSortBucketColor.size()];
+							data_[i].SetColor(bucketColor);
+							T::DrawStrip1(data_[i], StripCopyColor);
+							ElementTraits<T>::AddSteps(1);
+							T& bucketStrip = buffer[histogram[bucketIndex]++];
+							bucketStrip = value;
+							bufferColors[&bucketStrip - buffer.data()] = bucketColor;
+						}
+						else {
+							int value = data_[i];
+							buffer[histogram[(getKey(value) >> shift) & (base - 1)]++] = value;
+						}
+					}
+					for (ptrdiff_t i = 0; i < dataSize; ++i) {
+						if constexpr (ElementTraits<T>::IsDrawn) {
+							data_[i].SetColor(bufferColors[i]).CopyWithoutSetColor(buffer[i]);
+						}
+						else {
+							data_[i] = buffer[i];
+						}
 					}
 				}
-				if constexpr (std::is_same_v<T, Counter>) {
-					ActualStepNum += dataSize;
-				}
-				for (int j = 0; j < base; ++j) {
-					dataQueue.splice(dataQueue.end(), bucket[j]);
-				}
-				if constexpr (std::is_same_v<T, Strip> || std::is_same_v<T, Counter>) {
-					copyDataFromQueue();
-				}
-				divNum *= base;
 			}
 
 			if constexpr (std::is_same_v<T, int>) {
-				copyDataFromQueue();
+				if (source != &data_) {
+					data_.swap(buffer);
+				}
 			}
 		}
 
-		// 
-		template<class T = int> void CountingSort(std::vector<T>& data_) {
+		// 计数排序
+		template<class T = int> void CountingSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
 			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-				throw WideError(L"ָ֧");
+				throw WideError(L"计数排序不支持浮点数！");
 			}
 			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
 			int maxValue = data_[0];
@@ -1009,12 +1466,15 @@ namespace NVisualSort {
 				return;
 			}
 			if (rangeSize > 10000000) {
-				throw WideError(L"Сֵֵ󣬲ʺʹü");
+				throw WideError(L"该数据最小值与最大值差距过大，不适合使用计数排序！");
 			}
 			std::vector<int> countQueue(rangeSize, 0);
 			for (ptrdiff_t i = 0; i < dataSize; ++i) {
 				++countQueue[static_cast<ptrdiff_t>(data_[i]) - minValue];
 			}
+			if (stop_token_.stop_requested()) {
+				return;
+			}
 			ptrdiff_t j = 0;
 			for (ptrdiff_t i = 0; i < rangeSize; ++i) {
 				while (countQueue[i]) {
@@ -1024,47 +1484,409 @@ namespace NVisualSort {
 			}
 		}
 
-		// C++׼
-		template<class T = int> void StdSort(std::vector<T>& data_) {
-			if (data_.size() < 2) {
+		// C++标准库排序
+		template<class T = int> void StdSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			if (data_.size() < 2 || stop_token_.stop_requested()) {
 				return;
 			}
 			std::sort(data_.begin(), data_.end());
 		}
 
-		// C++׼ ȶ
-		template<class T = int> void StdStableSort(std::vector<T>& data_) {
-			if (data_.size() < 2) {
+		// C++标准库 稳定排序
+		template<class T = int> void StdStableSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			if (data_.size() < 2 || stop_token_.stop_requested()) {
 				return;
 			}
 			std::stable_sort(data_.begin(), data_.end());
 		}
 
-		// C++׼  + 
-		template<class T = int> void StdHeapSort(std::vector<T>& data_) {
-			if (data_.size() < 2) {
+		// C++标准库 建堆 + 堆排序
+		template<class T = int> void StdHeapSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			if (data_.size() < 2 || stop_token_.stop_requested()) {
 				return;
 			}
 			std::make_heap(data_.begin(), data_.end());
+			if (stop_token_.stop_requested()) {
+				return;
+			}
 			std::sort_heap(data_.begin(), data_.end());
 		}
 
-		// C++׼ Partial 
-		template<class T = int> void StdPartialSort(std::vector<T>& data_) {
-			if (data_.size() < 2) {
+		// C++标准库 Partial 排序
+		template<class T = int> void StdPartialSort(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
+			if (data_.size() < 2 || stop_token_.stop_requested()) {
 				return;
 			}
 			std::partial_sort(data_.begin(), data_.end(), data_.end());
 		}
 
-		// C++׼򣨲У̳߳Ƶ Strip::st_scopeGuard ڳʱȫStrip ɫ
-		template<class T = int> void StdSort_Parallel(std::vector<T>& data_) {
+		// C++标准库排序（并行：线程池中每个任务 std::sort 一段，再逐轮两两 std::merge 到另一个数组；
+		// 每轮把各对的合并结果按位置切开（见 ParallelMergeSorter::CoRank），任务数始终不少于段数，最后一轮也是并行的）
+		template<class T = int> void StdSort_Parallel(std::vector<T>& data_, std::stop_token stop_token_ = {}) {
 			if (data_.size() < 2) {
 				return;
 			}
-			std::sort(std::execution::par, data_.begin(), data_.end());
+			// 段数取工作线程数的两倍，数据量小时也能分给所有线程；段长不小于 minChunkSize，Strip 版本的段可以更小
+			constexpr size_t minChunkSize = ElementTraits<T>::IsDrawn ? 16 : 256;
+			size_t dataSize = data_.size();
+			size_t chunkNum = std::clamp(GetThreadPool().GetWorkerNum() * 2, static_cast<size_t>(1),
+				(std::max)(dataSize / minChunkSize, static_cast<size_t>(1)));
+			auto chunkBegin = [dataSize, chunkNum](size_t chunk_index_) {
+				return static_cast<ptrdiff_t>(dataSize * (std::min)(chunk_index_, chunkNum) / chunkNum);
+				};
+			GetThreadPool().ParallelFor(0, chunkNum, 1, [&data_, &chunkBegin, &stop_token_](size_t begin_, size_t end_) {
+				for (size_t chunkIndex = begin_; chunkIndex < end_ && !stop_token_.stop_requested(); ++chunkIndex) {
+					std::sort(data_.begin() + chunkBegin(chunkIndex), data_.begin() + chunkBegin(chunkIndex + 1));
+				}
+			});
+			if (chunkNum == 1) {
+				return;
+			}
+			std::vector<T> buffer(dataSize);
+			// 缓冲区与原数组地位相同，见 ElementTraits::MarkAsArray
+			ElementTraits<T>::MarkAsArray(buffer);
+			// 每轮从 source 合并到 target，源数组不被改写，中途停止时 source 仍是完整的数据
+			std::vector<T>* source = &data_;
+			std::vector<T>* target = &buffer;
+			for (size_t width = 1; width < chunkNum && !stop_token_.stop_requested(); width *= 2) {
+				size_t pairNum = (chunkNum + 2 * width - 1) / (2 * width);
+				size_t pieceNum = (chunkNum + pairNum - 1) / pairNum;
+				GetThreadPool().ParallelFor(0, pairNum * pieceNum, 1, [&](size_t begin_, size_t end_) {
+					for (size_t taskIndex = begin_; taskIndex < end_ && !stop_token_.stop_requested(); ++taskIndex) {
+						size_t firstChunk = taskIndex / pieceNum * 2 * width;
+						size_t pieceIndex = taskIndex % pieceNum;
+						ptrdiff_t leftBegin = chunkBegin(firstChunk);
+						ptrdiff_t middle = chunkBegin(firstChunk + width);
+						ptrdiff_t rightEnd = chunkBegin(firstChunk + 2 * width);
+						// 这一份负责合并结果中的 [pieceBegin, pieceEnd)
+						ptrdiff_t pieceBegin = (rightEnd - leftBegin) * static_cast<ptrdiff_t>(pieceIndex) / static_cast<ptrdiff_t>(pieceNum);
+						ptrdiff_t pieceEnd = (rightEnd - leftBegin) * static_cast<ptrdiff_t>(pieceIndex + 1) / static_cast<ptrdiff_t>(pieceNum);
+						ptrdiff_t leftNumBegin = ParallelMergeSorter<T>::CoRank(*source, leftBegin, middle, middle, rightEnd, pieceBegin);
+						ptrdiff_t leftNumEnd = ParallelMergeSorter<T>::CoRank(*source, leftBegin, middle, middle, rightEnd, pieceEnd);
+						std::merge(source->begin() + leftBegin + leftNumBegin, source->begin() + leftBegin + leftNumEnd,
+							source->begin() + middle + (pieceBegin - leftNumBegin), source->begin() + middle + (pieceEnd - leftNumEnd),
+							target->begin() + leftBegin + pieceBegin);
+					}
+				});
+				if (stop_token_.stop_requested()) {
+					break;
+				}
+				std::swap(source, target);
+			}
+			if (source != &data_) {
+				GetThreadPool().ParallelFor(0, chunkNum, 1, [&data_, &buffer, &chunkBegin](size_t begin_, size_t end_) {
+					std::copy(buffer.begin() + chunkBegin(begin_), buffer.begin() + chunkBegin(end_), data_.begin() + chunkBegin(begin_));
+				});
+			}
+		}
+
+		// 以下是逐步执行的协程版本（见 SortSteps.h），只排 int；Mode 为 StepwiseMode 时每一步 co_yield 一条记录，
+		// 为 RunToEndMode 时只在局部变量 stepNum 中计数，每一轮检查一次停止请求，结束时写回
+		// 与上面的模板版本是同一个算法，但比较、写入都显式写出，步数与 Tracer 版本的记录数不一定相同
+
+		// 冒泡排序（逐步）
+		template<typename Mode> SortSteps BubbleSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			for (ptrdiff_t i = 0; i < dataSize; ++i) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				bool noSwapped = true;
+				for (ptrdiff_t j = 0; j < dataSize - i - 1; ++j) {
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(j, j + 1, data_[j + 1]));
+					if (data_[j] > data_[j + 1]) {
+						std::swap(data_[j], data_[j + 1]);
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(j, j + 1, data_[j]));
+						noSwapped = false;
+					}
+				}
+				if (noSwapped) {
+					break;
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+		// 选择排序（逐步）
+		template<typename Mode> SortSteps SelectionSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			for (ptrdiff_t i = 0; i < dataSize - 1; ++i) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				ptrdiff_t minValuePos = i;
+				for (ptrdiff_t j = i + 1; j < dataSize; ++j) {
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(j, minValuePos, data_[minValuePos]));
+					if (data_[j] < data_[minValuePos]) {
+						minValuePos = j;
+					}
+				}
+				if (minValuePos != i) {
+					std::swap(data_[i], data_[minValuePos]);
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(i, minValuePos, data_[i]));
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+		// 插入排序（逐步，逐个后移而不是二分查找，每次后移都是一步）
+		template<typename Mode> SortSteps InsertionSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			for (ptrdiff_t i = 1; i < dataSize; ++i) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				int key = data_[i];
+				VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Read(i, key));
+				ptrdiff_t j = i;
+				while (j > 0) {
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(j - 1, TraceNoIndex, key));
+					if (!(key < data_[j - 1])) {
+						break;
+					}
+					data_[j] = data_[j - 1];
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(j, j - 1, data_[j]));
+					--j;
+				}
+				if (j != i) {
+					data_[j] = key;
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(j, TraceNoIndex, key));
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+		// 希尔排序（逐步，Ciura 增量序列）
+		template<typename Mode> SortSteps ShellSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			constexpr std::array<ptrdiff_t, 8> gaps = { 701, 301, 132, 57, 23, 10, 4, 1 };
+			for (ptrdiff_t gap : gaps) {
+				if (gap >= dataSize) {
+					continue;
+				}
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				for (ptrdiff_t i = gap; i < dataSize; ++i) {
+					int temp = data_[i];
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Read(i, temp));
+					ptrdiff_t j = i;
+					while (j >= gap) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(j - gap, TraceNoIndex, temp));
+						if (!(data_[j - gap] > temp)) {
+							break;
+						}
+						data_[j] = data_[j - gap];
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(j, j - gap, data_[j]));
+						j -= gap;
+					}
+					if (j != i) {
+						data_[j] = temp;
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(j, TraceNoIndex, temp));
+					}
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+		// 堆排序（逐步）：建堆与逐个取出共用同一段下沉代码，协程里不能把 co_yield 放进普通的辅助函数
+		template<typename Mode> SortSteps HeapSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			ptrdiff_t start = dataSize / 2;
+			ptrdiff_t heapSize = dataSize;
+			while (dataSize > 1) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				// start 从 dataSize / 2 - 1 递减到 0 时建堆，之后每次把堆顶换到末尾再从 0 下沉
+				if (start > 0) {
+					--start;
+				}
+				else {
+					if (--heapSize == 0) {
+						break;
+					}
+					std::swap(data_[0], data_[heapSize]);
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(0, heapSize, data_[0]));
+				}
+				ptrdiff_t index = start;
+				while (true) {
+					ptrdiff_t largestIndex = index;
+					ptrdiff_t leftIndex = 2 * index + 1;
+					ptrdiff_t rightIndex = leftIndex + 1;
+					if (leftIndex < heapSize) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(leftIndex, largestIndex, data_[largestIndex]));
+						if (data_[leftIndex] > data_[largestIndex]) {
+							largestIndex = leftIndex;
+						}
+					}
+					if (rightIndex < heapSize) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(rightIndex, largestIndex, data_[largestIndex]));
+						if (data_[rightIndex] > data_[largestIndex]) {
+							largestIndex = rightIndex;
+						}
+					}
+					if (largestIndex == index) {
+						break;
+					}
+					std::swap(data_[index], data_[largestIndex]);
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(index, largestIndex, data_[index]));
+					index = largestIndex;
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+		// 快速排序（逐步，与 QuickSort 相同的划分方式）
+		template<typename Mode> SortSteps QuickSortSteps(std::vector<int>& data_, Mode mode_) {
+			if (data_.size() < 2) {
+				co_return;
+			}
+			size_t stepNum = 0;
+			std::vector<std::pair<ptrdiff_t, ptrdiff_t>> localStack;
+			localStack.push_back({ static_cast<ptrdiff_t>(0), static_cast<ptrdiff_t>(data_.size()) - 1 });
+			while (!localStack.empty()) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				auto [leftIndex, rightIndex] = localStack.back();
+				localStack.pop_back();
+				if (leftIndex >= rightIndex) {
+					continue;
+				}
+				ptrdiff_t i = leftIndex;
+				ptrdiff_t j = rightIndex;
+				int base = data_[leftIndex];
+				VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Read(leftIndex, base));
+				while (i < j) {
+					while (i < j) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(j, TraceNoIndex, base));
+						if (data_[j] < base) {
+							break;
+						}
+						--j;
+					}
+					while (i < j) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(i, TraceNoIndex, base));
+						if (data_[i] > base) {
+							break;
+						}
+						++i;
+					}
+					if (i < j) {
+						std::swap(data_[i], data_[j]);
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(i, j, data_[i]));
+					}
+				}
+				if (i != leftIndex) {
+					std::swap(data_[i], data_[leftIndex]);
+					VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Swap(i, leftIndex, data_[i]));
+				}
+				// 先处理较短的区间以减少栈深度
+				if (i - leftIndex < rightIndex - i) {
+					localStack.push_back({ i + 1, rightIndex });
+					localStack.push_back({ leftIndex, i - 1 });
+				}
+				else {
+					localStack.push_back({ leftIndex, i - 1 });
+					localStack.push_back({ i + 1, rightIndex });
+				}
+			}
+			mode_.SetStepNum(stepNum);
 		}
 
+		// 归并排序（逐步，自底向上；左半部分先拷贝到缓冲区，缓冲区不在数组中，从它写回记为来源 TraceNoIndex）
+		template<typename Mode> SortSteps MergeSortSteps(std::vector<int>& data_, Mode mode_) {
+			size_t stepNum = 0;
+			ptrdiff_t dataSize = static_cast<ptrdiff_t>(data_.size());
+			std::vector<int> buffer(data_.size()); // 自底向上时左半部分最长可达 dataSize - 1
+			for (ptrdiff_t width = 1; width < dataSize; width *= 2) {
+				if (mode_.GetIsStopRequested()) {
+					break;
+				}
+				for (ptrdiff_t leftIndex = 0; leftIndex < dataSize - width; leftIndex += 2 * width) {
+					ptrdiff_t middleIndex = leftIndex + width;
+					ptrdiff_t rightEnd = (std::min)(leftIndex + 2 * width, dataSize);
+					ptrdiff_t bufferSize = middleIndex - leftIndex;
+					for (ptrdiff_t i = leftIndex; i < middleIndex; ++i) {
+						buffer[i - leftIndex] = data_[i];
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Read(i, data_[i]));
+					}
+					ptrdiff_t bufferIndex = 0;
+					ptrdiff_t dataIndex = middleIndex;
+					ptrdiff_t targetIndex = leftIndex;
+					while (bufferIndex < bufferSize && dataIndex < rightEnd) {
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Compare(dataIndex, TraceNoIndex, buffer[bufferIndex]));
+						if (data_[dataIndex] < buffer[bufferIndex]) {
+							data_[targetIndex] = data_[dataIndex];
+							VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(targetIndex, dataIndex, data_[targetIndex]));
+							++dataIndex;
+						}
+						else {
+							data_[targetIndex] = buffer[bufferIndex++];
+							VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(targetIndex, TraceNoIndex, data_[targetIndex]));
+						}
+						++targetIndex;
+					}
+					while (bufferIndex < bufferSize) {
+						data_[targetIndex] = buffer[bufferIndex++];
+						VISUALSORT_SORT_STEP(Mode, stepNum, SortSteps::Write(targetIndex, TraceNoIndex, data_[targetIndex]));
+						++targetIndex;
+					}
+				}
+			}
+			mode_.SetStepNum(stepNum);
+		}
+
+	}
+
+	// 注册排序时依次给出 int、Counter、Strip、Tracer 四个版本（无界面模式下没有 Strip，Strip 版本置空）
+#ifdef VISUALSORT_HEADLESS
+#define VISUALSORT_SORT_FUNCS(sort_func_) sort_func_<int>, sort_func_<Counter>, nullptr, sort_func_<Tracer>
+#else
+#define VISUALSORT_SORT_FUNCS(sort_func_) sort_func_<int>, sort_func_<Counter>, sort_func_<Strip>, sort_func_<Tracer>
+#endif
+
+	// 注册逐步排序时给出同一个协程的逐步执行与执行到底两种实例化（见 Sort::SetStepSortFunc）
+#define VISUALSORT_STEP_SORT_FUNCS(step_sort_func_) step_sort_func_<StepwiseMode>, step_sort_func_<RunToEndMode>
+
+	// 默认注册的全部排序（VisualSort 与无界面基准测试共用这一份列表）
+	inline std::vector<Sort> CreateDefaultSorts() {
+		using namespace NSortAlgorithms;
+		return {
+			Sort(L"猴子排序",8,VISUALSORT_SORT_FUNCS(BogoSort),{},true),
+			Sort(L"臭皮匠排序",64,VISUALSORT_SORT_FUNCS(StoogeSort)),
+			Sort(L"睡眠排序",128,VISUALSORT_SORT_FUNCS(SleepSort),{},true),
+			Sort(L"循环排序",256,VISUALSORT_SORT_FUNCS(CycleSort)),
+			Sort(L"冒泡排序",256,VISUALSORT_SORT_FUNCS(BubbleSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(BubbleSortSteps)),
+			Sort(L"双向冒泡排序",256,VISUALSORT_SORT_FUNCS(BidirectionalBubbleSort)),
+			Sort(L"奇偶排序",256,VISUALSORT_SORT_FUNCS(OddEvenSort)),
+			Sort(L"选择排序",256,VISUALSORT_SORT_FUNCS(SelectionSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(SelectionSortSteps)),
+			Sort(L"双向选择排序",256,VISUALSORT_SORT_FUNCS(BidirectionalSelectionSort)),
+			Sort(L"插入排序",256,VISUALSORT_SORT_FUNCS(InsertionSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(InsertionSortSteps)),
+			Sort(L"珠排序",256,VISUALSORT_SORT_FUNCS(BeadSort)),
+			Sort(L"梳排序",8192,VISUALSORT_SORT_FUNCS(CombSort)),
+			Sort(L"希尔排序",8192,VISUALSORT_SORT_FUNCS(ShellSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(ShellSortSteps)),
+			Sort(L"双调排序",8192,VISUALSORT_SORT_FUNCS(BitonicSort),
+				{{L"数据量必须为2的正整数次幂",[](size_t data_size_)->bool { return ((data_size_ & (data_size_ - 1)) == 0) && data_size_ > 0; }}}),
+			Sort(L"归并排序",8192,VISUALSORT_SORT_FUNCS(MergeSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(MergeSortSteps)),
+			Sort(L"并行归并排序",8192,VISUALSORT_SORT_FUNCS(ParallelMergeSort),{},false,true),
+			Sort(L"堆排序",8192,VISUALSORT_SORT_FUNCS(HeapSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(HeapSortSteps)),
+			Sort(L"快速排序",8192,VISUALSORT_SORT_FUNCS(QuickSort)).SetStepSortFunc(VISUALSORT_STEP_SORT_FUNCS(QuickSortSteps)),
+			Sort(L"模式消除快速排序",8192,VISUALSORT_SORT_FUNCS(PdqSort)),
+			Sort(L"基数排序",8192,VISUALSORT_SORT_FUNCS(RadixSort)),
+			Sort(L"计数排序",32768,VISUALSORT_SORT_FUNCS(CountingSort)),
+			Sort(L"std::sort",8192,VISUALSORT_SORT_FUNCS(StdSort)),
+			Sort(L"并行std::sort",8192,VISUALSORT_SORT_FUNCS(StdSort_Parallel),{},false,true),
+			Sort(L"std::stable_sort",8192,VISUALSORT_SORT_FUNCS(StdStableSort)),
+			Sort(L"std::sort_heap",8192,VISUALSORT_SORT_FUNCS(StdHeapSort)),
+			Sort(L"std::partial_sort",8192,VISUALSORT_SORT_FUNCS(StdPartialSort))
+		};
 	}
 
 }
\ No newline at end of file
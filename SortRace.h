@@ -0,0 +1,221 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <vector>
+#include "FrameBuffer.h"
+#include "ScopeGuard.h"
+#include "Sort.h"
+#include "ThreadPool.h"
+#include "TraceRenderer.h"
+#include "Tracer.h"
+#include "WideError.h"
+
+namespace NVisualSort {
+
+	// 赛跑模式：画布分成 K 条跑道，每条跑道用同一份打乱的数据跑不同的排序，不依赖界面
+	// 先依次全速运行各排序的 Tracer 版本记录操作（Tracer 的记录状态是全局的，不能同时记录），再按帧同时回放：
+	// 每帧各跑道在线程池中各自执行同样条数的记录，并重绘自己改动过的条形（计数、布局与脏区都属于跑道自己，互不争用）；
+	// 之后由调用线程把这一帧改动过的跑道合成到同一块画布上，整帧只刷新一次
+	class SortRace {
+
+	public:
+
+		static constexpr int LaneGap = 4; // 跑道之间的间隔（像素）
+
+		struct Lane {
+			std::wstring sortName;
+			size_t sortIndex = 0;
+			TraceRecorder recorder;
+			std::unique_ptr<TraceRenderer> renderer; // 跑道自己的画布、列聚合与脏区
+			size_t position = 0;      // 下一条要回放的记录
+			int left = 0;             // 跑道（含标签）在画布上的位置
+			int top = 0;
+			int right = 0;
+			int labelBottom = 0;      // 标签区域的下边，条形从这里开始画
+			size_t compareNum = 0;    // 已回放的比较次数
+			size_t changeNum = 0;     // 已回放的写入与交换次数
+			size_t finishFrame = 0;   // 回放完的那一帧，没回放完为 0
+			size_t place = 0;         // 名次（从 1 开始，同一帧回放完的名次相同），没回放完为 0
+			bool isChanged = true;    // 这一帧是否重绘过，合成时只拷贝重绘过的跑道
+
+			bool GetIsFinished() const noexcept {
+				return this->place != 0;
+			}
+		};
+
+	private:
+
+		std::vector<int> m_data;
+		std::vector<std::unique_ptr<Lane>> m_lanes; // 记录器不能移动，跑道放在堆上
+		size_t m_frameNum = 0;
+		size_t m_finishedNum = 0;
+
+		// 执行一帧的记录并重绘改动过的条形，只访问这条跑道自己的数据，可以与其它跑道同时执行
+		void StepLane(Lane& lane_, size_t operation_num_) {
+			if (lane_.GetIsFinished()) {
+				lane_.isChanged = false;
+				return;
+			}
+			size_t recordNum = lane_.recorder.GetRecordNum();
+			size_t frameEnd = (std::min)(recordNum, lane_.position + operation_num_);
+			for (; lane_.position < frameEnd; ++lane_.position) {
+				const TraceRecord& record = lane_.recorder.GetRecord(lane_.position);
+				if (record.opcode == TraceOpcode::Compare) {
+					++lane_.compareNum;
+				}
+				else if (record.opcode == TraceOpcode::Write || record.opcode == TraceOpcode::Swap) {
+					++lane_.changeNum;
+				}
+				lane_.renderer->ApplyRecord(record);
+			}
+			if (lane_.position == recordNum) {
+				lane_.renderer->ClearHighlights(); // 最后一帧恢复原色
+				lane_.finishFrame = this->m_frameNum;
+			}
+			lane_.isChanged = lane_.renderer->RenderFrame() > 0 || lane_.finishFrame != 0;
+		}
+
+	public:
+
+		// 默认参赛的六个 O(n log n) 排序，界面最大数据量都是 8192
+		static std::vector<std::wstring> GetDefaultSortNames() {
+			return { L"归并排序", L"堆排序", L"快速排序", L"模式消除快速排序", L"std::sort", L"std::stable_sort" };
+		}
+
+		// 按名称查找排序的下标
+		static std::vector<size_t> FindSortIndices(const std::vector<Sort>& sorts_, const std::vector<std::wstring>& sort_names_) {
+			std::vector<size_t> sortIndices;
+			for (const std::wstring& sortName : sort_names_) {
+				auto it = std::find_if(sorts_.begin(), sorts_.end(), [&sortName](const Sort& sort_) {
+					return sort_.GetSortName() == sortName;
+				});
+				if (it == sorts_.end()) {
+					throw WideError(L"找不到排序：" + sortName);
+				}
+				sortIndices.push_back(static_cast<size_t>(it - sorts_.begin()));
+			}
+			return sortIndices;
+		}
+
+		// 跑道按网格排列（列数为跑道数的平方根向上取整），每条跑道顶部留 label_height_ 像素给标签（由调用方绘制）
+		SortRace(const std::vector<Sort>& sorts_, const std::vector<size_t>& sort_indices_, const std::vector<int>& data_,
+			int width_, int height_, int label_height_ = 0, uint32_t background_color_ = 0) : m_data(data_) {
+			if (sort_indices_.empty()) {
+				throw WideError(L"赛跑至少需要一个排序！");
+			}
+			if (data_.empty()) {
+				throw WideError(L"赛跑的数据为空！");
+			}
+			size_t columnNum = 1;
+			while (columnNum * columnNum < sort_indices_.size()) {
+				++columnNum;
+			}
+			size_t rowNum = (sort_indices_.size() + columnNum - 1) / columnNum;
+			for (size_t laneIndex = 0; laneIndex < sort_indices_.size(); ++laneIndex) {
+				size_t sortIndex = sort_indices_[laneIndex];
+				if (sortIndex >= sorts_.size()) {
+					throw WideError(L"找不到排序");
+				}
+				for (const NumRequire& numRequire : sorts_[sortIndex].GetNumRequires()) {
+					if (!numRequire.Check(data_.size())) {
+						throw WideError(sorts_[sortIndex].GetSortName() + L"：" + numRequire.GetRequireInform());
+					}
+				}
+				auto lane = std::make_unique<Lane>();
+				lane->sortName = sorts_[sortIndex].GetSortName();
+				lane->sortIndex = sortIndex;
+				size_t column = laneIndex % columnNum;
+				size_t row = laneIndex / columnNum;
+				lane->left = static_cast<int>(column * width_ / columnNum);
+				lane->top = static_cast<int>(row * height_ / rowNum);
+				lane->right = static_cast<int>((column + 1) * width_ / columnNum) - SortRace::LaneGap;
+				lane->labelBottom = lane->top + label_height_;
+				int bottom = static_cast<int>((row + 1) * height_ / rowNum) - SortRace::LaneGap;
+				lane->renderer = std::make_unique<TraceRenderer>(lane->right - lane->left, bottom - lane->labelBottom, data_, background_color_);
+				this->m_lanes.push_back(std::move(lane));
+			}
+		}
+		SortRace(const SortRace&) = delete;
+		SortRace& operator=(const SortRace&) = delete;
+
+		// 依次记录各跑道的排序；停止令牌请求停止时返回 false，排序结果不对时抛出异常
+		bool Record(std::vector<Sort>& sorts_, std::stop_token stop_token_ = {}) {
+			std::vector<Tracer> tracerSortData;
+			for (std::unique_ptr<Lane>& lane : this->m_lanes) {
+				{
+					Tracer::StartTracing(this->m_data, tracerSortData, lane->recorder, sorts_[lane->sortIndex].GetIsCallingThreadOnly());
+					ScopeGuard stopTracing([]() {
+						Tracer::StopTracing();
+					});
+					sorts_[lane->sortIndex].RunSort(tracerSortData, stop_token_);
+				}
+				if (stop_token_.stop_requested()) {
+					return false;
+				}
+				if (!std::is_sorted(tracerSortData.begin(), tracerSortData.end(), [](const Tracer& a_, const Tracer& b_) {
+					return a_.GetValue() < b_.GetValue();
+				})) {
+					throw WideError(lane->sortName + L"排序结果错误！");
+				}
+			}
+			return true;
+		}
+
+		// 所有跑道各执行 operation_num_ 条记录并重绘，各跑道在线程池中同时执行；返回是否全部回放完
+		bool StepFrame(size_t operation_num_) {
+			++this->m_frameNum;
+			GetThreadPool().ParallelFor(0, this->m_lanes.size(), 1, [this, operation_num_](size_t begin_, size_t end_) {
+				for (size_t laneIndex = begin_; laneIndex < end_; ++laneIndex) {
+					this->StepLane(*this->m_lanes[laneIndex], operation_num_);
+				}
+			});
+			size_t place = this->m_finishedNum + 1;
+			for (std::unique_ptr<Lane>& lane : this->m_lanes) {
+				if (lane->finishFrame == this->m_frameNum) {
+					lane->place = place;
+					++this->m_finishedNum;
+				}
+			}
+			return this->GetIsFinished();
+		}
+
+		// 把这一帧重绘过的跑道交给 draw_func_(跑道画布, 左, 上) 合成，只能在 StepFrame 之间调用
+		template<typename Func>
+		void ForEachChangedLane(Func&& draw_func_) const {
+			for (const std::unique_ptr<Lane>& lane : this->m_lanes) {
+				if (lane->isChanged) {
+					draw_func_(lane->renderer->GetFrameBuffer(), lane->left, lane->labelBottom);
+				}
+			}
+		}
+
+		// 合成到一块内存画布上（无界面渲染与导出）
+		void Composite(FrameBuffer& canvas_) const {
+			this->ForEachChangedLane([&canvas_](const FrameBuffer& lane_frame_buffer_, int left_, int top_) {
+				canvas_.CopyFrom(lane_frame_buffer_, left_, top_);
+			});
+		}
+
+		bool GetIsFinished() const noexcept {
+			return this->m_finishedNum == this->m_lanes.size();
+		}
+
+		size_t GetFrameNum() const noexcept {
+			return this->m_frameNum;
+		}
+
+		size_t GetLaneNum() const noexcept {
+			return this->m_lanes.size();
+		}
+
+		const Lane& GetLane(size_t lane_index_) const {
+			return *this->m_lanes[lane_index_];
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stop_token>
+#include <utility>
+#include "Tracer.h"
+
+namespace NVisualSort {
+
+	// 逐步排序函数的模板参数：决定每一步是 co_yield 一条记录并挂起，还是只计数
+	// 逐步执行：每一步构造一条记录、co_yield 并挂起，由 SortSteps::Next 驱动；不再调用 Next 就是停止
+	struct StepwiseMode {
+		static constexpr bool IsStepwise = true;
+		constexpr bool GetIsStopRequested() const noexcept {
+			return false;
+		}
+		void SetStepNum(size_t) const noexcept {}
+	};
+
+	// 执行到底：不构造记录、不挂起，协程一次 resume 就跑完，步数累加在排序函数的局部变量里，结束时写回 *stepNum；
+	// stopToken 在每一轮（外层循环）开始时检查，请求停止时数据处于未排完的状态
+	struct RunToEndMode {
+		static constexpr bool IsStepwise = false;
+		size_t* stepNum = nullptr;
+		std::stop_token stopToken;
+		bool GetIsStopRequested() const noexcept {
+			return this->stopToken.stop_requested();
+		}
+		void SetStepNum(size_t step_num_) const noexcept {
+			*this->stepNum = step_num_;
+		}
+	};
+
+	// 逐步排序中的一步：StepwiseMode 下 co_yield record_，RunToEndMode 下只把局部变量 step_num_ 加一，record_ 不会被求值
+	// 计数器必须是排序函数的局部变量，经过引用或成员累加会让每一步都读写内存
+#define VISUALSORT_SORT_STEP(mode_, step_num_, record_) \
+	if constexpr (mode_::IsStepwise) { co_yield record_; } else { ++step_num_; }
+
+	// 逐步执行的排序（C++20 协程）：排序直接操作 std::vector<int>，每次比较、读取、写入、交换后 co_yield 一条 TraceRecord 并挂起
+	// 驱动方每调用一次 Next 就执行一步，可以每帧执行 N 步、在同一个线程里交替推进多个排序，不需要睡眠的排序线程；
+	// 记录的含义与 Tracer 相同，可以直接交给 TraceReplayer::ApplyRecord、Strip::ApplyRecord 或 TraceRenderer；
+	// 不再调用 Next 就是取消，析构时协程帧一并销毁。协程引用传入的数组，执行完之前数组不能被销毁或重新分配
+	// 排序函数写成以 StepwiseMode / RunToEndMode 为参数的模板，RunToEndMode 的实例化没有挂起点，见 Sort::RunStepSortToEnd
+	class SortSteps {
+
+	public:
+
+		struct promise_type {
+
+			TraceRecord record;
+			std::exception_ptr exception;
+			size_t stepNum = 0;
+
+			SortSteps get_return_object() noexcept {
+				return SortSteps(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			std::suspend_always initial_suspend() noexcept {
+				return {};
+			}
+			std::suspend_always final_suspend() noexcept {
+				return {};
+			}
+			std::suspend_always yield_value(const TraceRecord& record_) noexcept {
+				this->record = record_;
+				++this->stepNum;
+				return {};
+			}
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept {
+				this->exception = std::current_exception();
+			}
+
+		};
+
+	private:
+
+		std::coroutine_handle<promise_type> m_handle;
+
+		explicit SortSteps(std::coroutine_handle<promise_type> handle_) noexcept : m_handle(handle_) {}
+
+		static TraceRecord MakeRecord(TraceOpcode opcode_, size_t index_a_, size_t index_b_, int value_) noexcept {
+			TraceRecord record;
+			record.opcode = opcode_;
+			record.indexA = static_cast<uint32_t>(index_a_);
+			record.indexB = static_cast<uint32_t>(index_b_);
+			record.value = value_;
+			return record;
+		}
+
+	public:
+
+		// 排序算法中 co_yield 的记录，各字段的含义见 TraceOpcode；不在数组中的一方（临时变量、缓冲区）用 TraceNoIndex
+		static TraceRecord Compare(size_t index_a_, size_t index_b_, int value_) noexcept {
+			return SortSteps::MakeRecord(TraceOpcode::Compare, index_a_, index_b_, value_);
+		}
+		static TraceRecord Read(size_t index_, int value_) noexcept {
+			return SortSteps::MakeRecord(TraceOpcode::Read, index_, TraceNoIndex, value_);
+		}
+		static TraceRecord Write(size_t index_, size_t source_index_, int value_) noexcept {
+			return SortSteps::MakeRecord(TraceOpcode::Write, index_, source_index_, value_);
+		}
+		static TraceRecord Swap(size_t index_a_, size_t index_b_, int value_) noexcept {
+			return SortSteps::MakeRecord(TraceOpcode::Swap, index_a_, index_b_, value_);
+		}
+
+		SortSteps() noexcept = default;
+		SortSteps(const SortSteps&) = delete;
+		SortSteps(SortSteps&& other_) noexcept : m_handle(std::exchange(other_.m_handle, nullptr)) {}
+		SortSteps& operator=(const SortSteps&) = delete;
+		SortSteps& operator=(SortSteps&& other_) noexcept {
+			if (this != &other_) {
+				if (this->m_handle) {
+					this->m_handle.destroy();
+				}
+				this->m_handle = std::exchange(other_.m_handle, nullptr);
+			}
+			return *this;
+		}
+		~SortSteps() {
+			if (this->m_handle) {
+				this->m_handle.destroy();
+			}
+		}
+
+		// 执行一步，排序已经结束时返回 false；排序中抛出的异常在这里重新抛出
+		bool Next() {
+			if (!this->m_handle || this->m_handle.done()) {
+				return false;
+			}
+			this->m_handle.resume();
+			if (this->m_handle.promise().exception) {
+				std::rethrow_exception(std::exchange(this->m_handle.promise().exception, nullptr));
+			}
+			return !this->m_handle.done();
+		}
+
+		// 最近一次 Next 返回 true 时执行的那一步
+		const TraceRecord& GetRecord() const noexcept {
+			return this->m_handle.promise().record;
+		}
+
+		bool GetIsDone() const noexcept {
+			return !this->m_handle || this->m_handle.done();
+		}
+
+		// 已经执行的步数（StepwiseMode）
+		size_t GetStepNum() const noexcept {
+			return this->m_handle ? this->m_handle.promise().stepNum : 0;
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+#include "Sort.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stop_token>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 多次计时的统计结果（不含预热）
+	class SortTiming {
+
+		friend class SortTimer;
+
+	private:
+
+		size_t m_dataSize = 0; // 数据量
+		std::vector<std::chrono::nanoseconds> m_durations; // 每次计时的耗时（升序）
+
+		// 最近秩法求百分位数
+		std::chrono::nanoseconds GetPercentile(double percent_) const noexcept {
+			if (this->m_durations.empty()) {
+				return std::chrono::nanoseconds(0);
+			}
+			size_t rank = static_cast<size_t>(std::ceil(percent_ / 100 * this->m_durations.size()));
+			return this->m_durations[(std::max)(rank, static_cast<size_t>(1)) - 1];
+		}
+
+	public:
+
+		size_t GetDataSize() const noexcept {
+			return this->m_dataSize;
+		}
+
+		// 实际计时次数
+		size_t GetRunNum() const noexcept {
+			return this->m_durations.size();
+		}
+
+		std::chrono::nanoseconds GetMin() const noexcept {
+			return this->m_durations.empty() ? std::chrono::nanoseconds(0) : this->m_durations.front();
+		}
+
+		std::chrono::nanoseconds GetMedian() const noexcept {
+			return this->GetPercentile(50);
+		}
+
+		std::chrono::nanoseconds GetMax() const noexcept {
+			return this->m_durations.empty() ? std::chrono::nanoseconds(0) : this->m_durations.back();
+		}
+
+		// 计时次数足够时第 percent_ 百分位数才有意义：至少要有一次计时落在它之上，否则它就是最大值（P95 要 20 次，P99 要 100 次）
+		bool GetHasPercentile(double percent_) const noexcept {
+			return this->m_durations.size() * (100 - percent_) >= 100;
+		}
+
+		std::chrono::nanoseconds GetP95() const noexcept {
+			return this->GetPercentile(95);
+		}
+
+		std::chrono::nanoseconds GetP99() const noexcept {
+			return this->GetPercentile(99);
+		}
+
+		std::chrono::nanoseconds GetMean() const noexcept {
+			if (this->m_durations.empty()) {
+				return std::chrono::nanoseconds(0);
+			}
+			std::chrono::nanoseconds total(0);
+			for (const auto& duration : this->m_durations) {
+				total += duration;
+			}
+			return total / static_cast<long long>(this->m_durations.size());
+		}
+
+		// 吞吐量（按中位数计算，元素/秒）
+		double GetElementsPerSecond() const noexcept {
+			long long median = this->GetMedian().count();
+			return median > 0 ? static_cast<double>(this->m_dataSize) * 1e9 / median : 0.0;
+		}
+
+		// 每个元素的耗时（按中位数计算，纳秒）
+		double GetNsPerElement() const noexcept {
+			return this->m_dataSize > 0 ? static_cast<double>(this->GetMedian().count()) / this->m_dataSize : 0.0;
+		}
+
+	};
+
+	// int 版本排序的计时器：先预热，再在同一份源数据的新拷贝上重复计时
+	class SortTimer {
+
+	private:
+
+		size_t m_warmupNum = 1; // 预热次数
+		size_t m_runNum = 100; // 计时次数（满 100 次才有 P99，慢的排序由总时长提前结束）
+		std::chrono::milliseconds m_timeBudget = std::chrono::milliseconds(300); // 计时总时长超过它就提前结束（至少计时一次）
+
+	public:
+
+		SortTimer() = default;
+		SortTimer(size_t warmup_num_, size_t run_num_, std::chrono::milliseconds time_budget_)
+			: m_warmupNum(warmup_num_), m_runNum((std::max)(run_num_, static_cast<size_t>(1))), m_timeBudget(time_budget_) {
+		}
+
+		SortTimer& SetWarmupNum(size_t warmup_num_) noexcept {
+			this->m_warmupNum = warmup_num_;
+			return *this;
+		}
+		size_t GetWarmupNum() const noexcept {
+			return this->m_warmupNum;
+		}
+
+		SortTimer& SetRunNum(size_t run_num_) noexcept {
+			this->m_runNum = (std::max)(run_num_, static_cast<size_t>(1));
+			return *this;
+		}
+		size_t GetRunNum() const noexcept {
+			return this->m_runNum;
+		}
+
+		SortTimer& SetTimeBudget(std::chrono::milliseconds time_budget_) noexcept {
+			this->m_timeBudget = time_budget_;
+			return *this;
+		}
+		std::chrono::milliseconds GetTimeBudget() const noexcept {
+			return this->m_timeBudget;
+		}
+
+		// 每次都从 source_data_ 拷贝一份新数据来排序，result_data_ 保存最后一次的排序结果
+		// stop_token_ 请求停止后立即结束，被中止的那一次不计入，result_data_ 可能没有排完
+		SortTiming Measure(Sort& sort_, const std::vector<int>& source_data_, std::vector<int>& result_data_, std::stop_token stop_token_ = {}) const {
+			SortTiming timing;
+			timing.m_dataSize = source_data_.size();
+			auto budgetBeginTime = std::chrono::steady_clock::now();
+			for (size_t warmupIndex = 0; warmupIndex < this->m_warmupNum; ++warmupIndex) {
+				result_data_ = source_data_;
+				sort_.RunSort(result_data_, stop_token_);
+				if (stop_token_.stop_requested()) {
+					return timing;
+				}
+				if (std::chrono::steady_clock::now() - budgetBeginTime > this->m_timeBudget) {
+					break;
+				}
+			}
+			budgetBeginTime = std::chrono::steady_clock::now();
+			timing.m_durations.reserve(this->m_runNum);
+			for (size_t runIndex = 0; runIndex < this->m_runNum; ++runIndex) {
+				result_data_ = source_data_;
+				auto startTime = std::chrono::steady_clock::now();
+				sort_.RunSort(result_data_, stop_token_);
+				auto endTime = std::chrono::steady_clock::now();
+				if (stop_token_.stop_requested()) {
+					break;
+				}
+				timing.m_durations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime));
+				if (endTime - budgetBeginTime > this->m_timeBudget) {
+					break;
+				}
+			}
+			std::sort(timing.m_durations.begin(), timing.m_durations.end());
+			return timing;
+		}
+
+	};
+
+}
\ No newline at end of file
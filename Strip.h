@@ -1,11 +1,16 @@
 #pragma once
 #include "ConfigManager.h"
 #include "DrawingTool.h"
+#include "DirtyIntervalSet.h"
+#include "ColumnAggregate.h"
 #include <chrono>
 #include <easyx.h>
 #include <optional>
 #include <atomic>
 #include <Windows.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <thread>
 #include <utility>
@@ -13,285 +18,484 @@
 #include "Fraction.h"
 #include "WideError.h"
 #include "ScopeGuard.h"
-#include <set>
-#include <mutex>
+#include "PauseGate.h"
+#include "ThreadPool.h"
+#include "ShardedCounter.h"
+#include "Element.h"
+#include "Tracer.h"
+#include "StripStyle.h"
 
 namespace NVisualSort {
 
-	// 0ʼ
-	inline std::atomic<size_t> StripCompareNum{0};  // Ƚϴ
-	inline std::atomic<size_t> StripCopyNum{0};     // ô
-	inline std::atomic<size_t> StripChangeNum{0};   // д
-	inline std::atomic<size_t> AnimationStepNum{0}; // 
-
-	constexpr COLORREF StripCopyColor = LIGHTBLUE;
-	constexpr COLORREF StripChangeColor = RED;
-	constexpr COLORREF StripFirstColor = RGB(0x88, 0x88, 0x88);
-	constexpr COLORREF StripLastColor = WHITE;
+	// 0常量初始化，按线程分片累加，显示时才求和
+	inline ShardedCounter StripCompareNum;  // 比较次数
+	inline ShardedCounter StripCopyNum;     // 引用次数
+	inline ShardedCounter StripChangeNum;   // 写入次数
+	inline ShardedCounter AnimationStepNum; // 动画步数
+
+	// 条形的布局缓存（见 Strip::s_layout）
+	struct StripLayout {
+		int height = 0;                // 窗口高度
+		int maxTop = 0;                // Strip::StripMaxTop()
+		std::vector<int> tops;         // 值 - 最小值 -> 条形顶端
+		std::vector<COLORREF> colors;  // 值 - 最小值 -> 条形颜色
+	};
 
-	constexpr const wchar_t* SortEndsPrematurely = L"ǰ";
+	constexpr const wchar_t* SortEndsPrematurely = L"排序提前结束";
 
-	// Σÿݶһ
-	class Strip {
+	// 绘制策略：条形，每个数据都是一个条形，演示数组中的条形参与的每次操作都绘制一步并统计
+	template<typename T>
+	class DrawPolicy {
 
 		friend class VisualSort;
 
 	private:
 
 		inline static std::chrono::milliseconds s_stripSortStopTime;
-		inline static std::atomic<bool> s_stopStripSort = false;
-		inline static std::atomic<bool> s_exitStripSort = false;
-
-		int m_value = 0;
-		int m_left = -1;
-		int m_right = -1;
-		int m_top = 0;
-		COLORREF m_color = BLACK;
-		bool m_notTemp = false;
+		inline static PauseGate s_pauseGate; // 暂停、继续、退出与打断（回放模式下拖动时间轴后需要立即跳转）都经过它
+
+		// 条形只存值（Element 中的 int），std::vector<Strip> 的内存布局与 std::vector<int> 相同
+		// 条形的位置、顶端与颜色按下标存放在下面几个数组中，排序算法搬动的只有值
+		// 正在演示的条形数组 [s_firstStrip, s_lastStrip) 由 InitValues 记录，地址不在其中的是临时条形（不绘制、不统计）
+		inline static const T* s_firstStrip = nullptr;
+		inline static const T* s_lastStrip = nullptr;
+		inline static std::vector<int> s_edges;       // 第 i 个条形的左右两边为 s_edges[i] 与 s_edges[i + 1]
+		inline static std::vector<int> s_tops;        // 条形顶端
+		inline static std::vector<COLORREF> s_colors; // 条形颜色
+		inline static constexpr size_t TempIndex = static_cast<size_t>(-1);
 
 		inline static int s_maxValue = 0;
 		inline static int s_minValue = 0;
 
-		struct Interval {
-			int left = 0;
-			int right = 0;
-			constexpr Interval() : Interval(0, 0) {}
-			constexpr Interval(int left_, int right_) noexcept : left(left_), right(right_) {}
-		};
+		// 布局缓存：每次 InitValues 按窗口大小与值域计算一次，之后每次操作只查表，不再做 Fraction 运算、也不再读 ConfigManager
+		// 窗口重建后（可能改变了大小）由 InvalidateLayout 清空，下次 InitValues 重新计算；排序过程中窗口大小不会改变
+		inline static StripLayout s_layout;
+		inline static constexpr size_t MaxLayoutTableSize = static_cast<size_t>(1) << 22; // 值域更大时不建表，直接计算
+
+		inline static thread_local DirtyIntervalSet st_dirtyIntervals; // 本线程画过但还没刷新到屏幕的条形
 
-		inline static thread_local size_t st_lastOperationNum = 0;
-		inline static thread_local Interval st_lastInterval1;
-		inline static thread_local std::pair<Interval, Interval> st_lastInterval2;
+		// 按列显示：回放模式下条形比像素列多时，每个像素列只画映射到它的条形的聚合（见 SetColumnMode）
+		inline static bool s_isColumnMode = false;
+		inline static ColumnAggregate s_columnAggregate;
 
 		inline static std::function<void()> s_sleepFunc;
 		inline static std::function<void(RECT, COLORREF)> s_drawFunc;
 		inline static std::function<void()> s_updateMessageFunc;
 
-		inline static std::set<std::thread::id> s_threads;
-		inline static std::mutex s_threadsMutex;
+		inline static std::atomic<size_t> s_drawThreadNum = 1; // 可能同时绘制的线程数（多线程排序时为线程池工作线程数加当前线程）
 		inline static std::thread::id s_mainThreadId = std::this_thread::get_id();
 		inline static bool s_isMulThreadSort = false;
 
 		static void InitValues() {
-			Strip::s_stripSortStopTime = std::chrono::milliseconds(0);
-			Strip::s_stopStripSort.store(false, std::memory_order_release);
-			Strip::s_exitStripSort.store(false, std::memory_order_release);
+			DrawPolicy::s_stripSortStopTime = std::chrono::milliseconds(0);
+			DrawPolicy::s_pauseGate.Reset();
+			DrawPolicy::s_isColumnMode = false;
 			StripCompareNum.store(0, std::memory_order_release);
 			StripCopyNum.store(0, std::memory_order_release);
 			StripChangeNum.store(0, std::memory_order_release);
 			AnimationStepNum.store(0, std::memory_order_release);
-			Strip::s_mainThreadId = std::this_thread::get_id();
-			std::thread::id this_id = Strip::s_mainThreadId;
-			std::erase_if(Strip::s_threads, [this_id](const auto& id) {
-				return id != this_id;
-			});
+			DrawPolicy::s_mainThreadId = std::this_thread::get_id();
+			DrawPolicy::s_drawThreadNum.store(1, std::memory_order_release);
 		}
 
-		static void InitValues(const std::vector<int> data_, std::vector<Strip>& strips_,
+		static void InitValues(const std::vector<int> data_, std::vector<T>& strips_,
 			const std::function<void()>& sleep_func_,
 			const std::function<void(RECT, COLORREF)>& draw_func_,
 			const std::function<void()>& update_message_func_,
 			bool is_mul_thread_sort_) {
-			Strip::InitValues();
-			Strip::s_sleepFunc = sleep_func_;
-			Strip::s_drawFunc = draw_func_;
-			Strip::s_updateMessageFunc = update_message_func_;
-			Strip::s_isMulThreadSort = is_mul_thread_sort_;
-			strips_.clear(); // ֱգresizeôvectorײܻḴstripӶ
+			DrawPolicy::InitValues();
+			DrawPolicy::s_sleepFunc = sleep_func_;
+			DrawPolicy::s_drawFunc = draw_func_;
+			DrawPolicy::s_updateMessageFunc = update_message_func_;
+			DrawPolicy::s_isMulThreadSort = is_mul_thread_sort_;
+			DrawPolicy::s_drawThreadNum.store(is_mul_thread_sort_ ? GetThreadPool().GetWorkerNum() + 1 : 1, std::memory_order_release);
+			strips_.clear(); // 直接清空，否则如果resize，那么vector底层可能会复制strip，从而触发动画
 			strips_.resize(data_.size());
+			DrawPolicy::s_firstStrip = strips_.data();
+			DrawPolicy::s_lastStrip = strips_.data() + strips_.size();
 			int tempMinValue = data_[0];
 			int tempMaxValue = data_[0];
 			for (size_t dataIndex = 1; dataIndex < data_.size(); ++dataIndex) {
 				if (tempMinValue > data_[dataIndex]) tempMinValue = data_[dataIndex];
 				else if (tempMaxValue < data_[dataIndex]) tempMaxValue = data_[dataIndex];
 			}
-			Strip::s_minValue = tempMinValue;
-			Strip::s_maxValue = tempMaxValue;
+			DrawPolicy::s_minValue = tempMinValue;
+			DrawPolicy::s_maxValue = tempMaxValue;
+			DrawPolicy::BuildLayout();
+			size_t width = static_cast<size_t>(GetConfigManager().GetWidth());
+			DrawPolicy::s_edges.resize(strips_.size() + 1);
+			DrawPolicy::s_tops.resize(strips_.size());
+			DrawPolicy::s_colors.resize(strips_.size());
+			for (size_t edgeIndex = 0; edgeIndex <= strips_.size(); ++edgeIndex) {
+				DrawPolicy::s_edges[edgeIndex] = ComputeStripEdge(edgeIndex, strips_.size(), width);
+			}
 			for (size_t stripIndex = 0; stripIndex < strips_.size(); ++stripIndex) {
-				int tempLeft = stripIndex * GetConfigManager().GetWidth() / strips_.size();
-				int tempRight = (stripIndex + 1) * GetConfigManager().GetWidth() / strips_.size();
-				strips_[stripIndex].SetStrip(data_[stripIndex], tempLeft, tempRight);
+				strips_[stripIndex].SetValue(data_[stripIndex]);
+				strips_[stripIndex].SetTopAndColorAuto();
 			}
 		}
 
-		static void DrawRemainingStrip() {
-			if (Strip::st_lastOperationNum == 1) {
-				GetDrawingTool().FlushBatchDraw(Strip::st_lastInterval1.left, Strip::StripMaxTop(), Strip::st_lastInterval1.right, GetConfigManager().GetHeight());
-			}
-			else if (Strip::st_lastOperationNum == 2) {
-				GetDrawingTool().FlushBatchDraw(Strip::st_lastInterval2.first.left, Strip::StripMaxTop(), Strip::st_lastInterval2.first.right, GetConfigManager().GetHeight());
-				GetDrawingTool().FlushBatchDraw(Strip::st_lastInterval2.second.left, Strip::StripMaxTop(), Strip::st_lastInterval2.second.right, GetConfigManager().GetHeight());
+		const T& GetElement() const noexcept {
+			return static_cast<const T&>(*this);
+		}
+		T& GetElement() noexcept {
+			return static_cast<T&>(*this);
+		}
+
+		// 条形在演示数组中的下标，临时条形返回 TempIndex（std::less 对不相关的指针也给出全序）
+		size_t GetIndex() const noexcept {
+			const T* strip = &this->GetElement();
+			if (std::less<const T*>()(strip, DrawPolicy::s_firstStrip) || !std::less<const T*>()(strip, DrawPolicy::s_lastStrip)) {
+				return DrawPolicy::TempIndex;
 			}
+			return static_cast<size_t>(strip - DrawPolicy::s_firstStrip);
 		}
 
-		inline static thread_local ScopeGuard st_scopeGuard{ []() {
-			Strip::DrawRemainingStrip();
-			std::lock_guard lock(Strip::s_threadsMutex);
-			Strip::s_threads.erase(std::this_thread::get_id());
-		}};
+		static RECT GetStripRect(size_t index_) noexcept {
+			return RECT(DrawPolicy::s_edges[index_], DrawPolicy::s_tops[index_], DrawPolicy::s_edges[index_ + 1], DrawPolicy::s_layout.height);
+		}
 
-		Strip& SetTopAuto() noexcept {
-			this->m_top = (GetConfigManager().GetHeight() * (Strip::s_maxValue - this->m_value) + this->m_value * Strip::StripMaxTop()) / Strip::s_maxValue;
-			if (Strip::StripMaxTop() > this->m_top) {
-				this->m_top = Strip::StripMaxTop();
-			}
-			return *this;
+		static void ClearStrip(size_t index_) {
+			GetDrawingTool().QueueClearRectangle(DrawPolicy::s_edges[index_], DrawPolicy::s_layout.maxTop, DrawPolicy::s_edges[index_ + 1], DrawPolicy::s_layout.height);
 		}
 
-		Strip& SetColorAuto() noexcept {
-			COLORREF tempColor = (StripLastColor - StripFirstColor) / RGB(1, 1, 1) * static_cast<size_t>(this->m_value) / Strip::s_maxValue;
-			this->m_color = RGB(tempColor, tempColor, tempColor) + StripFirstColor;
-			return *this;
+		static void AddDirtyStrip(size_t index_) {
+			DrawPolicy::st_dirtyIntervals.Add(DrawPolicy::s_edges[index_], DrawPolicy::s_edges[index_ + 1]);
 		}
 
-		Strip& SetTopAndColorAuto() noexcept {
-			this->SetTopAuto();
-			this->SetColorAuto();
-			return *this;
+		// 把本线程画过的条形合并成尽量少的区间刷新到屏幕（演示时在睡眠前和暂停前调用）
+		static void FlushDirtyStrips() {
+			DrawPolicy::st_dirtyIntervals.Flush([](int left_, int right_) {
+				GetDrawingTool().QueueFlushBatchDraw(left_, DrawPolicy::s_layout.maxTop, right_, DrawPolicy::s_layout.height);
+			});
 		}
 
-		static void StopSort() {
-			if (std::this_thread::get_id() != Strip::s_mainThreadId) {
-				while (Strip::s_stopStripSort) {
-					std::this_thread::sleep_for(std::chrono::milliseconds(10));
-				}
-			}
-			else {
-				auto stopBeginTime1 = std::chrono::steady_clock::now();
-				std::optional<std::chrono::steady_clock::time_point> stopBeginTime;
-				while (Strip::s_stopStripSort) {
-					if (Strip::s_exitStripSort && !Strip::s_isMulThreadSort) {
-						throw WideError(SortEndsPrematurely);
-					}
-					std::this_thread::sleep_for(std::chrono::milliseconds(10));
-					stopBeginTime = stopBeginTime1;
-				}
-				if (stopBeginTime.has_value()) {
-					auto stopEndTime = std::chrono::steady_clock::now();
-					Strip::s_stripSortStopTime += std::chrono::duration_cast<std::chrono::milliseconds>(stopEndTime - stopBeginTime.value());
-				}
-				if (Strip::s_exitStripSort && !Strip::s_isMulThreadSort) {
-					throw WideError(SortEndsPrematurely);
-				}
-			}
+		static void DrawRemainingStrip() {
+			DrawPolicy::FlushDirtyStrips();
 		}
 
-		static void RegisterCurrentThread() {
-			auto temp = (&Strip::st_scopeGuard, true);
-			if (std::this_thread::get_id() == Strip::s_mainThreadId) {
-				Strip::st_scopeGuard.Dismiss();
-			}
-			std::lock_guard<std::mutex> lock(Strip::s_threadsMutex);
-			Strip::s_threads.insert(std::this_thread::get_id());
+		// 刷新整个条形区域：线程池的工作线程不会退出，排序结束后由当前线程统一刷新它们最后绘制的条形
+		static void DrawRemainingStripOfAllThreads() {
+			GetDrawingTool().FlushBatchDraw(0, DrawPolicy::s_layout.maxTop, GetConfigManager().GetWidth(), DrawPolicy::s_layout.height);
 		}
 
-	public:
+		// 与 TraceRenderer 共用同一套计算（见 StripStyle.h），结果与按 Fraction 计算后取整相同
+		static int ComputeTopOfValue(int value_) noexcept {
+			return ComputeStripTop(DrawPolicy::s_layout.height, value_, DrawPolicy::s_maxValue);
+		}
 
-		constexpr Strip(int value_ = 0, bool not_temp_ = false) :m_value(value_), m_notTemp(not_temp_) {
-			this->m_left = -1;
-			this->m_right = -1;
-			this->m_top = 0;
-			this->m_color = BLACK;
+		static COLORREF ComputeColorOfValue(int value_) noexcept {
+			return ComputeStripColor(value_, DrawPolicy::s_maxValue);
 		}
 
-		Strip(int value_, int left_, int right_) :m_value(value_), m_left(left_), m_right(right_) {
-			this->m_notTemp = true;
-			this->SetTopAndColorAuto();
+		// 值域内查表，值域外（如 ReplayRecord 写入的值超出初始数据范围）直接计算
+		static int GetTopOfValue(int value_) noexcept {
+			size_t offset = static_cast<size_t>(static_cast<int64_t>(value_) - DrawPolicy::s_minValue);
+			return offset < DrawPolicy::s_layout.tops.size() ? DrawPolicy::s_layout.tops[offset] : DrawPolicy::ComputeTopOfValue(value_);
 		}
 
-		Strip(const Strip& strip_) {
-			this->m_value = strip_.m_value;
-			this->m_left = -1;
-			this->m_right = -1;
-			this->m_top = 0;
-			this->m_color = BLACK;
-			this->m_notTemp = false;
-			if (strip_.m_notTemp) {
-				Strip::DrawStrip1((Strip::AddNumCopy1_StripToInt(), strip_), StripCopyColor);
+		static COLORREF GetColorOfValue(int value_) noexcept {
+			size_t offset = static_cast<size_t>(static_cast<int64_t>(value_) - DrawPolicy::s_minValue);
+			return offset < DrawPolicy::s_layout.colors.size() ? DrawPolicy::s_layout.colors[offset] : DrawPolicy::ComputeColorOfValue(value_);
+		}
+
+		// 按当前窗口大小与值域重新计算布局缓存，在 InitValues 中调用
+		static void BuildLayout() {
+			DrawPolicy::InvalidateLayout();
+			size_t valueRange = static_cast<size_t>(static_cast<int64_t>(DrawPolicy::s_maxValue) - DrawPolicy::s_minValue + 1);
+			if (valueRange <= DrawPolicy::MaxLayoutTableSize) {
+				DrawPolicy::s_layout.tops.resize(valueRange);
+				DrawPolicy::s_layout.colors.resize(valueRange);
+				for (size_t offset = 0; offset < valueRange; ++offset) {
+					int value = static_cast<int>(DrawPolicy::s_minValue + static_cast<int64_t>(offset));
+					DrawPolicy::s_layout.tops[offset] = DrawPolicy::ComputeTopOfValue(value);
+					DrawPolicy::s_layout.colors[offset] = DrawPolicy::ComputeColorOfValue(value);
+				}
 			}
 		}
 
-		Strip& SetStrip(int value_, int left_, int right_) {
-			this->m_value = value_;
-			this->m_left = left_;
-			this->m_right = right_;
-			this->m_notTemp = true;
-			this->SetTopAndColorAuto();
-			return *this;
+		// 只对演示数组中的条形调用
+		T& SetTopAuto() noexcept {
+			DrawPolicy::s_tops[this->GetIndex()] = DrawPolicy::GetTopOfValue(this->GetElement().GetValue());
+			return this->GetElement();
 		}
 
-		constexpr int GetValue() const noexcept {
-			return this->m_value;
+		T& SetColorAuto() noexcept {
+			DrawPolicy::s_colors[this->GetIndex()] = DrawPolicy::GetColorOfValue(this->GetElement().GetValue());
+			return this->GetElement();
 		}
-		Strip& SetValue(int value_) noexcept {
-			this->m_value = value_;
+
+		// 画第 column_ 个像素列（按列显示时）：平均值以下用平均值的颜色（或高亮颜色），平均值到最大值之间用区间颜色
+		static void DrawColumn(const std::vector<T>& strips_, size_t column_, std::optional<COLORREF> highlight_color_ = std::nullopt) {
+			ColumnAggregate::Column column = DrawPolicy::s_columnAggregate.GetColumn(column_, [&strips_](size_t index_) {
+				return strips_[index_].GetValue();
+			});
+			int x = static_cast<int>(column_);
+			int maxTop = DrawPolicy::GetTopOfValue(column.maxValue);
+			int meanTop = DrawPolicy::GetTopOfValue(column.meanValue);
+			GetDrawingTool().ClearRectangle(x, DrawPolicy::s_layout.maxTop, x, DrawPolicy::s_layout.height);
+			if (maxTop < meanTop) {
+				GetDrawingTool().SolidRectangle(RECT(x, maxTop, x, meanTop - 1), StripRangeColor);
+			}
+			GetDrawingTool().SolidRectangle(RECT(x, meanTop, x, DrawPolicy::s_layout.height), highlight_color_.value_or(DrawPolicy::GetColorOfValue(column.meanValue)));
+			DrawPolicy::st_dirtyIntervals.Add(x, x);
 		}
 
-		constexpr COLORREF GetColor() const noexcept {
-			return this->m_color;
+		T& SetTopAndColorAuto() noexcept {
+			size_t index = this->GetIndex();
+			DrawPolicy::s_tops[index] = DrawPolicy::GetTopOfValue(this->GetElement().GetValue());
+			DrawPolicy::s_colors[index] = DrawPolicy::GetColorOfValue(this->GetElement().GetValue());
+			return this->GetElement();
 		}
-		Strip& SetColor(COLORREF color_) noexcept {
-			this->m_color = color_;
-			return *this;
+
+		// keep_color_ 为真时只更新顶端（CopyWithoutSetColor、SwapWithoutSetColor）
+		T& SetTopAndColorAuto(bool keep_color_) noexcept {
+			return keep_color_ ? this->SetTopAuto() : this->SetTopAndColorAuto();
 		}
 
-		constexpr bool GetNotTemp() const noexcept {
-			return this->m_notTemp;
+		// 退出后不再按演示速度等待，多线程排序的工作线程可以尽快走到算法的下一个停止检查点
+		static void SleepIfRunning() {
+			if (!DrawPolicy::s_pauseGate.GetIsCancelled()) {
+				DrawPolicy::s_sleepFunc();
+			}
 		}
-		Strip& SetNotTemp(bool not_temp_) noexcept {
-			this->m_notTemp = not_temp_;
+
+		// 暂停时阻塞在暂停闸门上，继续时所有线程一起被唤醒；主线程统计暂停时长，并在单线程排序被退出时抛出
+		// （多线程排序不抛出，由 PauseGate::GetStopToken 得到的令牌让算法在检查点返回，异常不会穿过工作线程）
+		static void StopSort() {
+			bool isMainThread = std::this_thread::get_id() == DrawPolicy::s_mainThreadId;
+			if (DrawPolicy::s_pauseGate.GetIsBlocking()) {
+				DrawPolicy::FlushDirtyStrips(); // 暂停时要看到当前这一步
+				std::chrono::steady_clock::duration stopDuration = DrawPolicy::s_pauseGate.Wait();
+				if (isMainThread) {
+					DrawPolicy::s_stripSortStopTime += std::chrono::duration_cast<std::chrono::milliseconds>(stopDuration);
+				}
+			}
+			if (isMainThread && DrawPolicy::s_pauseGate.GetIsCancelled() && !DrawPolicy::s_isMulThreadSort) {
+				throw WideError(SortEndsPrematurely);
+			}
 		}
 
-		static void DrawStrips(const std::vector<Strip>& strips_) {
-			GetDrawingTool().ClearRectangle(0, Strip::StripMaxTop(), GetConfigManager().GetWidth(), GetConfigManager().GetHeight());
+	public:
+
+		// 临时条形没有颜色：GetColor 返回 BLACK，SetColor 不起作用
+		COLORREF GetColor() const noexcept {
+			size_t index = this->GetIndex();
+			return index == DrawPolicy::TempIndex ? BLACK : DrawPolicy::s_colors[index];
+		}
+		T& SetColor(COLORREF color_) noexcept {
+			size_t index = this->GetIndex();
+			if (index != DrawPolicy::TempIndex) {
+				DrawPolicy::s_colors[index] = color_;
+			}
+			return this->GetElement();
+		}
+
+		bool GetNotTemp() const noexcept {
+			return this->GetIndex() != DrawPolicy::TempIndex;
+		}
+
+		static void DrawStrips(const std::vector<T>& strips_) {
+			GetDrawingTool().ClearRectangle(0, DrawPolicy::s_layout.maxTop, GetConfigManager().GetWidth(), DrawPolicy::s_layout.height);
+			if (DrawPolicy::s_isColumnMode) {
+				for (size_t column = 0; column < DrawPolicy::s_columnAggregate.GetColumnNum(); ++column) {
+					DrawPolicy::DrawColumn(strips_, column);
+				}
+				DrawPolicy::st_dirtyIntervals.Clear();
+				GetDrawingTool().FlushBatchDraw(0, DrawPolicy::s_layout.maxTop, GetConfigManager().GetWidth(), DrawPolicy::s_layout.height);
+				return;
+			}
 			for (size_t stripIndex = 0; stripIndex < strips_.size(); ++stripIndex) {
-				Strip::s_drawFunc(RECT(strips_[stripIndex].m_left, strips_[stripIndex].m_top, strips_[stripIndex].m_right,
-					GetConfigManager().GetHeight()), strips_[stripIndex].m_color);
+				DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(stripIndex), DrawPolicy::s_colors[stripIndex]);
 			}
-			GetDrawingTool().FlushBatchDraw(0, Strip::StripMaxTop(), GetConfigManager().GetWidth(), GetConfigManager().GetHeight());
+			GetDrawingTool().FlushBatchDraw(0, DrawPolicy::s_layout.maxTop, GetConfigManager().GetWidth(), DrawPolicy::s_layout.height);
 		}
 		
-		static void DrawStrip1(const Strip& strip_, COLORREF color_) {
-			static thread_local auto temp = (Strip::RegisterCurrentThread(), true);
-			GetDrawingTool().ClearRectangle(strip_.m_left, Strip::StripMaxTop(), strip_.m_right, GetConfigManager().GetHeight());
-			Strip::s_drawFunc(RECT(strip_.m_left, strip_.m_top, strip_.m_right, GetConfigManager().GetHeight()), color_);
-			GetDrawingTool().FlushBatchDraw(strip_.m_left, Strip::StripMaxTop(), strip_.m_right, GetConfigManager().GetHeight());
-			Strip::s_updateMessageFunc();
-			Strip::DrawRemainingStrip();
-			Strip::s_sleepFunc();
-			Strip::StopSort();
-			Strip::s_drawFunc(RECT(strip_.m_left, strip_.m_top, strip_.m_right, GetConfigManager().GetHeight()), strip_.m_color);
-			Strip::st_lastOperationNum = 1;
-			Strip::st_lastInterval1 = { strip_.m_left,strip_.m_right };
-		}
-
-		static void DrawStrip2(const Strip& strip1_, COLORREF color1_, const Strip& strip2_, COLORREF color2_) {
-			static thread_local auto temp = (Strip::RegisterCurrentThread(), true);
-			GetDrawingTool().ClearRectangle(strip1_.m_left, Strip::StripMaxTop(), strip1_.m_right, GetConfigManager().GetHeight());
-			GetDrawingTool().ClearRectangle(strip2_.m_left, Strip::StripMaxTop(), strip2_.m_right, GetConfigManager().GetHeight());
-			Strip::s_drawFunc(RECT(strip1_.m_left, strip1_.m_top, strip1_.m_right, GetConfigManager().GetHeight()), color1_);
-			Strip::s_drawFunc(RECT(strip2_.m_left, strip2_.m_top, strip2_.m_right, GetConfigManager().GetHeight()), color2_);
-			GetDrawingTool().FlushBatchDraw(strip1_.m_left, Strip::StripMaxTop(), strip1_.m_right, GetConfigManager().GetHeight());
-			GetDrawingTool().FlushBatchDraw(strip2_.m_left, Strip::StripMaxTop(), strip2_.m_right, GetConfigManager().GetHeight());
-			Strip::s_updateMessageFunc();
-			Strip::DrawRemainingStrip();
-			Strip::s_sleepFunc();
-			Strip::StopSort();
-			Strip::s_drawFunc(RECT(strip1_.m_left,strip1_.m_top,strip1_.m_right,GetConfigManager().GetHeight()), strip1_.m_color);
-			Strip::s_drawFunc(RECT(strip2_.m_left,strip2_.m_top,strip2_.m_right,GetConfigManager().GetHeight()), strip2_.m_color);
-			Strip::st_lastOperationNum = 2;
-			Strip::st_lastInterval2 = { {strip1_.m_left,strip1_.m_right},{strip2_.m_left,strip2_.m_right} };
-		}
-
-		static void DrawCheckStrip(const Strip& strip_, COLORREF color_) {
-			Strip::s_drawFunc(RECT(strip_.m_left,strip_.m_top,strip_.m_right,GetConfigManager().GetHeight()), color_);
-			GetDrawingTool().FlushBatchDraw(RECT(strip_.m_left, Strip::StripMaxTop(), strip_.m_right, GetConfigManager().GetHeight()));
-			Strip::StopSort();
-			Strip::s_sleepFunc();
+		static void DrawStrip1(const T& strip_, COLORREF color_) {
+			size_t index = strip_.GetIndex();
+			DrawPolicy::ClearStrip(index);
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index), color_);
+			DrawPolicy::AddDirtyStrip(index);
+			DrawPolicy::s_updateMessageFunc();
+			DrawPolicy::SleepIfRunning();
+			DrawPolicy::StopSort();
+			// 睡眠前已经刷新并清空了脏区间，恢复原色后要重新标记，否则高亮会一直留在屏幕上
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index), DrawPolicy::s_colors[index]);
+			DrawPolicy::AddDirtyStrip(index);
+		}
+
+		static void DrawStrip2(const T& strip1_, COLORREF color1_, const T& strip2_, COLORREF color2_) {
+			size_t index1 = strip1_.GetIndex();
+			size_t index2 = strip2_.GetIndex();
+			DrawPolicy::ClearStrip(index1);
+			DrawPolicy::ClearStrip(index2);
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index1), color1_);
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index2), color2_);
+			DrawPolicy::AddDirtyStrip(index1);
+			DrawPolicy::AddDirtyStrip(index2);
+			DrawPolicy::s_updateMessageFunc();
+			DrawPolicy::SleepIfRunning();
+			DrawPolicy::StopSort();
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index1), DrawPolicy::s_colors[index1]);
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index2), DrawPolicy::s_colors[index2]);
+			DrawPolicy::AddDirtyStrip(index1);
+			DrawPolicy::AddDirtyStrip(index2);
+		}
+
+		static void DrawCheckStrip(const T& strip_, COLORREF color_) {
+			size_t index = strip_.GetIndex();
+			DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index), color_);
+			DrawPolicy::AddDirtyStrip(index);
+			DrawPolicy::StopSort();
+			DrawPolicy::SleepIfRunning();
+		}
+
+		// 直接把条形的值设为 data_（不绘制、不统计），用于回放跳转后整体重绘
+		static void SetValues(std::vector<T>& strips_, const std::vector<int>& data_) {
+			for (size_t stripIndex = 0; stripIndex < strips_.size() && stripIndex < data_.size(); ++stripIndex) {
+				strips_[stripIndex].SetValue(data_[stripIndex]);
+				strips_[stripIndex].SetTopAndColorAuto();
+			}
+			if (DrawPolicy::s_isColumnMode) {
+				DrawPolicy::SetColumnMode(strips_, true);
+			}
+		}
+
+		// 窗口重建后调用：重新读取窗口高度并清空查找表，直到下次 InitValues 前都直接计算
+		static void InvalidateLayout() {
+			DrawPolicy::s_layout.height = GetConfigManager().GetHeight();
+			DrawPolicy::s_layout.maxTop = DrawPolicy::StripMaxTop();
+			DrawPolicy::s_layout.tops.clear();
+			DrawPolicy::s_layout.colors.clear();
+		}
+
+		// 回放模式下打开按列显示（条形比像素列多时才生效），这样数据量可以远大于窗口宽度
+		// 按列显示时只有 ApplyRecord、SetValues 会更新聚合，DrawStrip1 等逐个条形的绘制函数不能再用
+		static void SetColumnMode(const std::vector<T>& strips_, bool enable_) {
+			size_t columnNum = static_cast<size_t>(GetConfigManager().GetWidth());
+			DrawPolicy::s_isColumnMode = enable_ && strips_.size() > columnNum;
+			if (DrawPolicy::s_isColumnMode) {
+				DrawPolicy::s_columnAggregate.Build(strips_.size(), columnNum, [&strips_](size_t index_) {
+					return strips_[index_].GetValue();
+				});
+			}
+		}
+
+		static bool GetIsColumnMode() noexcept {
+			return DrawPolicy::s_isColumnMode;
+		}
+
+		// 按列显示时检查结果：第 column_ 列的条形全部正确才画成 GREEN，并像 DrawCheckStrip 一样等待
+		static void DrawCheckColumn(const std::vector<T>& strips_, size_t column_, COLORREF color_) {
+			DrawPolicy::DrawColumn(strips_, column_, color_);
+			DrawPolicy::StopSort();
+			DrawPolicy::SleepIfRunning();
+		}
+
+		// 第 column_ 列对应的条形下标范围 [first, second)
+		static std::pair<size_t, size_t> GetColumnRange(size_t column_) noexcept {
+			return { DrawPolicy::s_columnAggregate.GetBeginIndex(column_), DrawPolicy::s_columnAggregate.GetBeginIndex(column_ + 1) };
+		}
+
+		// 回放时一条记录涉及的条形与高亮颜色
+		struct ReplayHighlight {
+			uint32_t index = TraceNoIndex;
+			COLORREF color = BLACK;
+		};
+		using ReplayHighlights = std::array<ReplayHighlight, 2>;
+
+		// 一条记录应当高亮的条形与颜色（见 GetRecordHighlightColors）
+		static ReplayHighlights GetReplayHighlights(const TraceRecord& record_) noexcept {
+			std::array<uint32_t, 2> colors = GetRecordHighlightColors(record_.opcode);
+			return { ReplayHighlight{ record_.indexA, colors[0] }, ReplayHighlight{ record_.indexB, colors[1] } };
+		}
+
+		// 回放一条操作记录：按记录修改条形并统计，不绘制，返回应当高亮的条形
+		static ReplayHighlights ApplyRecord(std::vector<T>& strips_, const TraceRecord& record_) {
+			if ((record_.indexA != TraceNoIndex && record_.indexA >= strips_.size())
+				|| (record_.indexB != TraceNoIndex && record_.indexB >= strips_.size())) {
+				throw WideError(L"操作记录的下标越界！");
+			}
+			bool hasA = record_.indexA != TraceNoIndex;
+			bool hasB = record_.indexB != TraceNoIndex;
+			switch (record_.opcode) {
+			case TraceOpcode::Compare:
+				hasA && hasB ? DrawPolicy::AddNumCompare2() : DrawPolicy::AddNumCompare1();
+				break;
+			case TraceOpcode::Read:
+				DrawPolicy::AddNumCopy1_StripToInt();
+				break;
+			case TraceOpcode::Write:
+				if (DrawPolicy::s_isColumnMode) {
+					DrawPolicy::s_columnAggregate.Update(record_.indexA, strips_[record_.indexA].GetValue(), record_.value);
+					strips_[record_.indexA].SetValue(record_.value);
+				}
+				else {
+					strips_[record_.indexA].SetValue(record_.value).SetTopAndColorAuto();
+				}
+				hasB ? DrawPolicy::AddNumCopy2() : DrawPolicy::AddNumCopy1_IntToStrip();
+				break;
+			case TraceOpcode::Swap: {
+				int valueA = strips_[record_.indexA].GetValue();
+				int valueB = strips_[record_.indexB].GetValue();
+				if (DrawPolicy::s_isColumnMode) {
+					DrawPolicy::s_columnAggregate.Update(record_.indexA, valueA, valueB);
+					DrawPolicy::s_columnAggregate.Update(record_.indexB, valueB, valueA);
+					strips_[record_.indexA].SetValue(valueB);
+					strips_[record_.indexB].SetValue(valueA);
+				}
+				else {
+					strips_[record_.indexA].SetValue(valueB).SetTopAndColorAuto();
+					strips_[record_.indexB].SetValue(valueA).SetTopAndColorAuto();
+				}
+				DrawPolicy::AddNumSwap2();
+				break;
+			}
+			default:
+				throw WideError(L"未知的操作记录！");
+			}
+			return DrawPolicy::GetReplayHighlights(record_);
+		}
+
+		// 重绘 indices_ 中的条形（先清除整列），其中在 highlights_ 里的用高亮颜色；所有条形画完后合并区间一起刷新
+		// 按列显示时重绘这些条形所在的列，含高亮条形的列用高亮颜色
+		static void DrawReplayFrame(const std::vector<T>& strips_, const std::vector<uint32_t>& indices_, const ReplayHighlights& highlights_) {
+			if (DrawPolicy::s_isColumnMode) {
+				std::vector<size_t> columns;
+				columns.reserve(indices_.size());
+				for (uint32_t index : indices_) {
+					columns.push_back(DrawPolicy::s_columnAggregate.GetColumnIndex(index));
+				}
+				std::sort(columns.begin(), columns.end());
+				columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+				for (size_t column : columns) {
+					std::optional<COLORREF> highlightColor;
+					for (const ReplayHighlight& highlight : highlights_) {
+						if (highlight.index != TraceNoIndex && DrawPolicy::s_columnAggregate.GetColumnIndex(highlight.index) == column) {
+							highlightColor = highlight.color;
+						}
+					}
+					DrawPolicy::DrawColumn(strips_, column, highlightColor);
+				}
+				DrawPolicy::FlushDirtyStrips();
+				return;
+			}
+			for (uint32_t index : indices_) {
+				COLORREF color = DrawPolicy::s_colors[index];
+				for (const ReplayHighlight& highlight : highlights_) {
+					if (highlight.index == index) {
+						color = highlight.color;
+					}
+				}
+				DrawPolicy::ClearStrip(index);
+				DrawPolicy::s_drawFunc(DrawPolicy::GetStripRect(index), color);
+				DrawPolicy::AddDirtyStrip(index);
+			}
+			DrawPolicy::FlushDirtyStrips();
 		}
 
 		static Fraction StripMaxTop() noexcept {
-			return GetConfigManager().GetHeight() * 2 / 9;
+			return GetConfigManager().GetHeight() * StripAreaTopNumerator / StripAreaTopDenominator;
 		}
 
 		static void AddNumCompare1() {
@@ -334,554 +538,95 @@ namespace NVisualSort {
 			++AnimationStepNum;
 		}
 
-		bool operator > (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			return this->m_value > value_;
-		}
-		bool operator > (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
-			}
-			return this->m_value > strip_.m_value;
-		}
-		friend bool operator > (const int, const Strip&);
+		static constexpr bool IsDrawn = true;
 
-		bool operator < (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			return this->m_value < value_;
-		}
-		bool operator < (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
-			}
-			return this->m_value < strip_.m_value;
+		static void AddSteps(size_t step_num_) {
+			AnimationStepNum += step_num_;
 		}
-		friend bool operator < (const int, const Strip&);
 
-		bool operator >= (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			return this->m_value >= value_;
-		}
-		bool operator >= (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
-			}
-			return this->m_value >= strip_.m_value;
-		}
-		friend bool operator >= (const int, const Strip&);
+		// 缓冲区不显示，按临时变量处理
+		static void MarkAsArray(std::vector<T>&) noexcept {}
 
-		bool operator <= (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			return this->m_value <= value_;
-		}
-		bool operator <= (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
-			}
-			return this->m_value <= strip_.m_value;
-		}
-		friend bool operator <= (const int, const Strip&);
+	protected:
 
-		bool operator == (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
+		static void OnCompare(const T& strip_, int) {
+			if (strip_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip_, StripCopyColor);
+				DrawPolicy::AddNumCompare1();
 			}
-			return this->m_value == value_;
 		}
-		bool operator == (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
+		static void OnCompare(const T& strip1_, const T& strip2_) {
+			if (strip1_.GetNotTemp() != strip2_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip1_.GetNotTemp() ? strip1_ : strip2_, StripCopyColor);
+				DrawPolicy::AddNumCompare1();
 			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
+			else if (strip1_.GetNotTemp()) {
+				DrawPolicy::DrawStrip2(strip1_, StripCopyColor, strip2_, StripCopyColor);
+				DrawPolicy::AddNumCompare2();
 			}
-			return this->m_value == strip_.m_value;
 		}
-		friend bool operator == (const int, const Strip&);
-
-		bool operator != (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCompare1();
+		static void OnRead(const T& strip_) {
+			if (strip_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip_, StripCopyColor);
+				DrawPolicy::AddNumCopy1_StripToInt();
 			}
-			return this->m_value != value_;
 		}
-		bool operator != (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCompare1();
+		static void OnRead(const T& strip1_, const T& strip2_) {
+			if (strip1_.GetNotTemp() != strip2_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip1_.GetNotTemp() ? strip1_ : strip2_, StripCopyColor);
+				DrawPolicy::AddNumCopy1_StripToInt();
 			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor);
-				Strip::AddNumCompare2();
+			else if (strip1_.GetNotTemp()) {
+				DrawPolicy::DrawStrip2(strip1_, StripCopyColor, strip2_, StripCopyColor);
+				DrawPolicy::AddNumCopy2_StripToInt();
 			}
-			return this->m_value != strip_.m_value;
 		}
-		friend bool operator != (const int, const Strip&);
-
-		Strip& operator = (const int value_) {
-			this->m_value = value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripCopyColor);
-				Strip::AddNumCopy1_IntToStrip();
+		static void OnWrite(T& strip_) {
+			if (strip_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip_.SetTopAndColorAuto(), StripChangeColor);
+				DrawPolicy::AddNumCopy1_IntToStrip();
 			}
-			return *this;
 		}
-		Strip& operator = (const Strip& strip_) {
-			this->m_value = strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
+		static void OnAssign(T& target_, const T& source_, bool keep_color_) {
+			if (target_.GetNotTemp() != source_.GetNotTemp()) {
+				if (target_.GetNotTemp()) {
+					DrawPolicy::DrawStrip1(target_.SetTopAndColorAuto(keep_color_), StripChangeColor);
+					DrawPolicy::AddNumCopy1_IntToStrip();
 				}
 				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
+					DrawPolicy::DrawStrip1(source_, StripCopyColor);
+					DrawPolicy::AddNumCopy1_StripToInt();
 				}
 			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
+			else if (target_.GetNotTemp()) {
+				DrawPolicy::DrawStrip2(target_.SetTopAndColorAuto(keep_color_), StripChangeColor, source_, StripCopyColor);
+				DrawPolicy::AddNumCopy2();
 			}
-			return *this;
 		}
-		operator int() const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value;
+		static void OnUpdate(T& target_, const T& source_) {
+			DrawPolicy::OnAssign(target_, source_, false);
 		}
-
-		Strip& operator += (const int value_) {
-			this->m_value += value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
+		static void OnSwap(T& strip1_, T& strip2_, bool keep_color_) {
+			if (strip1_.GetNotTemp() != strip2_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1((strip1_.GetNotTemp() ? strip1_ : strip2_).SetTopAndColorAuto(keep_color_), StripChangeColor);
+				DrawPolicy::AddNumCopy2();
 			}
-			return *this;
-		}
-		Strip& operator += (const Strip& strip_) {
-			this->m_value += strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		Strip& operator -= (const int value_) {
-			this->m_value -= value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return *this;
-		}
-		Strip& operator -= (const Strip& strip_) {
-			this->m_value -= strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		Strip& operator *= (const int value_) {
-			this->m_value *= value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return *this;
-		}
-		Strip& operator *= (const Strip& strip_) {
-			this->m_value *= strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		Strip& operator /= (const int value_) {
-			this->m_value /= value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return *this;
-		}
-		Strip& operator /= (const Strip& strip_) {
-			this->m_value /= strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		Strip& operator %= (const int value_) {
-			this->m_value %= value_;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return *this;
-		}
-		Strip& operator %= (const Strip& strip_) {
-			this->m_value %= strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAndColorAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		const int operator + (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value + value_;
-		}
-		const int operator + (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor); Strip::AddNumCompare2();
-				Strip::AddNumCopy2_StripToInt();
-			}
-			return this->m_value + strip_.m_value;
-		}
-
-		const int operator - (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value - value_;
-		}
-		const int operator - (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor); Strip::AddNumCompare2();
-				Strip::AddNumCopy2_StripToInt();
-			}
-			return this->m_value - strip_.m_value;
-		}
-
-		const int operator * (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value * value_;
-		}
-		const int operator * (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor); Strip::AddNumCompare2();
-				Strip::AddNumCopy2_StripToInt();
-			}
-			return this->m_value * strip_.m_value;
-		}
-
-		const int operator / (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value / value_;
-		}
-		const int operator / (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor); Strip::AddNumCompare2();
-				Strip::AddNumCopy2_StripToInt();
-			}
-			return this->m_value / strip_.m_value;
-		}
-
-		const int operator % (const int value_) const {
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(*this, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			return this->m_value % value_;
-		}
-		const int operator % (const Strip& strip_) const {
-			if (this->m_notTemp != strip_.m_notTemp) {
-				Strip::DrawStrip1(this->m_notTemp ? *this : strip_, StripCopyColor);
-				Strip::AddNumCopy1_StripToInt();
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(*this, StripCopyColor, strip_, StripCopyColor); Strip::AddNumCompare2();
-				Strip::AddNumCopy2_StripToInt();
-			}
-			return this->m_value % strip_.m_value;
-		}
-
-		Strip& operator++() {
-			++this->m_value;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return *this;
-		}
-		int operator++(int) {
-			++this->m_value;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
-			}
-			return this->m_value - 1;
-		}
-
-		Strip& operator--() {
-			--this->m_value;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
+			else if (strip1_.GetNotTemp()) {
+				DrawPolicy::DrawStrip2(strip1_.SetTopAndColorAuto(keep_color_), StripChangeColor, strip2_.SetTopAndColorAuto(keep_color_), StripChangeColor);
+				DrawPolicy::AddNumSwap2();
 			}
-			return *this;
 		}
-		int operator--(int) {
-			--this->m_value;
-			if (this->m_notTemp) {
-				Strip::DrawStrip1(this->SetTopAndColorAuto(), StripChangeColor);
-				Strip::AddNumCopy1_IntToStrip();
+		static void OnSwap(T& strip_) {
+			if (strip_.GetNotTemp()) {
+				DrawPolicy::DrawStrip1(strip_.SetTopAndColorAuto(), StripChangeColor);
+				DrawPolicy::AddNumCopy2();
 			}
-			return this->m_value + 1;
 		}
 
-		Strip& CopyWithoutSetColor(const Strip& strip_) {
-			this->m_value = strip_.m_value;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-		}
-
-		Strip& CopyValueAndColor(const Strip& strip_) {
-			this->m_value = strip_.m_value;
-			this->m_color = strip_.m_color;
-			if (this->m_notTemp != strip_.m_notTemp) {
-				if (this->m_notTemp) {
-					Strip::DrawStrip1(this->SetTopAuto(), StripChangeColor);
-					Strip::AddNumCopy1_IntToStrip();
-				}
-				else {
-					Strip::DrawStrip1(strip_, StripCopyColor);
-					Strip::AddNumCopy1_StripToInt();
-				}
-			}
-			else if (this->m_notTemp) {
-				Strip::DrawStrip2(this->SetTopAuto(), StripChangeColor, strip_, StripCopyColor);
-				Strip::AddNumCopy2();
-			}
-			return *this;
-			return *this;
-		}
-
-		friend void swap(Strip&, Strip&);
-		friend void swap(Strip&, int&);
-		friend void swap(int&, Strip&);
-		friend void SwapWithoutSetColor(Strip&, Strip&);
-
 	};
 
-	bool operator > (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ > strip_.m_value;
-	}
-
-	bool operator < (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ < strip_.m_value;
-	}
-
-	bool operator >= (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ >= strip_.m_value;
-	}
-
-	bool operator <= (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ <= strip_.m_value;
-	}
-
-	bool operator == (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ == strip_.m_value;
-	}
-
-	bool operator != (const int value_, const Strip& strip_) {
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_, StripCopyColor);
-			Strip::AddNumCompare1();
-		}
-		return value_ != strip_.m_value;
-	}
-
-	void swap(Strip& strip1_, Strip& strip2_) {
-		std::swap(strip1_.m_value, strip2_.m_value);
-		if (strip1_.m_notTemp != strip2_.m_notTemp) {
-			Strip::DrawStrip1((strip1_.m_notTemp ? strip1_.SetTopAndColorAuto() : strip2_.SetTopAndColorAuto()), StripChangeColor);
-			Strip::AddNumCopy2();
-		}
-		else if (strip1_.m_notTemp) {
-			Strip::DrawStrip2(strip1_.SetTopAndColorAuto(), StripChangeColor, strip2_.SetTopAndColorAuto(), StripChangeColor);
-			Strip::AddNumSwap2();
-		}
-	}
-	void swap(Strip& strip_, int& value_) {
-		std::swap(strip_.m_value, value_);
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_.SetTopAndColorAuto(), StripChangeColor);
-			Strip::AddNumCopy2();
-		}
-	}
-	void swap(int& value_, Strip& strip_) {
-		std::swap(strip_.m_value, value_);
-		if (strip_.m_notTemp) {
-			Strip::DrawStrip1(strip_.SetTopAndColorAuto(), StripChangeColor);
-			Strip::AddNumCopy2();
-		}
-	}
-	void SwapWithoutSetColor(Strip& strip1_, Strip& strip2_) {
-		std::swap(strip1_.m_value, strip2_.m_value);
-		if (strip1_.m_notTemp != strip2_.m_notTemp) {
-			Strip::DrawStrip1((strip1_.m_notTemp ? strip1_.SetTopAuto() : strip2_.SetTopAuto()), StripChangeColor);
-			Strip::AddNumCopy2();
-		}
-		else if (strip1_.m_notTemp) {
-			Strip::DrawStrip2(strip1_.SetTopAuto(), StripChangeColor, strip2_.SetTopAuto(), StripChangeColor);
-			Strip::AddNumSwap2();
-		}
-	}
+	using Strip = Element<DrawPolicy>;
+
+	static_assert(sizeof(Strip) == sizeof(int));
 
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Tracer.h"
+
+namespace NVisualSort {
+
+	// 条形的外观与布局，界面中的 Strip 与无界面的 TraceRenderer 共用，两边画出来的条形完全相同
+	// 不依赖 Windows.h 与 EasyX；颜色与 COLORREF 相同（0x00BBGGRR）
+
+	constexpr uint32_t StripCopyColor = 0xFF5555;   // LIGHTBLUE：比较、读取
+	constexpr uint32_t StripChangeColor = 0x0000AA; // RED：写入、交换
+	constexpr uint32_t StripFrameColor = 0x000000;  // BLACK：条形较宽时的边框
+	constexpr uint32_t StripRangeColor = 0x444444;  // 按列显示时，平均值到最大值之间的颜色
+	constexpr uint32_t StripFirstGray = 0x88;       // 值为 0 的条形的灰度
+	constexpr uint32_t StripLastGray = 0xFF;        // 值为最大值的条形的灰度
+
+	// 界面中窗口高度的 2/9 以上是标题与按钮，条形画在下面；TraceRenderer 的画布只有条形区域，传 0/1
+	constexpr int StripAreaTopNumerator = 2;
+	constexpr int StripAreaTopDenominator = 9;
+
+	// 值为 value_ 的条形顶端：最大值顶到条形区域的上沿，0 在底部（height_）
+	// 即 (height * (max - value) + value * areaTop) / max，其中 areaTop = height * numerator / denominator，通分后只用整数运算
+	constexpr int ComputeStripTop(int height_, int value_, int max_value_,
+		int area_top_numerator_ = StripAreaTopNumerator, int area_top_denominator_ = StripAreaTopDenominator) noexcept {
+		int64_t denominator = static_cast<int64_t>((std::max)(max_value_, 1)) * area_top_denominator_;
+		int top = static_cast<int>(static_cast<int64_t>(height_)
+			* (denominator - static_cast<int64_t>(value_) * (area_top_denominator_ - area_top_numerator_)) / denominator);
+		return (std::max)(top, static_cast<int>(static_cast<int64_t>(height_) * area_top_numerator_ / area_top_denominator_));
+	}
+
+	// 值为 value_ 的条形颜色：灰度从 StripFirstGray（0）线性变到 StripLastGray（最大值），值域外（回放时写入的值）取两端
+	constexpr uint32_t ComputeStripColor(int value_, int max_value_) noexcept {
+		max_value_ = (std::max)(max_value_, 1);
+		value_ = (std::clamp)(value_, 0, max_value_);
+		uint32_t gray = StripFirstGray + static_cast<uint32_t>((StripLastGray - StripFirstGray) * static_cast<uint64_t>(value_) / static_cast<uint64_t>(max_value_));
+		return gray | (gray << 8) | (gray << 16);
+	}
+
+	// strip_num_ 个条形平分 width_ 个像素时第 index_ 个条形的左边界（index_ 为 strip_num_ 时是右边界）
+	constexpr int ComputeStripEdge(size_t index_, size_t strip_num_, size_t width_) noexcept {
+		return static_cast<int>(index_ * width_ / strip_num_);
+	}
+
+	// 每个条形至少 6 像素宽时才画 1 像素的边框
+	constexpr bool GetIsStripFramed(size_t strip_num_, size_t width_) noexcept {
+		return strip_num_ * 6 <= width_;
+	}
+
+	// 回放一条记录时 indexA、indexB 的高亮颜色：比较、读取为引用色，写入的目标为修改色、来源为引用色，交换的两者都为修改色
+	constexpr std::array<uint32_t, 2> GetRecordHighlightColors(TraceOpcode opcode_) noexcept {
+		bool isChange = opcode_ == TraceOpcode::Write || opcode_ == TraceOpcode::Swap;
+		return { isChange ? StripChangeColor : StripCopyColor, opcode_ == TraceOpcode::Swap ? StripChangeColor : StripCopyColor };
+	}
+
+}
\ No newline at end of file
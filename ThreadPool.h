@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace NVisualSort {
+
+	// 工作窃取线程池，使用单例模式，所有多线程排序共用
+	// 每个工作线程有自己的任务队列：自己提交的任务从队尾取（后进先出，缓存友好），空闲时从别的队列队头偷（先进先出，偷到的任务较大）
+	// 定时任务按时间排序保存，空闲的工作线程睡到最早的到期时间，到期后把它放进任务队列
+	class ThreadPool {
+
+	private:
+
+		struct WorkerQueue {
+			std::deque<std::function<void()>> tasks;
+			std::mutex mutex;
+		};
+
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+		std::atomic<size_t> m_nextQueueIndex = 0; // 外部线程提交任务时轮流放入各个队列
+		std::atomic<size_t> m_pendingTaskNum = 0; // 队列中还没被取走的任务数
+		std::atomic<size_t> m_timerTaskNum = 0; // 还没到期的定时任务数
+		std::atomic<size_t> m_waitingNum = 0; // 阻塞在 WaitUntil 中的线程数，每个任务执行完后有它们才唤醒
+		std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> m_timerTasks; // 由 m_sleepMutex 保护
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+		bool m_stop = false; // 由 m_sleepMutex 保护
+
+		inline static thread_local const ThreadPool* st_pool = nullptr; // 当前线程所属的线程池
+		inline static thread_local size_t st_workerIndex = 0; // 当前线程在线程池中的序号
+
+		// 单例模式下，禁止拷贝和移动
+		explicit ThreadPool(size_t worker_num_) {
+			this->StartWorkers(worker_num_);
+		}
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		void StartWorkers(size_t worker_num_) {
+			worker_num_ = (std::max)(worker_num_, static_cast<size_t>(1));
+			this->m_stop = false;
+			for (size_t i = 0; i < worker_num_; ++i) {
+				this->m_queues.push_back(std::make_unique<WorkerQueue>());
+			}
+			for (size_t i = 0; i < worker_num_; ++i) {
+				this->m_workers.emplace_back([this, i]() {
+					this->WorkerLoop(i);
+				});
+			}
+		}
+
+		void StopWorkers() {
+			{
+				std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+				this->m_stop = true;
+			}
+			this->m_sleepCondition.notify_all();
+			for (std::thread& worker : this->m_workers) {
+				worker.join();
+			}
+			this->m_workers.clear();
+			this->m_queues.clear();
+		}
+
+		void WorkerLoop(size_t worker_index_) {
+			ThreadPool::st_pool = this;
+			ThreadPool::st_workerIndex = worker_index_;
+			while (true) {
+				if (this->TryRunOneTask()) {
+					continue;
+				}
+				// 检查条件与等待都在锁内，提交任务时也在锁内增加计数，不会漏掉唤醒
+				std::unique_lock<std::mutex> lock(this->m_sleepMutex);
+				if (this->m_stop) {
+					return;
+				}
+				if (this->m_pendingTaskNum.load(std::memory_order_acquire) > 0) {
+					continue;
+				}
+				this->SleepUntilWork(lock);
+			}
+		}
+
+		// 持有 m_sleepMutex 时调用：没有定时任务时一直睡到被唤醒，否则最多睡到最早的到期时间
+		void SleepUntilWork(std::unique_lock<std::mutex>& lock_) {
+			if (this->m_timerTasks.empty()) {
+				this->m_sleepCondition.wait(lock_);
+			}
+			else if (this->m_timerTasks.begin()->first > std::chrono::steady_clock::now()) {
+				this->m_sleepCondition.wait_until(lock_, this->m_timerTasks.begin()->first);
+			}
+		}
+
+		// 把到期的定时任务放进任务队列
+		void SubmitDueTimerTasks() {
+			if (this->m_timerTaskNum.load(std::memory_order_acquire) == 0) {
+				return;
+			}
+			std::vector<std::function<void()>> dueTasks;
+			{
+				std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+				auto dueEnd = this->m_timerTasks.upper_bound(std::chrono::steady_clock::now());
+				for (auto it = this->m_timerTasks.begin(); it != dueEnd; ++it) {
+					dueTasks.push_back(std::move(it->second));
+				}
+				this->m_timerTasks.erase(this->m_timerTasks.begin(), dueEnd);
+				this->m_timerTaskNum.fetch_sub(dueTasks.size(), std::memory_order_acq_rel);
+			}
+			for (std::function<void()>& task : dueTasks) {
+				this->Submit(std::move(task));
+			}
+		}
+
+		bool PopTask(size_t queue_index_, bool from_back_, std::function<void()>& task_) {
+			WorkerQueue& queue = *this->m_queues[queue_index_];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty()) {
+				return false;
+			}
+			if (from_back_) {
+				task_ = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			else {
+				task_ = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			this->m_pendingTaskNum.fetch_sub(1, std::memory_order_acq_rel);
+			return true;
+		}
+
+	public:
+
+		~ThreadPool() {
+			this->StopWorkers();
+		}
+
+		size_t GetWorkerNum() const noexcept {
+			return this->m_workers.size();
+		}
+
+		// 重新设置工作线程数（0 表示硬件线程数），只能在没有任务运行时调用，未到期的定时任务会被丢弃
+		void SetWorkerNum(size_t worker_num_) {
+			if (worker_num_ == 0) {
+				worker_num_ = (std::max)(std::thread::hardware_concurrency(), 1u);
+			}
+			if (worker_num_ == this->m_workers.size()) {
+				return;
+			}
+			this->StopWorkers();
+			this->m_timerTasks.clear();
+			this->m_timerTaskNum.store(0, std::memory_order_release);
+			this->m_pendingTaskNum.store(0, std::memory_order_release);
+			this->StartWorkers(worker_num_);
+		}
+
+		// 当前线程是否是本线程池的工作线程
+		bool IsWorkerThread() const noexcept {
+			return ThreadPool::st_pool == this;
+		}
+
+		// 提交任务：工作线程放入自己的队列，其他线程轮流放入各个队列
+		void Submit(std::function<void()> task_) {
+			size_t queueIndex = this->IsWorkerThread() ? ThreadPool::st_workerIndex
+				: this->m_nextQueueIndex.fetch_add(1, std::memory_order_relaxed) % this->m_queues.size();
+			{
+				std::lock_guard<std::mutex> lock(this->m_queues[queueIndex]->mutex);
+				this->m_queues[queueIndex]->tasks.push_back(std::move(task_));
+			}
+			bool hasWaiter = false;
+			{
+				std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+				this->m_pendingTaskNum.fetch_add(1, std::memory_order_acq_rel);
+				hasWaiter = this->m_waitingNum.load(std::memory_order_relaxed) > 0;
+			}
+			// 被唤醒的 WaitUntil 可能发现条件已经成立而直接返回，这时要唤醒所有线程，免得任务没人执行
+			if (hasWaiter) {
+				this->m_sleepCondition.notify_all();
+			}
+			else {
+				this->m_sleepCondition.notify_one();
+			}
+		}
+
+		// 在 time_point_ 之后执行任务；等待期间不占用工作线程
+		void SubmitAt(std::chrono::steady_clock::time_point time_point_, std::function<void()> task_) {
+			{
+				std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+				this->m_timerTasks.emplace(time_point_, std::move(task_));
+				this->m_timerTaskNum.fetch_add(1, std::memory_order_acq_rel);
+			}
+			// 新任务可能比正在等待的到期时间更早，唤醒所有空闲线程重新计算等待时间
+			this->m_sleepCondition.notify_all();
+		}
+
+		// 执行一个任务（先取自己的，再偷别人的），没有任务时返回 false
+		bool TryRunOneTask() {
+			this->SubmitDueTimerTasks();
+			std::function<void()> task;
+			size_t queueNum = this->m_queues.size();
+			size_t beginIndex = this->IsWorkerThread() ? ThreadPool::st_workerIndex : 0;
+			bool isFound = this->IsWorkerThread() && this->PopTask(beginIndex, true, task);
+			for (size_t i = 1; i <= queueNum && !isFound; ++i) {
+				isFound = this->PopTask((beginIndex + i) % queueNum, false, task);
+			}
+			if (!isFound) {
+				return false;
+			}
+			task();
+			// 任务可能让某个 WaitUntil 的条件成立（与 WaitUntil 中的栅栏配对，不会漏掉唤醒）
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (this->m_waitingNum.load(std::memory_order_relaxed) > 0) {
+				this->NotifyWaiters();
+			}
+			return true;
+		}
+
+		// 唤醒阻塞在 WaitUntil 中的线程，让它们重新检查条件（条件由任务以外的事件改变时调用，如停止请求）
+		void NotifyWaiters() {
+			{
+				std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+			}
+			this->m_sleepCondition.notify_all();
+		}
+
+		// 等待 is_done_() 返回 true：先帮忙执行队列中的任务，没有可执行的任务时阻塞，
+		// 直到有新任务、定时任务到期或某个任务执行完（随后重新检查条件），不会空转占用 CPU
+		template<typename Pred>
+		void WaitUntil(Pred&& is_done_) {
+			while (!is_done_()) {
+				if (this->TryRunOneTask()) {
+					continue;
+				}
+				std::unique_lock<std::mutex> lock(this->m_sleepMutex);
+				this->m_waitingNum.fetch_add(1, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!is_done_() && !this->m_stop && this->m_pendingTaskNum.load(std::memory_order_acquire) == 0) {
+					this->SleepUntilWork(lock);
+				}
+				this->m_waitingNum.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		// 并行执行两个函数，返回时两者都已完成；等待期间当前线程会帮忙执行其他任务，因此可以嵌套调用
+		// 两个函数抛出的异常会在当前线程重新抛出（都抛出时保留第一个函数的异常）
+		void ParallelInvoke(const std::function<void()>& func1_, const std::function<void()>& func2_) {
+			struct SharedState {
+				std::atomic<bool> isDone = false;
+				std::exception_ptr exception;
+			};
+			auto state = std::make_shared<SharedState>();
+			this->Submit([state, &func2_]() {
+				try {
+					func2_();
+				}
+				catch (...) {
+					state->exception = std::current_exception();
+				}
+				state->isDone.store(true, std::memory_order_release);
+			});
+			std::exception_ptr exception;
+			try {
+				func1_();
+			}
+			catch (...) {
+				exception = std::current_exception();
+			}
+			this->WaitUntil([&state]() {
+				return state->isDone.load(std::memory_order_acquire);
+			});
+			if (exception) {
+				std::rethrow_exception(exception);
+			}
+			if (state->exception) {
+				std::rethrow_exception(state->exception);
+			}
+		}
+
+		// 把 [begin_, end_) 二分成不小于 grain_size_ 的小段，并行调用 func_(段首, 段尾)
+		void ParallelFor(size_t begin_, size_t end_, size_t grain_size_, const std::function<void(size_t, size_t)>& func_) {
+			grain_size_ = (std::max)(grain_size_, static_cast<size_t>(1));
+			if (end_ - begin_ <= grain_size_) {
+				if (begin_ < end_) {
+					func_(begin_, end_);
+				}
+				return;
+			}
+			size_t middle = begin_ + (end_ - begin_) / 2;
+			this->ParallelInvoke(
+				[&]() { this->ParallelFor(begin_, middle, grain_size_, func_); },
+				[&]() { this->ParallelFor(middle, end_, grain_size_, func_); });
+		}
+
+		// 等待 latch_ 归零；工作线程等待时帮忙执行任务，避免所有工作线程都在等待而死锁
+		void Wait(std::latch& latch_) {
+			if (!this->IsWorkerThread()) {
+				latch_.wait();
+				return;
+			}
+			this->WaitUntil([&latch_]() {
+				return latch_.try_wait();
+			});
+		}
+
+		friend inline ThreadPool& GetThreadPool();
+
+	};
+
+	// 获取线程池实例，工作线程数为硬件线程数
+	inline ThreadPool& GetThreadPool() {
+		static ThreadPool instance((std::max)(std::thread::hardware_concurrency(), 1u));
+		return instance;
+	}
+
+}
\ No newline at end of file
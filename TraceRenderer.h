@@ -0,0 +1,197 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColumnAggregate.h"
+#include "FrameBuffer.h"
+#include "StripStyle.h"
+#include "Tracer.h"
+
+namespace NVisualSort {
+
+	// 把操作记录回放渲染到 FrameBuffer 上，不依赖界面：条形的位置、高度、颜色与界面中的 Strip 相同（见 StripStyle.h，画布顶部即条形区域顶部）
+	// 每帧先用 ApplyRecord 执行若干条记录，再用 RenderFrame 只重绘这些记录改动过的条形，最后一条记录涉及的条形高亮
+	// 数据比画布宽度多时与界面的回放模式一样按列显示，重绘的是改动过的像素列
+	class TraceRenderer {
+
+	public:
+
+		struct Highlight {
+			uint32_t index = TraceNoIndex;
+			uint32_t color = 0;
+		};
+
+	private:
+
+		FrameBuffer m_frameBuffer;
+		std::vector<int> m_data;
+		int m_maxValue = 1;
+		bool m_hasFrame = false; // 条形较少时与界面一样带 1 像素黑色边框
+		bool m_isColumnMode = false;
+		ColumnAggregate m_columnAggregate;
+		std::vector<uint8_t> m_isDirty; // 按列显示时以列为单位
+		std::vector<uint32_t> m_dirtyIndices;
+		std::array<Highlight, 2> m_highlights{};
+
+		void MarkDirty(uint32_t index_) {
+			if (index_ == TraceNoIndex) {
+				return;
+			}
+			if (this->m_isColumnMode) {
+				index_ = static_cast<uint32_t>(this->m_columnAggregate.GetColumnIndex(index_));
+			}
+			if (!this->m_isDirty[index_]) {
+				this->m_isDirty[index_] = 1;
+				this->m_dirtyIndices.push_back(index_);
+			}
+		}
+
+		// 画布只有条形区域，上面没有留给标题的部分
+		int GetTopOfValue(int value_) const noexcept {
+			return ComputeStripTop(this->m_frameBuffer.GetHeight(), value_, this->m_maxValue, 0, 1);
+		}
+
+		uint32_t GetStripColor(int value_) const noexcept {
+			return ComputeStripColor(value_, this->m_maxValue);
+		}
+
+		void DrawStrip(size_t index_, uint32_t color_) {
+			size_t width = static_cast<size_t>(this->m_frameBuffer.GetWidth());
+			int height = this->m_frameBuffer.GetHeight();
+			int left = ComputeStripEdge(index_, this->m_data.size(), width);
+			int right = ComputeStripEdge(index_ + 1, this->m_data.size(), width);
+			int top = this->GetTopOfValue(this->m_data[index_]);
+			this->m_frameBuffer.ClearRectangle(left, 0, right, top - 1);
+			if (this->m_hasFrame) {
+				this->m_frameBuffer.SolidRectangle(left, top, right, height - 1, StripFrameColor);
+				this->m_frameBuffer.SolidRectangle(left + 1, top + 1, right - 1, height - 2, color_);
+			}
+			else {
+				this->m_frameBuffer.SolidRectangle(left, top, right, height - 1, color_);
+			}
+		}
+
+		void DrawColumn(size_t column_, uint32_t color_, bool is_highlight_) {
+			ColumnAggregate::Column column = this->m_columnAggregate.GetColumn(column_, [this](size_t index_) {
+				return this->m_data[index_];
+			});
+			int x = static_cast<int>(column_);
+			int maxTop = this->GetTopOfValue(column.maxValue);
+			int meanTop = this->GetTopOfValue(column.meanValue);
+			this->m_frameBuffer.ClearRectangle(x, 0, x, maxTop - 1);
+			this->m_frameBuffer.SolidRectangle(x, maxTop, x, meanTop - 1, StripRangeColor);
+			this->m_frameBuffer.SolidRectangle(x, meanTop, x, this->m_frameBuffer.GetHeight() - 1, is_highlight_ ? color_ : this->GetStripColor(column.meanValue));
+		}
+
+	public:
+
+		TraceRenderer(int width_, int height_, const std::vector<int>& data_, uint32_t background_color_ = 0) : m_frameBuffer(width_, height_, background_color_) {
+			this->SetData(data_);
+		}
+
+		const FrameBuffer& GetFrameBuffer() const noexcept {
+			return this->m_frameBuffer;
+		}
+
+		const std::vector<int>& GetData() const noexcept {
+			return this->m_data;
+		}
+
+		// 换成新的数据（如跳转之后）并整体重绘，不保留高亮
+		void SetData(const std::vector<int>& data_) {
+			if (data_.empty()) {
+				throw WideError(L"渲染的数据为空！");
+			}
+			this->m_data = data_;
+			this->m_maxValue = (std::max)(*std::max_element(data_.begin(), data_.end()), 1);
+			size_t width = static_cast<size_t>(this->m_frameBuffer.GetWidth());
+			this->m_hasFrame = GetIsStripFramed(data_.size(), width);
+			this->m_isColumnMode = data_.size() > width;
+			this->m_isDirty.assign(this->m_isColumnMode ? width : data_.size(), 0);
+			this->m_dirtyIndices.clear();
+			this->m_highlights = {};
+			this->m_frameBuffer.Clear();
+			if (this->m_isColumnMode) {
+				this->m_columnAggregate.Build(data_.size(), width, [this](size_t index_) {
+					return this->m_data[index_];
+				});
+				for (size_t column = 0; column < width; ++column) {
+					this->DrawColumn(column, 0, false);
+				}
+				return;
+			}
+			for (size_t i = 0; i < this->m_data.size(); ++i) {
+				this->DrawStrip(i, this->GetStripColor(this->m_data[i]));
+			}
+		}
+
+		// 执行一条记录，不绘制；高亮移到这条记录涉及的条形上
+		void ApplyRecord(const TraceRecord& record_) {
+			if (this->m_isColumnMode && (record_.opcode == TraceOpcode::Write || record_.opcode == TraceOpcode::Swap)) {
+				int oldValueA = record_.indexA < this->m_data.size() ? this->m_data[record_.indexA] : 0;
+				int oldValueB = record_.indexB < this->m_data.size() ? this->m_data[record_.indexB] : 0;
+				TraceReplayer::ApplyRecord(this->m_data, record_);
+				this->m_columnAggregate.Update(record_.indexA, oldValueA, this->m_data[record_.indexA]);
+				if (record_.opcode == TraceOpcode::Swap) {
+					this->m_columnAggregate.Update(record_.indexB, oldValueB, this->m_data[record_.indexB]);
+				}
+			}
+			else {
+				TraceReplayer::ApplyRecord(this->m_data, record_);
+			}
+			for (const Highlight& highlight : this->m_highlights) {
+				this->MarkDirty(highlight.index);
+			}
+			std::array<uint32_t, 2> colors = GetRecordHighlightColors(record_.opcode);
+			this->m_highlights = { Highlight{ record_.indexA, colors[0] }, Highlight{ record_.indexB, colors[1] } };
+			this->MarkDirty(record_.indexA);
+			this->MarkDirty(record_.indexB);
+		}
+
+		// 去掉高亮（最后一帧恢复原色）
+		void ClearHighlights() {
+			for (const Highlight& highlight : this->m_highlights) {
+				this->MarkDirty(highlight.index);
+			}
+			this->m_highlights = {};
+		}
+
+		// 重绘上一帧以来改动过的条形，返回重绘的条形数（按列显示时为列数）
+		size_t RenderFrame() {
+			if (this->m_isColumnMode) {
+				for (uint32_t column : this->m_dirtyIndices) {
+					uint32_t color = 0;
+					bool isHighlight = false;
+					for (const Highlight& highlight : this->m_highlights) {
+						if (highlight.index != TraceNoIndex && this->m_columnAggregate.GetColumnIndex(highlight.index) == column) {
+							color = highlight.color;
+							isHighlight = true;
+						}
+					}
+					this->DrawColumn(column, color, isHighlight);
+					this->m_isDirty[column] = 0;
+				}
+				size_t drawnNum = this->m_dirtyIndices.size();
+				this->m_dirtyIndices.clear();
+				return drawnNum;
+			}
+			for (uint32_t index : this->m_dirtyIndices) {
+				uint32_t color = this->GetStripColor(this->m_data[index]);
+				for (const Highlight& highlight : this->m_highlights) {
+					if (highlight.index == index) {
+						color = highlight.color;
+					}
+				}
+				this->DrawStrip(index, color);
+				this->m_isDirty[index] = 0;
+			}
+			size_t drawnNum = this->m_dirtyIndices.size();
+			this->m_dirtyIndices.clear();
+			return drawnNum;
+		}
+
+	};
+
+}
\ No newline at end of file
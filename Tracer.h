@@ -0,0 +1,476 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Element.h"
+#include "WideError.h"
+
+namespace NVisualSort {
+
+	// 操作记录的类别
+	enum class TraceOpcode : uint8_t {
+		Compare, // 比较 a 与 b（b 不在数组中时 value 为参与比较的值）
+		Read,    // 读取 a（拷贝、转换为 int、参与算术运算），value 为读到的值
+		Write,   // 写入 a，value 为写入后的值，b 为来源下标（来源不在数组中时为 TraceNoIndex）
+		Swap     // 交换 a 与 b
+	};
+
+	constexpr uint32_t TraceNoIndex = 0xFFFFFFFF; // 不在被记录数组中的元素（临时变量、缓冲区）
+
+	// 一条操作记录，固定 16 字节
+	struct TraceRecord {
+		uint32_t indexA = TraceNoIndex;
+		uint32_t indexB = TraceNoIndex;
+		int32_t value = 0;
+		TraceOpcode opcode = TraceOpcode::Compare;
+		uint8_t reserved[3] = {};
+	};
+	static_assert(sizeof(TraceRecord) == 16, "TraceRecord 必须是 16 字节");
+
+	// 操作记录器：记录分块保存在内存中，块在构造时预先分配，不够时再按需分配
+	// 多个线程追加时用一个原子计数分配位置（无锁，但每条多一次原子加法）；只有一个线程追加时直接移动当前块中的游标，与写普通数组一样快
+	class TraceRecorder {
+
+	private:
+
+		static constexpr size_t ChunkBits = 16;
+		static constexpr size_t ChunkSize = static_cast<size_t>(1) << ChunkBits; // 每块 65536 条记录（1 MiB）
+		static constexpr char FileMagic[8] = { 'V','S','T','R','A','C','E','1' };
+
+		std::vector<int> m_initialData; // 排序前的数据
+		std::unique_ptr<std::atomic<TraceRecord*>[]> m_chunks;
+		size_t m_maxChunkNum = 0;
+		std::atomic<size_t> m_recordNum = 0; // 多线程追加时的记录数；单线程追加时是当前块之前的记录数
+
+		// 单线程追加时的游标：写到 m_cursor，当前块在 m_chunkEnd 结束；多线程追加时两者都为空，Append 总是走原子计数
+		TraceRecord* m_cursor = nullptr;
+		TraceRecord* m_chunkEnd = nullptr;
+
+		// 块不做初始化，只在分配时逐页写一遍，让缺页发生在这里而不是逐条追加时
+		static TraceRecord* NewChunk() {
+			TraceRecord* chunk = static_cast<TraceRecord*>(::operator new[](ChunkSize * sizeof(TraceRecord)));
+			std::memset(static_cast<void*>(chunk), 0, ChunkSize * sizeof(TraceRecord));
+			return chunk;
+		}
+
+		TraceRecord* GetChunk(size_t chunk_index_) {
+			TraceRecord* chunk = this->m_chunks[chunk_index_].load(std::memory_order_acquire);
+			if (chunk != nullptr) {
+				return chunk;
+			}
+			TraceRecord* newChunk = TraceRecorder::NewChunk();
+			if (this->m_chunks[chunk_index_].compare_exchange_strong(chunk, newChunk, std::memory_order_acq_rel)) {
+				return newChunk;
+			}
+			::operator delete[](newChunk); // 别的线程已经分配了
+			return chunk;
+		}
+
+		// 单线程追加时把游标移到第 chunk_index_ 块的开头
+		void MoveCursorToChunk(size_t chunk_index_) {
+			if (chunk_index_ >= this->m_maxChunkNum) {
+				throw WideError(L"操作记录超过上限！");
+			}
+			this->m_cursor = this->GetChunk(chunk_index_);
+			this->m_chunkEnd = this->m_cursor + ChunkSize;
+			this->m_recordNum.store(chunk_index_ * ChunkSize, std::memory_order_relaxed);
+		}
+
+		void AppendSlow(const TraceRecord& record_) {
+			if (this->m_cursor != nullptr) {
+				// 单线程追加，当前块已满
+				this->MoveCursorToChunk(this->m_recordNum.load(std::memory_order_relaxed) / ChunkSize + 1);
+				*this->m_cursor++ = record_;
+				return;
+			}
+			size_t recordIndex = this->m_recordNum.fetch_add(1, std::memory_order_relaxed);
+			size_t chunkIndex = recordIndex >> ChunkBits;
+			if (chunkIndex >= this->m_maxChunkNum) {
+				this->m_recordNum.fetch_sub(1, std::memory_order_relaxed);
+				throw WideError(L"操作记录超过上限！");
+			}
+			this->GetChunk(chunkIndex)[recordIndex & (ChunkSize - 1)] = record_;
+		}
+
+	public:
+
+		// max_record_num_：最多记录多少条，超过时抛出异常；preallocate_record_num_：预先分配多少条的空间
+		explicit TraceRecorder(size_t max_record_num_ = static_cast<size_t>(1) << 28, size_t preallocate_record_num_ = ChunkSize) {
+			this->m_maxChunkNum = (std::max)((max_record_num_ + ChunkSize - 1) / ChunkSize, static_cast<size_t>(1));
+			this->m_chunks = std::make_unique<std::atomic<TraceRecord*>[]>(this->m_maxChunkNum);
+			for (size_t i = 0; i < this->m_maxChunkNum; ++i) {
+				this->m_chunks[i].store(nullptr, std::memory_order_relaxed);
+			}
+			this->Reserve(preallocate_record_num_);
+		}
+		TraceRecorder(const TraceRecorder&) = delete;
+		TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+		~TraceRecorder() {
+			for (size_t i = 0; i < this->m_maxChunkNum; ++i) {
+				::operator delete[](this->m_chunks[i].load(std::memory_order_relaxed));
+			}
+		}
+
+		// 清空记录并保存初始数据，已分配的块会被复用
+		// is_single_writer_ 为 true 时只允许一个线程追加（或各线程的追加之间有同步），追加不用原子操作
+		void Begin(const std::vector<int>& initial_data_, bool is_single_writer_ = false) {
+			this->m_initialData = initial_data_;
+			this->m_cursor = nullptr;
+			this->m_chunkEnd = nullptr;
+			this->m_recordNum.store(0, std::memory_order_release);
+			if (is_single_writer_) {
+				this->MoveCursorToChunk(0);
+			}
+		}
+
+		// 预先分配并写入足够 record_num_ 条记录的块（超过上限的部分忽略），在计时开始之前调用，追加时不再缺页
+		void Reserve(size_t record_num_) {
+			size_t chunkNum = (std::min)((record_num_ + ChunkSize - 1) / ChunkSize, this->m_maxChunkNum);
+			for (size_t i = 0; i < chunkNum; ++i) {
+				this->GetChunk(i);
+			}
+		}
+
+		void Append(const TraceRecord& record_) {
+			if (this->m_cursor != this->m_chunkEnd) {
+				*this->m_cursor++ = record_;
+				return;
+			}
+			this->AppendSlow(record_);
+		}
+
+		size_t GetRecordNum() const noexcept {
+			size_t recordNum = this->m_recordNum.load(std::memory_order_acquire);
+			if (this->m_cursor != nullptr) {
+				recordNum += ChunkSize - static_cast<size_t>(this->m_chunkEnd - this->m_cursor);
+			}
+			return recordNum;
+		}
+
+		const std::vector<int>& GetInitialData() const noexcept {
+			return this->m_initialData;
+		}
+
+		// 第 record_index_ 条记录，只能在记录结束后读取
+		const TraceRecord& GetRecord(size_t record_index_) const {
+			return this->m_chunks[record_index_ >> ChunkBits].load(std::memory_order_acquire)[record_index_ & (ChunkSize - 1)];
+		}
+
+		// 按块依次访问所有记录：func_(记录数组, 条数)
+		void ForEachChunk(const std::function<void(const TraceRecord*, size_t)>& func_) const {
+			size_t recordNum = this->GetRecordNum();
+			for (size_t begin = 0; begin < recordNum; begin += ChunkSize) {
+				func_(this->m_chunks[begin >> ChunkBits].load(std::memory_order_acquire), (std::min)(ChunkSize, recordNum - begin));
+			}
+		}
+
+		// 文件格式：8 字节标识，uint64 数据量，uint64 记录数，int32 初始数据，然后是所有记录
+		void SaveToFile(const std::string& path_) const {
+			std::ofstream file(path_, std::ios::binary);
+			if (!file) {
+				throw WideError(L"无法创建记录文件！");
+			}
+			uint64_t dataSize = this->m_initialData.size();
+			uint64_t recordNum = this->GetRecordNum();
+			file.write(FileMagic, sizeof(FileMagic));
+			file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+			file.write(reinterpret_cast<const char*>(&recordNum), sizeof(recordNum));
+			file.write(reinterpret_cast<const char*>(this->m_initialData.data()), static_cast<std::streamsize>(dataSize * sizeof(int32_t)));
+			this->ForEachChunk([&file](const TraceRecord* records_, size_t record_num_) {
+				file.write(reinterpret_cast<const char*>(records_), static_cast<std::streamsize>(record_num_ * sizeof(TraceRecord)));
+			});
+			if (!file) {
+				throw WideError(L"写入记录文件失败！");
+			}
+		}
+
+		void LoadFromFile(const std::string& path_) {
+			std::ifstream file(path_, std::ios::binary);
+			char magic[sizeof(FileMagic)] = {};
+			uint64_t dataSize = 0;
+			uint64_t recordNum = 0;
+			file.read(magic, sizeof(magic));
+			file.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
+			file.read(reinterpret_cast<char*>(&recordNum), sizeof(recordNum));
+			if (!file || std::memcmp(magic, FileMagic, sizeof(FileMagic)) != 0) {
+				throw WideError(L"不是有效的记录文件！");
+			}
+			if (recordNum > this->m_maxChunkNum * ChunkSize) {
+				throw WideError(L"操作记录超过上限！");
+			}
+			std::vector<int> initialData(dataSize);
+			file.read(reinterpret_cast<char*>(initialData.data()), static_cast<std::streamsize>(dataSize * sizeof(int32_t)));
+			this->Begin(initialData);
+			for (size_t begin = 0; begin < recordNum; begin += ChunkSize) {
+				size_t chunkRecordNum = (std::min)(static_cast<size_t>(recordNum - begin), ChunkSize);
+				file.read(reinterpret_cast<char*>(this->GetChunk(begin >> ChunkBits)), static_cast<std::streamsize>(chunkRecordNum * sizeof(TraceRecord)));
+			}
+			if (!file) {
+				throw WideError(L"记录文件不完整！");
+			}
+			this->m_recordNum.store(recordNum, std::memory_order_release);
+		}
+
+	};
+
+	// 操作回放器：从初始数据开始逐条执行记录，随时可以取得当前数组
+	// 只有写入与交换会改变数组，比较与读取只用于显示
+	class TraceReplayer {
+
+		friend class TraceTimeline;
+
+	private:
+
+		const TraceRecorder* m_recorder = nullptr;
+		std::vector<int> m_data;
+		size_t m_position = 0; // 下一条要执行的记录
+
+	public:
+
+		explicit TraceReplayer(const TraceRecorder& recorder_) : m_recorder(&recorder_), m_data(recorder_.GetInitialData()) {}
+
+		// 把一条记录作用到 data_ 上，下标越界时抛出异常（记录可能来自文件）
+		static void ApplyRecord(std::vector<int>& data_, const TraceRecord& record_) {
+			if ((record_.indexA != TraceNoIndex && record_.indexA >= data_.size())
+				|| (record_.indexB != TraceNoIndex && record_.indexB >= data_.size())) {
+				throw WideError(L"操作记录的下标越界！");
+			}
+			if (record_.opcode == TraceOpcode::Write) {
+				data_[record_.indexA] = record_.value;
+			}
+			else if (record_.opcode == TraceOpcode::Swap) {
+				std::swap(data_[record_.indexA], data_[record_.indexB]);
+			}
+		}
+
+		const std::vector<int>& GetData() const noexcept {
+			return this->m_data;
+		}
+
+		size_t GetPosition() const noexcept {
+			return this->m_position;
+		}
+
+		size_t GetRecordNum() const noexcept {
+			return this->m_recorder->GetRecordNum();
+		}
+
+		bool IsEnd() const noexcept {
+			return this->m_position >= this->GetRecordNum();
+		}
+
+		// 回到初始数据
+		void Reset() {
+			this->m_data = this->m_recorder->GetInitialData();
+			this->m_position = 0;
+		}
+
+		// 执行下一条记录并返回它，只能在 IsEnd() 为 false 时调用
+		const TraceRecord& Step() {
+			const TraceRecord& record = this->m_recorder->GetRecord(this->m_position);
+			TraceReplayer::ApplyRecord(this->m_data, record);
+			++this->m_position;
+			return record;
+		}
+
+	};
+
+	// 回放时间轴：每隔 K 条记录保存一份完整数组（关键帧），跳转到任意位置只需从前一个关键帧开始回放，耗时 O(n + K)
+	// 关键帧总大小不超过内存上限：超过时丢掉一半关键帧，K 翻倍
+	class TraceTimeline {
+
+	private:
+
+		const TraceRecorder* m_recorder = nullptr;
+		size_t m_memoryLimit = 0;
+		size_t m_interval = 0; // K
+		std::vector<std::vector<int>> m_keyframes; // 第 i 个关键帧是执行完前 i * K 条记录后的数组
+
+		// 只保留偶数下标的关键帧，K 翻倍
+		void HalveKeyframes() {
+			size_t keptNum = 0;
+			for (size_t i = 0; i < this->m_keyframes.size(); i += 2, ++keptNum) {
+				if (keptNum != i) {
+					this->m_keyframes[keptNum] = std::move(this->m_keyframes[i]);
+				}
+			}
+			this->m_keyframes.resize(keptNum);
+			this->m_interval *= 2;
+		}
+
+	public:
+
+		static constexpr size_t DefaultMemoryLimit = static_cast<size_t>(64) << 20; // 64 MiB
+		static constexpr size_t MinInterval = 256;
+
+		// 回放一遍记录生成关键帧；初始数据总会保存，即使它本身就超过上限
+		explicit TraceTimeline(const TraceRecorder& recorder_, size_t memory_limit_ = TraceTimeline::DefaultMemoryLimit)
+			: m_recorder(&recorder_), m_memoryLimit(memory_limit_), m_interval(TraceTimeline::MinInterval) {
+			std::vector<int> data = recorder_.GetInitialData();
+			size_t keyframeSize = (std::max)(data.size() * sizeof(int), static_cast<size_t>(1));
+			size_t recordNum = recorder_.GetRecordNum();
+			this->m_keyframes.push_back(data);
+			for (size_t position = 0; position < recordNum; ++position) {
+				TraceReplayer::ApplyRecord(data, recorder_.GetRecord(position));
+				if ((position + 1) % this->m_interval == 0) {
+					while (this->m_keyframes.size() > 1 && (this->m_keyframes.size() + 1) * keyframeSize > this->m_memoryLimit) {
+						this->HalveKeyframes();
+					}
+					if ((position + 1) % this->m_interval == 0 && (this->m_keyframes.size() + 1) * keyframeSize <= this->m_memoryLimit) {
+						this->m_keyframes.push_back(data);
+					}
+				}
+			}
+		}
+
+		size_t GetInterval() const noexcept {
+			return this->m_interval;
+		}
+
+		size_t GetKeyframeNum() const noexcept {
+			return this->m_keyframes.size();
+		}
+
+		size_t GetMemoryUsage() const noexcept {
+			return this->m_keyframes.size() * this->m_recorder->GetInitialData().size() * sizeof(int);
+		}
+
+		// 让 replayer_ 跳到执行完前 position_ 条记录的状态（超过记录数时跳到末尾）
+		void Seek(TraceReplayer& replayer_, size_t position_) const {
+			position_ = (std::min)(position_, this->m_recorder->GetRecordNum());
+			size_t keyframeIndex = (std::min)(position_ / this->m_interval, this->m_keyframes.size() - 1);
+			size_t position = keyframeIndex * this->m_interval;
+			// 向后跳且不超过一个间隔时，从当前状态继续回放更快
+			if (replayer_.m_position <= position_ && replayer_.m_position >= position) {
+				position = replayer_.m_position;
+			}
+			else {
+				replayer_.m_data = this->m_keyframes[keyframeIndex];
+			}
+			for (; position < position_; ++position) {
+				TraceReplayer::ApplyRecord(replayer_.m_data, this->m_recorder->GetRecord(position));
+			}
+			replayer_.m_position = position_;
+		}
+
+	};
+
+	// 记录策略，用法与 Counter 相同：只有被记录数组中的元素参与的操作才会被记录
+	// 元素在数组中的下标由地址算出，所以排序过程中不能让被记录的数组重新分配内存
+	template<typename T>
+	class TracePolicy {
+
+	private:
+
+		inline static TraceRecorder* s_recorder = nullptr;
+		inline static const T* s_begin = nullptr;
+		inline static const T* s_end = nullptr;
+
+		static uint32_t GetIndex(const T& element_) noexcept {
+			if (!std::less<const T*>{}(&element_, TracePolicy::s_begin) && std::less<const T*>{}(&element_, TracePolicy::s_end)) {
+				return static_cast<uint32_t>(&element_ - TracePolicy::s_begin);
+			}
+			return TraceNoIndex;
+		}
+
+		static void Record(TraceOpcode opcode_, uint32_t index_a_, uint32_t index_b_, int value_) {
+			if (TracePolicy::s_recorder != nullptr && (index_a_ != TraceNoIndex || index_b_ != TraceNoIndex)) {
+				TraceRecord record;
+				record.opcode = opcode_;
+				record.indexA = index_a_;
+				record.indexB = index_b_;
+				record.value = value_;
+				TracePolicy::s_recorder->Append(record);
+			}
+		}
+
+		static void RecordWrite(const T& element_, uint32_t source_index_ = TraceNoIndex) {
+			TracePolicy::Record(TraceOpcode::Write, TracePolicy::GetIndex(element_), source_index_, element_.GetValue());
+		}
+
+	protected:
+
+		static void OnCompare(const T& element_, int value_) {
+			TracePolicy::Record(TraceOpcode::Compare, TracePolicy::GetIndex(element_), TraceNoIndex, value_);
+		}
+		static void OnCompare(const T& element1_, const T& element2_) {
+			TracePolicy::Record(TraceOpcode::Compare, TracePolicy::GetIndex(element1_), TracePolicy::GetIndex(element2_), element2_.GetValue());
+		}
+		static void OnRead(const T& element_) {
+			TracePolicy::Record(TraceOpcode::Read, TracePolicy::GetIndex(element_), TraceNoIndex, element_.GetValue());
+		}
+		static void OnRead(const T& element1_, const T& element2_) {
+			TracePolicy::OnRead(element1_);
+			TracePolicy::OnRead(element2_);
+		}
+		static void OnWrite(const T& element_) {
+			TracePolicy::RecordWrite(element_);
+		}
+		static void OnAssign(const T& target_, const T& source_, bool) {
+			if (TracePolicy::GetIndex(target_) == TraceNoIndex) {
+				TracePolicy::OnRead(source_); // 从数组拷贝到临时变量只算一次读取
+			}
+			else {
+				TracePolicy::RecordWrite(target_, TracePolicy::GetIndex(source_));
+			}
+		}
+		static void OnUpdate(const T& target_, const T& source_) {
+			TracePolicy::OnRead(source_);
+			TracePolicy::RecordWrite(target_);
+		}
+		// 只有一方在数组中时（与缓冲区、临时变量交换），记录为对它的写入
+		static void OnSwap(const T& element1_, const T& element2_, bool) {
+			uint32_t index1 = TracePolicy::GetIndex(element1_);
+			uint32_t index2 = TracePolicy::GetIndex(element2_);
+			if (index1 != TraceNoIndex && index2 != TraceNoIndex) {
+				TracePolicy::Record(TraceOpcode::Swap, index1, index2, element1_.GetValue());
+			}
+			else if (index1 != TraceNoIndex) {
+				TracePolicy::RecordWrite(element1_);
+			}
+			else {
+				TracePolicy::RecordWrite(element2_);
+			}
+		}
+		static void OnSwap(const T& element_) {
+			TracePolicy::RecordWrite(element_);
+		}
+
+	public:
+
+		static constexpr bool IsDrawn = false;
+
+		static void AddSteps(size_t) noexcept {}
+
+		// 缓冲区不在记录的数组中，它的操作只作为临时变量出现在记录里
+		static void MarkAsArray(std::vector<T>&) noexcept {}
+
+		// 开始记录：把 data_ 拷贝到 tracers_，之后对 tracers_ 的操作都写入 recorder_（is_single_writer_ 见 TraceRecorder::Begin）
+		static void StartTracing(const std::vector<int>& data_, std::vector<T>& tracers_, TraceRecorder& recorder_, bool is_single_writer_ = false) {
+			tracers_.assign(data_.begin(), data_.end());
+			recorder_.Begin(data_, is_single_writer_);
+			TracePolicy::s_begin = tracers_.data();
+			TracePolicy::s_end = tracers_.data() + tracers_.size();
+			TracePolicy::s_recorder = &recorder_;
+		}
+
+		static void StopTracing() noexcept {
+			TracePolicy::s_recorder = nullptr;
+			TracePolicy::s_begin = nullptr;
+			TracePolicy::s_end = nullptr;
+		}
+
+	};
+
+	using Tracer = Element<TracePolicy>;
+
+}
\ No newline at end of file
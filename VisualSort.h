@@ -1,12 +1,16 @@
 #pragma once
 #include "Sort.h"
+#include "SortTimer.h"
 #include "Dialog.h"
 #include "ConfigManager.h"
 #include "Counter.h"
+#include "Tracer.h"
 #include "Button.h"
 #include "DrawingTool.h"
 #include "Sketch.h"
 #include "Strip.h"
+#include "FrameScheduler.h"
+#include "SortRace.h"
 #include <Windows.h>
 #include <easyx.h>
 #include <chrono>
@@ -15,6 +19,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 #include "Fraction.h"
 #include "WideError.h"
@@ -23,6 +28,8 @@
 #include "ScopeGuard.h"
 #include <shared_mutex>
 #include <cmath>
+#include <limits>
+#include <bit>
 #include <random>
 
 namespace NVisualSort {
@@ -39,18 +46,31 @@ namespace NVisualSort {
 		std::vector<int> m_intSortData;
 		std::vector<Counter> m_counterSortData;
 		std::vector<Strip> m_stripSortData;
+		std::vector<Tracer> m_tracerSortData;
+		TraceRecorder m_traceRecorder{ VisualSort::ReplayMaxRecordNum };
+		std::atomic<size_t> m_replayPosition = 0; // 已回放的记录数
+		std::atomic<size_t> m_seekTarget = VisualSort::NoSeekTarget; // 按钮线程请求跳转到的位置，由回放线程执行
+		Fraction m_timelineValue = 0; // 时间轴滑块当前的值（只在按钮线程读写）
+		size_t m_keyframeMemoryLimit = TraceTimeline::DefaultMemoryLimit; // 回放时间轴关键帧的内存上限
+		inline static constexpr size_t NoSeekTarget = static_cast<size_t>(-1);
+		inline static constexpr int ReplayScalableMaxSize = 8192;
+		inline static constexpr size_t ReplayMaxRecordNum = static_cast<size_t>(1) << 24; // 回放模式一次最多记录的条数（每条 16 字节，共 256 MiB），超过时排序报错
+		inline static constexpr size_t ReplayRecordsPerNLogN = 6; // 估计记录条数用：O(n log n) 的排序实测每 n log2(n) 约 2.5~6 条
+		inline static constexpr std::chrono::seconds ShufflePauseTime = std::chrono::seconds(1); // 展示打乱前后各停留的时间（暂停的时间不计入）
 
 		std::optional<size_t> m_sortIndex = std::nullopt;
 		std::vector<Sort> m_sorts;
 		bool m_showShuffle = false;
-		Fraction m_displaySpeed = Fraction(1, 2); // ʾٶȣÿһ DrawStrip˯ m_displaySpeed 룬̻߳ţ
+		bool m_replayMode = false; // 回放模式：先全速排序并记录每一步操作，再由当前线程按演示速度回放
+		Fraction m_displaySpeed = Fraction(1, 2); // 演示速度（每毫秒演示的操作数；欠下的睡眠时间攒够一帧才睡一次，各线程互不干扰）
 		std::shared_mutex m_speedMutex;
 
 		ButtonSequence m_controlButtons;
 		std::vector<Sketch> m_messages;
 
 		std::chrono::steady_clock::time_point m_stripSortBeginTime;
-		std::chrono::microseconds m_intSortDuration = {};
+		SortTimer m_intSortTimer; // int 排序计时器（预热后多次计时）
+		std::chrono::microseconds m_intSortDuration = {}; // int 排序耗时（多次计时的中位数）
 
 		VisualSort() {
 			this->m_initDataFunc = [](size_t data_size_, std::vector<int>& data_) {
@@ -59,34 +79,7 @@ namespace NVisualSort {
 					data_[dataIndex] = static_cast<int>(dataIndex + 1);
 				}
 			};
-			using namespace NSortAlgorithms;
-			this->m_sorts = {
-				Sort(L"",8,BogoSort<int>,BogoSort<Counter>,BogoSort<Strip>,{},true),
-				Sort(L"Ƥ",64,StoogeSort<int>,StoogeSort<Counter>,StoogeSort<Strip>),
-				Sort(L"˯",128,SleepSort<int>,SleepSort<Counter>,SleepSort<Strip>,{},true),
-				Sort(L"ѭ",256,CycleSort<int>,CycleSort<Counter>,CycleSort<Strip>),
-				Sort(L"ð",256,BubbleSort<int>,BubbleSort<Counter>,BubbleSort<Strip>),
-				Sort(L"˫ð",256,BidirectionalBubbleSort<int>,BidirectionalBubbleSort<Counter>,BidirectionalBubbleSort<Strip>),
-				Sort(L"ż",256,OddEvenSort<int>,OddEvenSort<Counter>,OddEvenSort<Strip>),
-				Sort(L"ѡ",256,SelectionSort<int>,SelectionSort<Counter>,SelectionSort<Strip>),
-				Sort(L"˫ѡ",256,BidirectionalSelectionSort<int>,BidirectionalSelectionSort<Counter>,BidirectionalSelectionSort<Strip>),
-				Sort(L"",256,InsertionSort<int>,InsertionSort<Counter>,InsertionSort<Strip>),
-				Sort(L"",256,BeadSort<int>,BeadSort<Counter>,BeadSort<Strip>),
-				Sort(L"",8192,CombSort<int>,CombSort<Counter>,CombSort<Strip>),
-				Sort(L"ϣ",8192,ShellSort<int>,ShellSort<Counter>,ShellSort<Strip>),
-				Sort(L"˫",8192,BitonicSort<int>,BitonicSort<Counter>,BitonicSort<Strip>,
-					{{L"Ϊ2",[](size_t data_size_)->bool { return ((data_size_ & (data_size_ - 1)) == 0) && data_size_ > 0; }}}),
-				Sort(L"鲢",8192,MergeSort<int>,MergeSort<Counter>,MergeSort<Strip>),
-				Sort(L"",8192,HeapSort<int>,HeapSort<Counter>,HeapSort<Strip>),
-				Sort(L"",8192,QuickSort<int>,QuickSort<Counter>,QuickSort<Strip>),
-				Sort(L"",8192,RadixSort<int>,RadixSort<Counter>,RadixSort<Strip>),
-				Sort(L"",32768,CountingSort<int>,CountingSort<Counter>,CountingSort<Strip>),
-				Sort(L"std::sort",8192,StdSort<int>,StdSort<Counter>,StdSort<Strip>),
-				Sort(L"std::sort",8192,StdSort_Parallel<int>,StdSort_Parallel<Counter>,StdSort_Parallel<Strip>,{},false,true),
-				Sort(L"std::stable_sort",8192,StdStableSort<int>,StdStableSort<Counter>,StdStableSort<Strip>),
-				Sort(L"std::sort_heap",8192,StdHeapSort<int>,StdHeapSort<Counter>,StdHeapSort<Strip>),
-				Sort(L"std::partial_sort",8192,StdPartialSort<int>,StdPartialSort<Counter>,StdPartialSort<Strip>)
-			};
+			this->m_sorts = CreateDefaultSorts();
 		}
 		VisualSort(const VisualSort&) = delete;
 		VisualSort(VisualSort&&) = delete;
@@ -95,64 +88,77 @@ namespace NVisualSort {
 
 		std::function<void()> GetSleepFunc() {
 			return [this]() {
-				static thread_local Fraction accum = 0;
+				using MillisecondsDouble = std::chrono::duration<double, std::milli>;
+				static thread_local MillisecondsDouble sleepDebt(0);
 				std::shared_lock lock(this->m_speedMutex);
 				static thread_local Fraction lastSpeed = this->m_displaySpeed;
 				Fraction currSpeed = this->m_displaySpeed;
 				lock.unlock();
 				if (lastSpeed != currSpeed) {
-					accum = 0;
+					sleepDebt = MillisecondsDouble(0);
 					lastSpeed = currSpeed;
 				}
-				accum += currSpeed.Reciprocal();
-				while (accum >= 1) {
-					long long ms = static_cast<long long>(accum);
-					std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-					accum -= ms;
+				// 每次操作只记账，攒够一帧再睡，睡过头的部分从下一帧里扣（最多扣一帧）
+				sleepDebt += MillisecondsDouble(static_cast<double>(currSpeed.Reciprocal()));
+				if (sleepDebt < FrameScheduler::DefaultFrameDuration) {
+					return;
 				}
+				Strip::FlushDirtyStrips(); // 这一帧画过的条形合并后一起刷新，再睡
+				auto sleepBeginTime = std::chrono::steady_clock::now();
+				std::this_thread::sleep_for(sleepDebt);
+				sleepDebt -= std::chrono::steady_clock::now() - sleepBeginTime;
+				sleepDebt = (std::max)(sleepDebt, MillisecondsDouble(-FrameScheduler::DefaultFrameDuration));
 			};
 		}
 
 		std::function<void(RECT, COLORREF)> GetDrawFunc() {
-			if (this->m_sourceData.size() * 6 > static_cast<size_t>(GetConfigManager().GetWidth())) {
+			if (!GetIsStripFramed(this->m_sourceData.size(), static_cast<size_t>(GetConfigManager().GetWidth()))) {
 				return [](RECT rect_, COLORREF color_) {
-					GetDrawingTool().SolidRectangle(rect_, color_);
+					GetDrawingTool().QueueSolidRectangle(rect_, color_);
 				};
 			}
 			else {
 				return [](RECT rect_, COLORREF color_) {
-					GetDrawingTool().FillRectangle(rect_, 1, PS_SOLID, BLACK, color_);
+					GetDrawingTool().QueueFillRectangle(rect_, 1, PS_SOLID, StripFrameColor, color_);
 				};
 			}
 		}
 
+		// 进度：(已演示步数, 总步数)；回放模式下按记录条数计算
+		std::pair<size_t, size_t> GetStepProgress() const {
+			if (this->m_replayMode) {
+				return { this->m_replayPosition.load(), (std::max)(this->m_traceRecorder.GetRecordNum(), static_cast<size_t>(1)) };
+			}
+			// 分片计数器每次读取都要求和，这里各读一次
+			return { AnimationStepNum.load(), ActualStepNum.load() };
+		}
+
 		std::atomic<size_t> m_updateMessageTime;
 		inline static constexpr size_t UpdateMessageGap = 10;
 
 		std::function<void()> GetUpdateMessageFunc() {
 			return [this]() {
-				std::unique_lock lock(Strip::s_threadsMutex);
-				size_t stripThreadNum = Strip::s_threads.size();
-				lock.unlock();
+				size_t stripThreadNum = Strip::s_drawThreadNum.load(std::memory_order_acquire);
 				if ((++this->m_updateMessageTime) % (VisualSort::UpdateMessageGap * stripThreadNum) != 0) {
 					return;
 				}
 				long long stripSortTime = (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()
 					- this->m_stripSortBeginTime)).count() - Strip::s_stripSortStopTime.count();
 				bool notShowProgress = this->m_sorts[this->m_sortIndex.value()].GetIsUnpredictable();
+				auto [animationStepNum, actualStepNum] = this->GetStepProgress();
 				this->m_messages[1].SetTextWithoutResize(
-					L"ʾʱ䣺" + std::to_wstring(stripSortTime / 1000) + L"." +
-					std::to_wstring((stripSortTime % 1000) / 100) + (notShowProgress ? L"s ʱ" : L"s ȣ") +
-					std::to_wstring(AnimationStepNum * this->m_intSortDuration.count() / ActualStepNum)
+					L"演示时间：" + std::to_wstring(stripSortTime / 1000) + L"." +
+					std::to_wstring((stripSortTime % 1000) / 100) + (notShowProgress ? L"s 排序时间" : L"s 排序进度：") +
+					std::to_wstring(animationStepNum * this->m_intSortDuration.count() / actualStepNum)
 					+ (notShowProgress ? L"us" : (L"us/" + std::to_wstring(this->m_intSortDuration.count()) + L"us = " +
-						std::to_wstring(AnimationStepNum * 100 / ActualStepNum) + L"." +
-						std::to_wstring((AnimationStepNum * 1000 / ActualStepNum) % 10) + L"%"))
+						std::to_wstring(animationStepNum * 100 / actualStepNum) + L"." +
+						std::to_wstring((animationStepNum * 1000 / actualStepNum) % 10) + L"%"))
 				);
 				this->m_messages[1].DrawSketch(false);
 				this->m_messages[2].SetTextWithoutResize(
-					L"Ƚϣ" + std::to_wstring(StripCompareNum) + L" " +
-					L"ã" + std::to_wstring(StripCopyNum) + L" " +
-					L"޸ģ" + std::to_wstring(StripChangeNum) + L"");
+					L"样本比较：" + std::to_wstring(StripCompareNum.load()) + L"次 " +
+					L"样本引用：" + std::to_wstring(StripCopyNum.load()) + L"次 " +
+					L"样本修改：" + std::to_wstring(StripChangeNum.load()) + L"次");
 				this->m_messages[2].DrawSketch(false);
 				GetDrawingTool().FlushBatchDraw(0, this->m_messages[1].GetTop(), GetConfigManager().GetWidth(), this->m_messages[2].GetBottom());
 			};
@@ -162,19 +168,20 @@ namespace NVisualSort {
 			long long stripSortTime = (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()
 				- this->m_stripSortBeginTime)).count() - Strip::s_stripSortStopTime.count();
 			bool notShowProgress = this->m_sorts[this->m_sortIndex.value()].GetIsUnpredictable();
+			auto [animationStepNum, actualStepNum] = this->GetStepProgress();
 			this->m_messages[1].SetTextWithoutResize(
-				L"ʾʱ䣺" + std::to_wstring(stripSortTime / 1000) + L"." +
-				std::to_wstring((stripSortTime % 1000) / 100) + (notShowProgress ? L"s ʱ" : L"s ȣ") +
-				std::to_wstring(AnimationStepNum * this->m_intSortDuration.count() / ActualStepNum)
+				L"演示时间：" + std::to_wstring(stripSortTime / 1000) + L"." +
+				std::to_wstring((stripSortTime % 1000) / 100) + (notShowProgress ? L"s 排序时间" : L"s 排序进度：") +
+				std::to_wstring(animationStepNum * this->m_intSortDuration.count() / actualStepNum)
 				+ (notShowProgress ? L"us" : (L"us/" + std::to_wstring(this->m_intSortDuration.count()) + L"us = " +
-					std::to_wstring(AnimationStepNum * 100 / ActualStepNum) + L"." +
-					std::to_wstring((AnimationStepNum * 1000 / ActualStepNum) % 10) + L"%"))
+					std::to_wstring(animationStepNum * 100 / actualStepNum) + L"." +
+					std::to_wstring((animationStepNum * 1000 / actualStepNum) % 10) + L"%"))
 			);
 			this->m_messages[1].DrawSketch();
 			this->m_messages[2].SetTextWithoutResize(
-				L"Ƚϣ" + std::to_wstring(StripCompareNum) + L" " +
-				L"ã" + std::to_wstring(StripCopyNum) + L" " +
-				L"޸ģ" + std::to_wstring(StripChangeNum) + L"");
+				L"样本比较：" + std::to_wstring(StripCompareNum.load()) + L"次 " +
+				L"样本引用：" + std::to_wstring(StripCopyNum.load()) + L"次 " +
+				L"样本修改：" + std::to_wstring(StripChangeNum.load()) + L"次");
 			this->m_messages[2].DrawSketch();
 		}
 
@@ -182,7 +189,7 @@ namespace NVisualSort {
 			this->m_messages.resize(3);
 			Sketch& titleSketch = this->m_messages[0];
 			titleSketch.SetSketch(0, 0, GetConfigManager().GetWidth(), Strip::StripMaxTop() / 4,
-				this->m_sorts[this->m_sortIndex.value()].GetSortName() + L" С" + std::to_wstring(this->m_sourceData.size()));
+				this->m_sorts[this->m_sortIndex.value()].GetSortName() + L" 样本大小：" + std::to_wstring(this->m_sourceData.size()));
 			GetDrawingTool().ExecuteWithLock([&titleSketch]() {
 				::settextstyle(titleSketch.GetTextSize(), 0, titleSketch.GetTypeface().c_str());
 				titleSketch.SetRightWithoutResize(::textwidth(titleSketch.GetText().c_str()) + (std::min)(titleSketch.GetHeight(), titleSketch.GetRight()) / 20);
@@ -191,49 +198,142 @@ namespace NVisualSort {
 
 			Sketch& timeSketch = this->m_messages[1];
 			timeSketch.SetHasFrame(false).SetTextMode(DT_LEFT).SetSketch(0, titleSketch.GetBottom(),
-				GetConfigManager().GetWidth(), Strip::StripMaxTop() / 2, L"ʾʱ䣺0.0s " +
-				std::wstring(this->m_sorts[this->m_sortIndex.value()].GetIsUnpredictable() ? L"ʱ䣺0us" : (L"ȣ0us/" + std::to_wstring(this->m_intSortDuration.count()) + L"us = 0%")));
+				GetConfigManager().GetWidth(), Strip::StripMaxTop() / 2, L"演示时间：0.0s 排序" +
+				std::wstring(this->m_sorts[this->m_sortIndex.value()].GetIsUnpredictable() ? L"时间：0us" : (L"进度：0us/" + std::to_wstring(this->m_intSortDuration.count()) + L"us = 0%")));
 
 			Sketch& countSketch = this->m_messages[2];
 			countSketch.SetHasFrame(false).SetTextMode(DT_LEFT).SetSketch(0, timeSketch.GetBottom(),
-				GetConfigManager().GetWidth(), Strip::StripMaxTop() * 3 / 4, L"Ƚϣ0 ã0 ޸ģ0");
+				GetConfigManager().GetWidth(), Strip::StripMaxTop() * 3 / 4, L"样本比较：0次 样本引用：0次 样本修改：0次");
+		}
+
+		// 是否由多个线程同时绘制（回放模式下只有当前线程绘制）
+		bool GetIsMulThreadDrawing() const {
+			return this->m_sorts[this->m_sortIndex.value()].GetIsMulThread() && !this->m_replayMode;
 		}
 
 		void SetControlButtonsAuto() {
 			this->m_controlButtons.Clear();
 			this->m_controlButtons.GetButtons().resize(2);
-			this->m_controlButtons.GetButtons()[0].SetButton(GetConfigManager().GetWidth() * 15 / 16, 0, GetConfigManager().GetWidth(), this->m_messages[0].GetBottom(), L"ͣ",
+			this->m_controlButtons.GetButtons()[0].SetButton(GetConfigManager().GetWidth() * 15 / 16, 0, GetConfigManager().GetWidth(), this->m_messages[0].GetBottom(), L"暂停",
 				[](Button& button_, ExMessage) {
-					if (Strip::s_stopStripSort.load(std::memory_order_acquire)) {
-						Strip::s_stopStripSort.store(false, std::memory_order_release);
-						button_.GetSketch().SetTextWithoutResize(L"ͣ");
+					if (Strip::s_pauseGate.GetIsPaused()) {
+						Strip::s_pauseGate.Resume();
+						button_.GetSketch().SetTextWithoutResize(L"暂停");
 					}
 					else {
-						Strip::s_stopStripSort.store(true, std::memory_order_release);
-						button_.GetSketch().SetTextWithoutResize(L"");
+						Strip::s_pauseGate.Pause();
+						button_.GetSketch().SetTextWithoutResize(L"继续");
 					}
 					Button::GetDefaultHoverDrawFunction()(button_, {});
 				}
 			);
 			this->m_controlButtons.GetButtons()[1].SetThumb(RECT(0, this->m_messages[2].GetBottom(), GetConfigManager().GetWidth(), Strip::StripMaxTop()),
-				Fraction(log10(static_cast<double>(this->m_displaySpeed)) + 1) / 2, [this](Fraction frac_) -> std::wstring {
+				Fraction(std::clamp((log10(static_cast<double>(this->m_displaySpeed)) + 1) / 2, 0.0, 1.0)), [this](Fraction frac_) -> std::wstring {
 					Fraction tempSpeed(pow(10.0, 2 * frac_ - 1));
 					std::unique_lock lock(this->m_speedMutex);
 					this->m_displaySpeed = tempSpeed;
 					lock.unlock();
 					int speed = static_cast<int>(frac_ * 100);
-					return L"ʾٶȣ" + std::to_wstring(speed < 1 ? 1 : speed);
+					return L"演示速度：" + std::to_wstring(speed < 1 ? 1 : speed);
 				});
-			if(!this->m_sorts[this->m_sortIndex.value()].GetIsMulThread()) {
-				this->m_controlButtons.GetButtons().emplace_back(GetConfigManager().GetWidth() * 7 / 8, 0, this->m_controlButtons.GetButtons()[0].GetSketch().GetLeft(), this->m_messages[0].GetBottom(), L"˳",
-					[this](Button& button_, ExMessage) {
-						Strip::s_exitStripSort.store(true, std::memory_order_release);
-						this->m_controlButtons.SetExitFlag(true);
-					}
-				);
+			// 多线程排序也可以退出：工作线程不抛出异常，而是由停止令牌让算法在检查点返回
+			this->m_controlButtons.GetButtons().emplace_back(GetConfigManager().GetWidth() * 7 / 8, 0, this->m_controlButtons.GetButtons()[0].GetSketch().GetLeft(), this->m_messages[0].GetBottom(), L"退出",
+				[this](Button& button_, ExMessage) {
+					Strip::s_pauseGate.Cancel();
+					this->m_controlButtons.SetExitFlag(true);
+				}
+			);
+			if (this->m_replayMode) {
+				this->SetReplayButtonsAuto();
 			}
 		}
 
+		// 赛跑模式只有标题、暂停、退出与演示速度（范围与回放模式相同）
+		void SetRaceControlButtonsAuto() {
+			this->m_messages.resize(1);
+			Sketch& titleSketch = this->m_messages[0];
+			titleSketch.SetSketch(0, 0, GetConfigManager().GetWidth(), Strip::StripMaxTop() / 4, L"赛跑 样本大小：" + std::to_wstring(this->m_sourceData.size()));
+			GetDrawingTool().ExecuteWithLock([&titleSketch]() {
+				::settextstyle(titleSketch.GetTextSize(), 0, titleSketch.GetTypeface().c_str());
+				titleSketch.SetRightWithoutResize(::textwidth(titleSketch.GetText().c_str()) + (std::min)(titleSketch.GetHeight(), titleSketch.GetRight()) / 20);
+			});
+			titleSketch.SetHasFrame(false).SetTextMode(DT_LEFT);
+			this->m_controlButtons.Clear();
+			this->m_controlButtons.GetButtons().resize(2);
+			this->m_controlButtons.GetButtons()[0].SetButton(GetConfigManager().GetWidth() * 15 / 16, 0, GetConfigManager().GetWidth(), titleSketch.GetBottom(), L"暂停",
+				[](Button& button_, ExMessage) {
+					if (Strip::s_pauseGate.GetIsPaused()) {
+						Strip::s_pauseGate.Resume();
+						button_.GetSketch().SetTextWithoutResize(L"暂停");
+					}
+					else {
+						Strip::s_pauseGate.Pause();
+						button_.GetSketch().SetTextWithoutResize(L"继续");
+					}
+					Button::GetDefaultHoverDrawFunction()(button_, {});
+				}
+			);
+			this->m_controlButtons.GetButtons()[1].SetThumb(RECT(0, titleSketch.GetBottom(), GetConfigManager().GetWidth(), Strip::StripMaxTop()),
+				Fraction(std::clamp((log10(static_cast<double>(this->m_displaySpeed)) + 1) / 5, 0.0, 1.0)), [this](Fraction frac_) -> std::wstring {
+					Fraction tempSpeed(pow(10.0, 5 * frac_ - 1));
+					std::unique_lock lock(this->m_speedMutex);
+					this->m_displaySpeed = tempSpeed;
+					lock.unlock();
+					int speed = static_cast<int>(frac_ * 100);
+					return L"演示速度：" + std::to_wstring(speed < 1 ? 1 : speed);
+				});
+			this->m_controlButtons.GetButtons().emplace_back(GetConfigManager().GetWidth() * 7 / 8, 0, this->m_controlButtons.GetButtons()[0].GetSketch().GetLeft(), titleSketch.GetBottom(), L"退出",
+				[this](Button& button_, ExMessage) {
+					Strip::s_pauseGate.Cancel();
+					this->m_controlButtons.SetExitFlag(true);
+				}
+			);
+		}
+
+		// 请求回放线程跳转，暂停中也会立即执行
+		void RequestSeek(size_t position_) {
+			this->m_seekTarget.store(position_, std::memory_order_release);
+			Strip::s_pauseGate.Interrupt();
+		}
+
+		// 回放模式：演示速度滑块只占左半边，右半边是时间轴滑块，另加一个后退一步按钮
+		// 回放按帧批量执行记录，速度范围放宽到每毫秒 0.1 ~ 10000 条
+		void SetReplayButtonsAuto() {
+			RECT thumbRect = { 0, this->m_messages[2].GetBottom(), GetConfigManager().GetWidth(), Strip::StripMaxTop() };
+			this->m_controlButtons.GetButtons()[1].SetThumb(RECT(thumbRect.left, thumbRect.top, thumbRect.right / 2, thumbRect.bottom),
+				Fraction(std::clamp((log10(static_cast<double>(this->m_displaySpeed)) + 1) / 5, 0.0, 1.0)), [this](Fraction frac_) -> std::wstring {
+					Fraction tempSpeed(pow(10.0, 5 * frac_ - 1));
+					std::unique_lock lock(this->m_speedMutex);
+					this->m_displaySpeed = tempSpeed;
+					lock.unlock();
+					int speed = static_cast<int>(frac_ * 100);
+					return L"演示速度：" + std::to_wstring(speed < 1 ? 1 : speed);
+				});
+			this->m_timelineValue = 0;
+			this->m_controlButtons.AddButtonAsThumb(RECT(thumbRect.right / 2, thumbRect.top, thumbRect.right, thumbRect.bottom), 0,
+				[this](Fraction frac_) -> std::wstring {
+					// 初始化与重绘时也会调用，只有值变化（拖动）时才跳转
+					if (frac_ != this->m_timelineValue) {
+						this->m_timelineValue = frac_;
+						this->RequestSeek(static_cast<size_t>(static_cast<double>(frac_) * this->m_traceRecorder.GetRecordNum()));
+					}
+					int percent = static_cast<int>(frac_ * 100);
+					return L"跳转：" + std::to_wstring(percent) + L"%";
+				});
+			this->m_controlButtons.AddButton(GetConfigManager().GetWidth() * 13 / 16, 0, GetConfigManager().GetWidth() * 7 / 8, this->m_messages[0].GetBottom(), L"后退",
+				[this](Button& button_, ExMessage) {
+					// 后退一步后保持暂停，高亮上一条记录
+					Strip::s_pauseGate.Pause();
+					Sketch& pauseSketch = this->m_controlButtons.GetButtons()[0].GetSketch();
+					pauseSketch.SetTextWithoutResize(L"继续");
+					pauseSketch.DrawSketch();
+					size_t position = this->m_replayPosition.load(std::memory_order_acquire);
+					this->RequestSeek(position >= 1 ? position - 1 : 0);
+					Button::GetDefaultHoverDrawFunction()(button_, {});
+				}
+			);
+		}
+
 		void RunErrorWindow(const std::vector<std::wstring>& error_messages_) {
 			static std::mutex errorWindowMutex;
 			std::lock_guard<std::mutex> lock(errorWindowMutex);
@@ -245,10 +345,9 @@ namespace NVisualSort {
 		bool RunIntSort() {
 			try {
 				this->m_intSortDuration = {};
-				auto startTime = std::chrono::high_resolution_clock::now();
-				this->m_sorts[this->m_sortIndex.value()].RunSort(this->m_intSortData);
-				auto endTime = std::chrono::high_resolution_clock::now();
-				this->m_intSortDuration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+				const std::vector<int> sourceData = this->m_intSortData;
+				SortTiming timing = this->m_intSortTimer.Measure(this->m_sorts[this->m_sortIndex.value()], sourceData, this->m_intSortData);
+				this->m_intSortDuration = std::chrono::duration_cast<std::chrono::microseconds>(timing.GetMedian());
 			}
 			catch (const WideError& errorMessage) {
 				this->RunErrorWindow({ errorMessage.What() });
@@ -258,7 +357,7 @@ namespace NVisualSort {
 		}
 
 		bool RunCounterSort() {
-			ActualStepNum = 0;
+			Counter::ResetStepNums();
 			try {
 				this->m_sorts[this->m_sortIndex.value()].RunSort(this->m_counterSortData);
 			}
@@ -269,6 +368,96 @@ namespace NVisualSort {
 			return true;
 		}
 
+		// 全速运行 Tracer 版本记录操作，再把记录回放到条形上；排序线程与绘制互不影响，暂停也不会阻塞工作线程
+		void RunTracerSortAndReplay() {
+			std::vector<int> startData(this->m_stripSortData.size());
+			for (size_t i = 0; i < startData.size(); ++i) {
+				startData[i] = this->m_stripSortData[i].GetValue();
+			}
+			{
+				Tracer::StartTracing(startData, this->m_tracerSortData, this->m_traceRecorder, this->m_sorts[this->m_sortIndex.value()].GetIsCallingThreadOnly());
+				ScopeGuard stopTracing([]() {
+					Tracer::StopTracing();
+				});
+				this->m_sorts[this->m_sortIndex.value()].RunSort(this->m_tracerSortData, Strip::s_pauseGate.GetStopToken());
+			}
+			if (Strip::s_pauseGate.GetIsCancelled()) {
+				throw WideError(SortEndsPrematurely);
+			}
+			if (!Strip::GetIsColumnMode()) {
+				// 演示打乱时逐个条形绘制，打乱结束后才切换到按列显示
+				Strip::SetColumnMode(this->m_stripSortData, true);
+				if (Strip::GetIsColumnMode()) {
+					Strip::DrawStrips(this->m_stripSortData);
+				}
+			}
+			TraceTimeline timeline(this->m_traceRecorder, this->m_keyframeMemoryLimit);
+			TraceReplayer replayer(this->m_traceRecorder);
+			this->m_stripSortBeginTime = std::chrono::steady_clock::now();
+			this->m_replayPosition.store(0, std::memory_order_release);
+			this->m_seekTarget.store(VisualSort::NoSeekTarget, std::memory_order_release);
+			// 按固定帧率回放：每帧按演示速度执行若干条记录，只重绘这一帧改动过的条形，最后刷新一次
+			FrameScheduler scheduler;
+			std::vector<uint8_t> isDirty(this->m_stripSortData.size(), 0);
+			std::vector<uint32_t> dirtyIndices;
+			auto markDirty = [&isDirty, &dirtyIndices](uint32_t index_) {
+				if (index_ != TraceNoIndex && !isDirty[index_]) {
+					isDirty[index_] = 1;
+					dirtyIndices.push_back(index_);
+				}
+			};
+			Strip::ReplayHighlights highlights{};
+			while (true) {
+				bool wasStopped = Strip::s_pauseGate.GetIsPaused();
+				Strip::StopSort();
+				if (wasStopped) {
+					scheduler.Restart();
+				}
+				Strip::s_pauseGate.ClearInterrupt();
+				size_t seekTarget = this->m_seekTarget.exchange(VisualSort::NoSeekTarget, std::memory_order_acq_rel);
+				if (seekTarget != VisualSort::NoSeekTarget) {
+					// 跳到目标位置后整体重绘，并高亮目标位置之前的最后一条记录
+					timeline.Seek(replayer, (std::min)(seekTarget, replayer.GetRecordNum() - 1));
+					Strip::SetValues(this->m_stripSortData, replayer.GetData());
+					Strip::DrawStrips(this->m_stripSortData);
+					highlights = replayer.GetPosition() > 0
+						? Strip::GetReplayHighlights(this->m_traceRecorder.GetRecord(replayer.GetPosition() - 1)) : Strip::ReplayHighlights{};
+				}
+				size_t operationNum = 0;
+				if (!Strip::s_pauseGate.GetIsPaused()) {
+					std::shared_lock lock(this->m_speedMutex);
+					double speed = static_cast<double>(this->m_displaySpeed);
+					lock.unlock();
+					operationNum = scheduler.GetFrameOperationNum(speed);
+				}
+				if (operationNum > 0) {
+					markDirty(highlights[0].index);
+					markDirty(highlights[1].index);
+				}
+				for (size_t operationIndex = 0; operationIndex < operationNum && !replayer.IsEnd(); ++operationIndex) {
+					highlights = Strip::ApplyRecord(this->m_stripSortData, replayer.Step());
+					markDirty(highlights[0].index);
+					markDirty(highlights[1].index);
+				}
+				markDirty(highlights[0].index);
+				markDirty(highlights[1].index);
+				this->m_replayPosition.store(replayer.GetPosition(), std::memory_order_release);
+				if (replayer.IsEnd()) {
+					highlights = {}; // 最后一帧恢复原色
+				}
+				Strip::DrawReplayFrame(this->m_stripSortData, dirtyIndices, highlights);
+				for (uint32_t index : dirtyIndices) {
+					isDirty[index] = 0;
+				}
+				dirtyIndices.clear();
+				this->UpdateLastMessage();
+				if (replayer.IsEnd()) {
+					break;
+				}
+				scheduler.WaitNextFrame();
+			}
+		}
+
 		bool RunStripSort() {
 			Strip::InitValues();
 			if (!this->m_showShuffle) {
@@ -282,7 +471,21 @@ namespace NVisualSort {
 			this->m_updateMessageTime.store(0, std::memory_order_release);
 			try {
 				this->m_stripSortBeginTime = std::chrono::high_resolution_clock::now();
-				this->m_sorts[this->m_sortIndex.value()].RunSort(this->m_stripSortData);
+				if (this->m_replayMode) {
+					this->RunTracerSortAndReplay();
+				}
+				else {
+					// 条形交给渲染线程绘制，排序线程不再争用绘制锁
+					GetDrawingTool().StartDrawQueue();
+					ScopeGuard stopDrawQueue([]() {
+						GetDrawingTool().StopDrawQueue();
+					});
+					this->m_sorts[this->m_sortIndex.value()].RunSort(this->m_stripSortData, Strip::s_pauseGate.GetStopToken());
+				}
+				// 被停止令牌中止的排序正常返回，数据没有排完，与单线程排序被退出时一样处理
+				if (Strip::s_pauseGate.GetIsCancelled()) {
+					throw WideError(SortEndsPrematurely);
+				}
 			}
 			catch (const WideError& errorMessage) {
 				if (errorMessage.What() != SortEndsPrematurely) {
@@ -291,6 +494,7 @@ namespace NVisualSort {
 				return false;
 			}
 			Strip::DrawRemainingStrip();
+			Strip::DrawRemainingStripOfAllThreads();
 			this->UpdateLastMessage();
 			return true;
 		}
@@ -302,20 +506,36 @@ namespace NVisualSort {
 					this->m_controlButtons.SetExitFlag(true);
 				});
 				if (this->m_sourceData.size() != this->m_stripSortData.size()) {
-					throw WideError(L"Сȷ");
+					throw WideError(L"排序结果的样本大小不正确");
 				}
 				std::stable_sort(this->m_sourceData.begin(), this->m_sourceData.end());
-				for (size_t i = 0; i < this->m_sourceData.size(); ++i) {
-					if (this->m_stripSortData[i].GetValue() == this->m_sourceData[i]) {
-						this->m_stripSortData[i].SetColor(GREEN);
-						Strip::DrawCheckStrip(this->m_stripSortData[i], GREEN);
+				if (Strip::GetIsColumnMode()) {
+					for (size_t column = 0; column < static_cast<size_t>(GetConfigManager().GetWidth()); ++column) {
+						auto [beginIndex, endIndex] = Strip::GetColumnRange(column);
+						bool isColumnCorrect = true;
+						for (size_t i = beginIndex; i < endIndex; ++i) {
+							bool isStripCorrect = this->m_stripSortData[i].GetValue() == this->m_sourceData[i];
+							this->m_stripSortData[i].SetColor(isStripCorrect ? GREEN : RED);
+							isColumnCorrect = isColumnCorrect && isStripCorrect;
+						}
+						Strip::DrawCheckColumn(this->m_stripSortData, column, isColumnCorrect ? GREEN : RED);
+						isCorrect = isCorrect && isColumnCorrect;
 					}
-					else {
-						this->m_stripSortData[i].SetColor(RED);
-						Strip::DrawCheckStrip(this->m_stripSortData[i], RED);
-						isCorrect = false;
+				}
+				else {
+					for (size_t i = 0; i < this->m_sourceData.size(); ++i) {
+						if (this->m_stripSortData[i].GetValue() == this->m_sourceData[i]) {
+							this->m_stripSortData[i].SetColor(GREEN);
+							Strip::DrawCheckStrip(this->m_stripSortData[i], GREEN);
+						}
+						else {
+							this->m_stripSortData[i].SetColor(RED);
+							Strip::DrawCheckStrip(this->m_stripSortData[i], RED);
+							isCorrect = false;
+						}
 					}
 				}
+				Strip::DrawRemainingStrip();
 			}
 			catch (const WideError& errorMessage) {
 				if (errorMessage.What() != SortEndsPrematurely) {
@@ -325,10 +545,10 @@ namespace NVisualSort {
 			}
 			Sketch resultSketch(0, 0, GetConfigManager().GetWidth(), Strip::StripMaxTop() / 4);
 			if (isCorrect) {
-				resultSketch.SetText(this->m_sorts[this->m_sortIndex.value()].GetSortName() + L"ȷ С" + std::to_wstring(this->m_sourceData.size()));
+				resultSketch.SetText(this->m_sorts[this->m_sortIndex.value()].GetSortName() + L"正确！ 样本大小：" + std::to_wstring(this->m_sourceData.size()));
 			}
 			else {
-				resultSketch.SetText(this->m_sorts[this->m_sortIndex.value()].GetSortName() + L" С" + std::to_wstring(this->m_sourceData.size()));
+				resultSketch.SetText(this->m_sorts[this->m_sortIndex.value()].GetSortName() + L"错误！ 样本大小：" + std::to_wstring(this->m_sourceData.size()));
 			}
 			GetDrawingTool().ExecuteWithLock([&resultSketch]() {
 				::settextstyle(resultSketch.GetTextSize(), 0, resultSketch.GetTypeface().c_str());
@@ -341,7 +561,7 @@ namespace NVisualSort {
 			GetDrawingTool().ClearRectangle(tempRect);
 			resultSketch.DrawSketch(false);
 			ButtonSequence exitButton(1);
-			exitButton.SetButton(0, this->m_controlButtons.GetButtons()[0].GetSketch().GetFrameRect(), L"˳", [&exitButton](Button&, ExMessage) {
+			exitButton.SetButton(0, this->m_controlButtons.GetButtons()[0].GetSketch().GetFrameRect(), L"退出", [&exitButton](Button&, ExMessage) {
 				exitButton.SetExitFlag(true);
 			});
 			exitButton.RunBlockButtonLoop();
@@ -358,6 +578,24 @@ namespace NVisualSort {
 			return this->m_sorts;
 		}
 
+		// 界面允许的最大数据量：回放模式按列显示，界面最大数据量达到 ReplayScalableMaxSize 的排序（O(n log n) 的比较排序与计数、基数排序）
+		// 逐次翻倍放大，直到按 n log n 估计的记录条数将要超过 ReplayMaxRecordNum（约 13 万个元素）
+		// （计数、基数排序是线性的，按 n log n 估计偏大，只会更保守；希尔、双调排序的记录更多，超过上限时由记录器报错）
+		int GetMaxSize(size_t sort_index_) const {
+			int maxSize = this->m_sorts[sort_index_].GetMaxSize();
+			if (!this->m_replayMode || maxSize < VisualSort::ReplayScalableMaxSize) {
+				return maxSize;
+			}
+			auto estimateRecordNum = [](size_t size_) {
+				return size_ * static_cast<size_t>(std::bit_width(size_)) * VisualSort::ReplayRecordsPerNLogN;
+			};
+			int scaledMaxSize = maxSize;
+			while (estimateRecordNum(static_cast<size_t>(scaledMaxSize) * 2) <= VisualSort::ReplayMaxRecordNum) {
+				scaledMaxSize *= 2;
+			}
+			return scaledMaxSize;
+		}
+
 		constexpr bool GetShowShuffle() const noexcept {
 			return this->m_showShuffle;
 		}
@@ -366,6 +604,23 @@ namespace NVisualSort {
 			this->m_showShuffle = show_shuffle_;
 		}
 
+		constexpr bool GetReplayMode() const noexcept {
+			return this->m_replayMode;
+		}
+
+		constexpr void SetReplayMode(bool replay_mode_) noexcept {
+			this->m_replayMode = replay_mode_;
+		}
+
+		size_t GetKeyframeMemoryLimit() const noexcept {
+			return this->m_keyframeMemoryLimit;
+		}
+
+		// 回放时间轴关键帧的内存上限（字节），越小跳转越慢
+		void SetKeyframeMemoryLimit(size_t keyframe_memory_limit_) noexcept {
+			this->m_keyframeMemoryLimit = keyframe_memory_limit_;
+		}
+
 		template<typename T>
 		static void Shuffle(std::vector<T>& data_, unsigned int rand_device_) {
 			std::mt19937 rnd(rand_device_);
@@ -375,18 +630,18 @@ namespace NVisualSort {
 			}
 		}
 
-		// ֵΪݴСǷҪ󣬲ǷǷɹ
+		// 返回值为数据大小是否满足要求，不是返回排序是否成功
 		bool SortPreparation(size_t sort_index_, size_t data_size_) {
 			if (sort_index_ >= this->m_sorts.size()) {
-				throw WideError(L"Ҳ");
+				throw WideError(L"找不到排序");
 			}
 			this->m_sortIndex = sort_index_;
 			ScopeGuard sg([this]() {
 				this->m_sortIndex = std::nullopt;
 			});
 			std::vector<std::wstring> errorMessages;
-			if (data_size_ > this->m_sorts[sort_index_].GetMaxSize()) {
-				errorMessages.emplace_back(L"ֵ");
+			if (data_size_ > static_cast<size_t>(this->GetMaxSize(sort_index_))) {
+				errorMessages.emplace_back(L"数据量超过允许最大值");
 			}
 			for (size_t i = 0; i < this->m_sorts[sort_index_].GetNumRequires().size(); ++i) {
 				if (!this->m_sorts[sort_index_].GetNumRequires()[i].Check(data_size_)) {
@@ -401,7 +656,7 @@ namespace NVisualSort {
 
 			Sketch inSortingPrompt;
 			inSortingPrompt.SetFrameRect(RECT{ 0,0,static_cast<int>(GetConfigManager().GetWidth()),static_cast<int>(GetConfigManager().GetHeight()) }).
-				SetText(this->m_sorts[sort_index_].GetSortName() + L"׼УԺ...").
+				SetText(this->m_sorts[sort_index_].GetSortName() + L"准备中，请稍候...").
 				SetTextSize((std::min)(GetConfigManager().GetWidth() / 34, GetConfigManager().GetHeight() / 21)).
 				SetHasBackground(false).SetHasFrame(false);
 			GetDrawingTool().ClearDevice();
@@ -422,7 +677,8 @@ namespace NVisualSort {
 				this->SetMessageAuto();
 				this->SetControlButtonsAuto();
 				Strip::InitValues(this->m_sourceData, this->m_stripSortData, this->GetSleepFunc(),
-					this->GetDrawFunc(), this->GetUpdateMessageFunc(), this->m_sorts[sort_index_].GetIsMulThread());
+					this->GetDrawFunc(), this->GetUpdateMessageFunc(), this->GetIsMulThreadDrawing());
+				Strip::SetColumnMode(this->m_stripSortData, this->m_replayMode);
 			}
 			else {
 				const unsigned int randInt = GetConfigManager().GenerateRandom();
@@ -441,7 +697,7 @@ namespace NVisualSort {
 				this->SetMessageAuto();
 				this->SetControlButtonsAuto();
 				Strip::InitValues(this->m_sourceData, this->m_stripSortData, this->GetSleepFunc(),
-					this->GetDrawFunc(), []() {}, this->m_sorts[sort_index_].GetIsMulThread());
+					this->GetDrawFunc(), []() {}, this->GetIsMulThreadDrawing());
 				VisualSort::Shuffle(m_sourceData, randInt);
 
 				GetDrawingTool().ClearDevice();
@@ -456,23 +712,14 @@ namespace NVisualSort {
 					for (auto it = this->m_stripSortData.begin(); it != this->m_stripSortData.end(); ++it) {
 						Strip::DrawCheckStrip(*it, it->GetColor());
 					}
-					for (size_t i = 0; i < 100; ++i) {
-						do {
-							if (Strip::s_exitStripSort && !Strip::s_isMulThreadSort) {
-								throw WideError(SortEndsPrematurely);
-							}
-							std::this_thread::sleep_for(std::chrono::milliseconds(10));
-						} while (Strip::s_stopStripSort);
+					Strip::DrawRemainingStrip();
+					if (!Strip::s_pauseGate.WaitFor(VisualSort::ShufflePauseTime)) {
+						throw WideError(SortEndsPrematurely);
 					}
 					VisualSort::Shuffle(this->m_stripSortData, randInt);
 					Strip::DrawRemainingStrip();
-					for (size_t i = 0; i < 100; ++i) {
-						do {
-							if (Strip::s_exitStripSort && !Strip::s_isMulThreadSort) {
-								throw WideError(SortEndsPrematurely);
-							}
-							std::this_thread::sleep_for(std::chrono::milliseconds(10));
-						} while (Strip::s_stopStripSort);
+					if (!Strip::s_pauseGate.WaitFor(VisualSort::ShufflePauseTime)) {
+						throw WideError(SortEndsPrematurely);
 					}
 				}
 				catch (const WideError& errorMessage) {
@@ -491,6 +738,105 @@ namespace NVisualSort {
 			return true;
 		}
 
+		// 赛跑模式允许的最大数据量：参赛排序界面最大数据量中的最小值
+		int GetRaceMaxSize() const {
+			int maxSize = (std::numeric_limits<int>::max)();
+			for (size_t sortIndex : SortRace::FindSortIndices(this->m_sorts, SortRace::GetDefaultSortNames())) {
+				maxSize = (std::min)(maxSize, this->m_sorts[sortIndex].GetMaxSize());
+			}
+			return maxSize;
+		}
+
+		// 赛跑模式：默认的六个排序用同一份打乱的数据各占一条跑道，按演示速度同时回放（演示速度是每条跑道每毫秒执行的记录条数）
+		// 各跑道在线程池中各自回放、重绘，当前线程每帧把重绘过的跑道拷贝到窗口并写上各自的计数，整帧只刷新一次
+		void RunRace(size_t data_size_) {
+			std::vector<size_t> sortIndices = SortRace::FindSortIndices(this->m_sorts, SortRace::GetDefaultSortNames());
+			this->m_initDataFunc(data_size_, this->m_sourceData);
+			VisualSort::Shuffle(this->m_sourceData, GetConfigManager().GenerateRandom());
+
+			Sketch inSortingPrompt;
+			inSortingPrompt.SetFrameRect(RECT{ 0,0,static_cast<int>(GetConfigManager().GetWidth()),static_cast<int>(GetConfigManager().GetHeight()) }).
+				SetText(L"赛跑准备中，请稍候...").
+				SetTextSize((std::min)(GetConfigManager().GetWidth() / 34, GetConfigManager().GetHeight() / 21)).
+				SetHasBackground(false).SetHasFrame(false);
+			GetDrawingTool().ClearDevice();
+			inSortingPrompt.DrawSketch();
+
+			Strip::InitValues();
+			int raceTop = Strip::StripMaxTop();
+			int labelHeight = (std::min)(GetConfigManager().GetWidth() / 64, GetConfigManager().GetHeight() / 36) * 3 / 2;
+			std::optional<SortRace> race;
+			try {
+				race.emplace(this->m_sorts, sortIndices, this->m_sourceData, static_cast<int>(GetConfigManager().GetWidth()),
+					static_cast<int>(GetConfigManager().GetHeight()) - raceTop, labelHeight, GetConfigManager().GetCanvasColor());
+			}
+			catch (const WideError& errorMessage) {
+				this->RunErrorWindow({ errorMessage.What() });
+				return;
+			}
+			this->SetRaceControlButtonsAuto();
+			GetDrawingTool().ClearDevice();
+			this->m_messages[0].DrawSketch(false);
+			this->m_controlButtons.RunNonBlockButtonLoop();
+			ScopeGuard exitButtons([this]() {
+				this->m_controlButtons.SetExitFlag(true);
+			});
+			try {
+				if (!race->Record(this->m_sorts, Strip::s_pauseGate.GetStopToken())) {
+					return;
+				}
+			}
+			catch (const WideError& errorMessage) {
+				this->RunErrorWindow({ errorMessage.What() });
+				return;
+			}
+
+			auto drawLabel = [raceTop, labelHeight](const SortRace::Lane& lane_) {
+				RECT labelRect = { lane_.left, raceTop + lane_.top, lane_.right, raceTop + lane_.labelBottom - 1 };
+				std::wstring label = lane_.sortName + L" 比较：" + std::to_wstring(lane_.compareNum) + L" 修改：" + std::to_wstring(lane_.changeNum);
+				if (lane_.GetIsFinished()) {
+					label += L" 第" + std::to_wstring(lane_.place) + L"名";
+				}
+				GetDrawingTool().ClearRectangle(labelRect);
+				GetDrawingTool().DrawText_(label, labelRect, labelHeight * 2 / 3, WHITE, DT_SINGLELINE | DT_VCENTER | DT_LEFT);
+			};
+			FrameScheduler scheduler;
+			while (true) {
+				if (Strip::s_pauseGate.GetIsBlocking()) {
+					Strip::s_pauseGate.Wait();
+					scheduler.Restart();
+				}
+				if (Strip::s_pauseGate.GetIsCancelled()) {
+					return;
+				}
+				std::shared_lock lock(this->m_speedMutex);
+				double speed = static_cast<double>(this->m_displaySpeed);
+				lock.unlock();
+				bool isFinished = race->StepFrame(scheduler.GetFrameOperationNum(speed));
+				GetDrawingTool().ExecuteWithLock([&race, &drawLabel, raceTop]() {
+					race->ForEachChangedLane([raceTop](const FrameBuffer& lane_frame_buffer_, int left_, int top_) {
+						GetDrawingTool().DrawFrameBuffer(lane_frame_buffer_, left_, raceTop + top_);
+					});
+					for (size_t laneIndex = 0; laneIndex < race->GetLaneNum(); ++laneIndex) {
+						if (race->GetLane(laneIndex).isChanged) {
+							drawLabel(race->GetLane(laneIndex));
+						}
+					}
+					GetDrawingTool().FlushBatchDraw(0, raceTop, GetConfigManager().GetWidth(), GetConfigManager().GetHeight());
+				});
+				if (isFinished) {
+					break;
+				}
+				scheduler.WaitNextFrame();
+			}
+			this->m_controlButtons.SetExitFlag(true);
+			ButtonSequence exitButton(1);
+			exitButton.SetButton(0, this->m_controlButtons.GetButtons()[0].GetSketch().GetFrameRect(), L"退出", [&exitButton](Button&, ExMessage) {
+				exitButton.SetExitFlag(true);
+			});
+			exitButton.RunBlockButtonLoop();
+		}
+
 		friend inline VisualSort& GetVisualSort();
 
 	};
@@ -2,7 +2,7 @@
 #include <Windows.h>
 
 int main() {
-	FreeConsole(); // رտ̨
-	NVisualSort::GetMainMenu(); //  MainMenu Ĺ캯
+	FreeConsole(); // 关闭控制台
+	NVisualSort::GetMainMenu(); // 调用 MainMenu 的构造函数
 	return 0;
 }
\ No newline at end of file